@@ -0,0 +1,451 @@
+//! CPU instruction throughput on synthetic instruction mixes.
+//!
+//! Each core runs a short loop of loads, ALU operations, stores, stack
+//! traffic and a branch back, from memory the bus reports as ROM (so
+//! predecode caches behave as they do in a machine). Throughput is in
+//! emulated cycles per second.
+//!
+//! The `idle` benches run a poll of a RAM flag nothing sets, stepped every
+//! cycle and skipped through `skip_idle` a scanline (64 cycles) at a time,
+//! the way the Williams and Pac-Man boards drive it.
+
+mod harness;
+
+use harness::Bench;
+use phosphor_core::core::bus::InterruptState;
+use phosphor_core::core::{Bus, BusMaster, BusMasterComponent};
+use phosphor_core::cpu::i8035::I8035;
+use phosphor_core::cpu::i8088::I8088;
+use phosphor_core::cpu::m6502::M6502;
+use phosphor_core::cpu::m6800::M6800;
+use phosphor_core::cpu::m6809::M6809;
+use phosphor_core::cpu::mb88xx::{Mb88xx, Mb88xxVariant};
+use phosphor_core::cpu::z80::Z80;
+
+/// Cycles per timed iteration.
+const CYCLES: u64 = 100_000;
+
+/// Event horizon of the `idle` benches.
+const LINE_CYCLES: u64 = 64;
+
+/// Flat RAM with the first `rom_end` bytes reported as ROM.
+struct FlatBus<const ADDR_BITS: u32> {
+    memory: Vec<u8>,
+    rom_end: u32,
+    /// Report every read as pure (`idle` benches only).
+    pure_reads: bool,
+}
+
+impl<const ADDR_BITS: u32> FlatBus<ADDR_BITS> {
+    fn new(program_at: u32, program: &[u8]) -> Self {
+        let mut memory = vec![0; 1 << ADDR_BITS];
+        let start = program_at as usize;
+        memory[start..start + program.len()].copy_from_slice(program);
+        Self {
+            memory,
+            rom_end: program_at + program.len() as u32,
+            pure_reads: false,
+        }
+    }
+}
+
+macro_rules! impl_flat_bus {
+    ($bits:literal, $addr:ty) => {
+        impl Bus for FlatBus<$bits> {
+            type Address = $addr;
+            type Data = u8;
+
+            fn read(&mut self, _master: BusMaster, addr: $addr) -> u8 {
+                self.memory[addr as usize]
+            }
+
+            fn write(&mut self, _master: BusMaster, addr: $addr, data: u8) {
+                if (addr as u32) >= self.rom_end {
+                    self.memory[addr as usize] = data;
+                }
+            }
+
+            fn is_halted_for(&self, _master: BusMaster) -> bool {
+                false
+            }
+
+            fn check_interrupts(&mut self, _target: BusMaster) -> InterruptState {
+                InterruptState {
+                    nmi: false,
+                    irq: false,
+                    firq: false,
+                    irq_vector: 0xFF,
+                }
+            }
+
+            fn code_generation(&self, _master: BusMaster, addr: $addr) -> Option<u32> {
+                ((addr as u32) < self.rom_end).then_some(0)
+            }
+
+            fn is_pure_read(&self, _master: BusMaster, _addr: $addr) -> bool {
+                self.pure_reads
+            }
+        }
+    };
+}
+impl_flat_bus!(16, u16);
+impl_flat_bus!(20, u32);
+
+/// Append a relative branch (opcode + signed 8-bit offset) back to `target`.
+fn branch_back(program: &mut Vec<u8>, base: u16, opcode: u8, target: u16) {
+    let next = base as i32 + program.len() as i32 + 2;
+    program.push(opcode);
+    program.push((target as i32 - next) as i8 as u8);
+}
+
+/// Check the loop kept running the mix rather than falling into empty
+/// memory (the PC may sit one instruction past the branch mid-fetch).
+fn assert_in_loop(pc: u32, base: u32, program: &[u8]) {
+    assert!(
+        (base..=base + program.len() as u32 + 2).contains(&pc),
+        "PC {pc:#X} left the benchmark loop"
+    );
+}
+
+fn bench_cpu<C, B>(bench: &Bench, name: &str, cpu: &mut C, bus: &mut B)
+where
+    C: BusMasterComponent<Bus = B>,
+    B: ?Sized,
+{
+    bench.run(name, CYCLES, "cycles", || {
+        for _ in 0..CYCLES {
+            cpu.tick_with_bus(bus, BusMaster::Cpu(0));
+        }
+    });
+}
+
+/// Run `cpu` `CYCLES` cycles a scanline at a time, skipping confirmed idle
+/// passes with `skip` and stepping otherwise.
+fn bench_idle_skip<C, B>(
+    bench: &Bench,
+    name: &str,
+    cpu: &mut C,
+    bus: &mut B,
+    mut skip: impl FnMut(&mut C, &mut B, u64) -> u64,
+) where
+    C: BusMasterComponent<Bus = B>,
+    B: ?Sized,
+{
+    bench.run(name, CYCLES, "cycles", || {
+        for _ in 0..CYCLES / LINE_CYCLES {
+            let mut remaining = LINE_CYCLES;
+            while remaining > 0 {
+                let skipped = skip(cpu, bus, remaining);
+                if skipped > 0 {
+                    remaining -= skipped;
+                } else {
+                    cpu.tick_with_bus(bus, BusMaster::Cpu(0));
+                    remaining -= 1;
+                }
+            }
+        }
+    });
+}
+
+fn main() {
+    let bench = Bench::from_args();
+
+    // M6809
+    {
+        let base = 0x1000;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0x86, 0x12,       // LDA #$12
+            0x8B, 0x01,       // ADDA #1
+            0xB7, 0x20, 0x00, // STA $2000
+            0x8E, 0x30, 0x00, // LDX #$3000
+            0xE6, 0x80,       // LDB ,X+
+            0x3D,             // MUL
+            0xDD, 0x10,       // STD <$10
+            0x34, 0x06,       // PSHS A,B
+            0x35, 0x06,       // PULS A,B
+            0x5A,             // DECB
+        ];
+        branch_back(&mut p, base, 0x20, base); // BRA
+        let mut bus = FlatBus::<16>::new(base as u32, &p);
+        let mut cpu = M6809::new();
+        cpu.pc = base;
+        cpu.s = 0x8000;
+        bench_cpu(
+            &bench,
+            "cpu/m6809",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // M6809 idle: LDA $2000; BEQ *-3
+    {
+        let base = 0x1000;
+        let p = [0xB6, 0x20, 0x00, 0x27, 0xFB];
+        let new_bus = || {
+            let mut bus = FlatBus::<16>::new(base as u32, &p);
+            bus.pure_reads = true;
+            bus
+        };
+        let new_cpu = || {
+            let mut cpu = M6809::new();
+            cpu.pc = base;
+            cpu
+        };
+        let (mut cpu, mut bus) = (new_cpu(), new_bus());
+        bench_cpu(
+            &bench,
+            "cpu/m6809_idle_step",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+        let (mut cpu, mut bus) = (new_cpu(), new_bus());
+        bench_idle_skip(
+            &bench,
+            "cpu/m6809_idle_skip",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+            |cpu, bus, max| cpu.skip_idle(bus, BusMaster::Cpu(0), max),
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // M6800
+    {
+        let base = 0x1000;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0x86, 0x12,       // LDAA #$12
+            0x8B, 0x01,       // ADDA #1
+            0xB7, 0x20, 0x00, // STAA $2000
+            0xCE, 0x30, 0x00, // LDX #$3000
+            0xE6, 0x00,       // LDAB 0,X
+            0x08,             // INX
+            0x1B,             // ABA
+            0x36,             // PSHA
+            0x32,             // PULA
+            0x5A,             // DECB
+        ];
+        branch_back(&mut p, base, 0x20, base); // BRA
+        let mut bus = FlatBus::<16>::new(base as u32, &p);
+        let mut cpu = M6800::new();
+        cpu.pc = base;
+        cpu.sp = 0x8000;
+        bench_cpu(
+            &bench,
+            "cpu/m6800",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // M6502
+    {
+        let base = 0x1000u16;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0xA9, 0x12,       // LDA #$12
+            0x18,             // CLC
+            0x69, 0x01,       // ADC #1
+            0x8D, 0x00, 0x20, // STA $2000
+            0xA2, 0x00,       // LDX #0
+            0xBD, 0x00, 0x30, // LDA $3000,X
+            0xE8,             // INX
+            0x48,             // PHA
+            0x68,             // PLA
+            0x0A,             // ASL A
+        ];
+        p.extend_from_slice(&[0x4C, base as u8, (base >> 8) as u8]); // JMP
+        let mut bus = FlatBus::<16>::new(base as u32, &p);
+        let mut cpu = M6502::new();
+        cpu.pc = base;
+        bench_cpu(
+            &bench,
+            "cpu/m6502",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // Z80
+    {
+        let base = 0x1000;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0x3E, 0x12,       // LD A,$12
+            0xC6, 0x01,       // ADD A,1
+            0x32, 0x00, 0x20, // LD ($2000),A
+            0x21, 0x00, 0x30, // LD HL,$3000
+            0x46,             // LD B,(HL)
+            0x23,             // INC HL
+            0xC5,             // PUSH BC
+            0xC1,             // POP BC
+            0x05,             // DEC B
+        ];
+        branch_back(&mut p, base, 0x18, base); // JR
+        let mut bus = FlatBus::<16>::new(base as u32, &p);
+        let mut cpu = Z80::new();
+        cpu.pc = base;
+        cpu.sp = 0x8000;
+        bench_cpu(
+            &bench,
+            "cpu/z80",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // Z80 idle: LD A,($2000); OR A; JR Z,$-4
+    {
+        let base = 0x1000;
+        let p = [0x3A, 0x00, 0x20, 0xB7, 0x28, 0xFA];
+        let new_bus = || {
+            let mut bus = FlatBus::<16>::new(base as u32, &p);
+            bus.pure_reads = true;
+            bus
+        };
+        let new_cpu = || {
+            let mut cpu = Z80::new();
+            cpu.pc = base;
+            cpu
+        };
+        let (mut cpu, mut bus) = (new_cpu(), new_bus());
+        bench_cpu(
+            &bench,
+            "cpu/z80_idle_step",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+        let (mut cpu, mut bus) = (new_cpu(), new_bus());
+        bench_idle_skip(
+            &bench,
+            "cpu/z80_idle_skip",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+            |cpu, bus, max| cpu.skip_idle(bus, BusMaster::Cpu(0), max),
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // Z80 ALU: register-only arithmetic, logic and rotates, which take
+    // their flags from the alu.rs tables
+    {
+        let base = 0x1000;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0x80,             // ADD A,B
+            0x89,             // ADC A,C
+            0x92,             // SUB D
+            0x9B,             // SBC A,E
+            0xBC,             // CP H
+            0xA5,             // AND L
+            0xA8,             // XOR B
+            0xB1,             // OR C
+            0x3C,             // INC A
+            0x15,             // DEC D
+            0x27,             // DAA
+            0xCB, 0x03,       // RLC E
+            0xC6, 0x37,       // ADD A,$37
+            0x04,             // INC B
+        ];
+        branch_back(&mut p, base, 0x18, base); // JR
+        let mut bus = FlatBus::<16>::new(base as u32, &p);
+        let mut cpu = Z80::new();
+        cpu.pc = base;
+        cpu.sp = 0x8000;
+        bench_cpu(
+            &bench,
+            "cpu/z80_alu",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, base as u32, &p);
+    }
+
+    // I8088
+    {
+        let base = 0x1000;
+        #[rustfmt::skip]
+        let mut p = vec![
+            0xB0, 0x12,       // MOV AL,$12
+            0x04, 0x01,       // ADD AL,1
+            0xA2, 0x00, 0x20, // MOV [$2000],AL
+            0xBB, 0x00, 0x30, // MOV BX,$3000
+            0x8A, 0x0F,       // MOV CL,[BX]
+            0x43,             // INC BX
+            0x50,             // PUSH AX
+            0x58,             // POP AX
+            0x49,             // DEC CX
+        ];
+        branch_back(&mut p, base, 0xEB, base); // JMP short
+        let mut bus = FlatBus::<20>::new(base as u32, &p);
+        let mut cpu = I8088::new();
+        cpu.cs = 0;
+        cpu.ip = base;
+        cpu.ss = 0;
+        cpu.sp = 0x8000;
+        bench_cpu(
+            &bench,
+            "cpu/i8088",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u32, Data = u8>,
+        );
+        assert_in_loop(cpu.ip as u32, base as u32, &p);
+    }
+
+    // I8035 (one tick = one machine cycle)
+    {
+        #[rustfmt::skip]
+        let p = [
+            0x23, 0x12, // MOV A,#$12
+            0x03, 0x01, // ADD A,#1
+            0xB8, 0x20, // MOV R0,#$20
+            0xA0,       // MOV @R0,A
+            0x18,       // INC R0
+            0x29,       // XCH A,R1
+            0x43, 0x0F, // ORL A,#$0F
+            0x17,       // INC A
+            0x04, 0x00, // JMP $000
+        ];
+        let mut bus = FlatBus::<16>::new(0, &p);
+        let mut cpu = I8035::new();
+        bench_cpu(
+            &bench,
+            "cpu/i8035",
+            &mut cpu,
+            &mut bus as &mut dyn Bus<Address = u16, Data = u8>,
+        );
+        assert_in_loop(cpu.pc as u32, 0, &p);
+    }
+
+    // MB88xx (program in internal ROM; no external bus)
+    {
+        #[rustfmt::skip]
+        let p = [
+            0x95, // LI #5
+            0x73, // AI #3
+            0x82, // LYI #2
+            0x1D, // ST
+            0x08, // ICY
+            0x0D, // L
+            0x0C, // ROL
+            0x04, // TAY
+            0xC0, // JMP $00
+        ];
+        let mut cpu = Mb88xx::new(Mb88xxVariant::Mb8843);
+        cpu.load_rom(&p);
+        bench.run("cpu/mb88xx", CYCLES, "cycles", || {
+            for _ in 0..CYCLES {
+                cpu.execute_cycle();
+            }
+        });
+        assert_in_loop(cpu.pc as u32, 0, &p);
+    }
+}
@@ -0,0 +1,207 @@
+//! Per-tick cost of sound and video devices, driven with synthetic
+//! register settings and display lists.
+
+mod harness;
+
+use harness::Bench;
+use phosphor_core::core::bus::InterruptState;
+use phosphor_core::core::{Bus, BusMaster};
+use phosphor_core::device::Device;
+use phosphor_core::device::avg::Avg;
+use phosphor_core::device::ay8910::Ay8910;
+use phosphor_core::device::dvg::Dvg;
+use phosphor_core::device::namco_wsg::NamcoWsg;
+use phosphor_core::device::pokey::Pokey;
+use phosphor_core::device::votrax_sc01::VotraxSc01;
+use phosphor_core::device::williams_blitter::WilliamsBlitter;
+
+/// Device clock ticks per timed iteration.
+const TICKS: u64 = 100_000;
+
+/// Vectors in each synthetic display list.
+const VECTORS: u64 = 1000;
+
+/// Deterministic filler for ROMs and register values.
+fn noise(len: usize, mut seed: u32) -> Vec<u8> {
+    (0..len)
+        .map(|_| {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            seed as u8
+        })
+        .collect()
+}
+
+/// 64 KB of RAM for the blitter to copy through.
+struct Ram(Vec<u8>);
+
+impl Bus for Ram {
+    type Address = u16;
+    type Data = u8;
+
+    fn read(&mut self, _master: BusMaster, addr: u16) -> u8 {
+        self.0[addr as usize]
+    }
+
+    fn write(&mut self, _master: BusMaster, addr: u16, data: u8) {
+        self.0[addr as usize] = data;
+    }
+
+    fn is_halted_for(&self, _master: BusMaster) -> bool {
+        false
+    }
+
+    fn check_interrupts(&mut self, _target: BusMaster) -> InterruptState {
+        InterruptState {
+            nmi: false,
+            irq: false,
+            firq: false,
+            irq_vector: 0xFF,
+        }
+    }
+}
+
+fn main() {
+    let bench = Bench::from_args();
+    let mut audio = vec![0i16; 8192];
+
+    // POKEY: four square-wave channels at full volume
+    {
+        let mut pokey = Pokey::new(44_100);
+        pokey.write(0x0F, 0x03); // SKCTL: leave init mode
+        pokey.write(0x08, 0x00); // AUDCTL
+        for ch in 0..4 {
+            pokey.write(ch * 2, 0x20 + ch as u8 * 0x11); // AUDFn
+            pokey.write(ch * 2 + 1, 0xAF); // AUDCn: pure tone, volume 15
+        }
+        bench.run("device/pokey", TICKS, "ticks", || {
+            for _ in 0..TICKS {
+                pokey.tick();
+            }
+            pokey.drain_audio()
+        });
+    }
+
+    // AY-8910: three tones plus noise and a repeating envelope
+    {
+        let mut ay = Ay8910::new(2_000_000);
+        for (reg, value) in [
+            (0, 0x40),
+            (2, 0x55),
+            (4, 0x6A),
+            (6, 0x0F),
+            (7, 0x30), // tones on A/B/C, noise on A
+            (8, 0x0F),
+            (9, 0x0F),
+            (10, 0x10), // C follows the envelope
+            (11, 0x00),
+            (12, 0x04),
+            (13, 0x0E),
+        ] {
+            ay.address_write(reg);
+            ay.data_write(value);
+        }
+        bench.run("device/ay8910", TICKS, "ticks", || {
+            for _ in 0..TICKS {
+                ay.tick();
+            }
+            ay.fill_audio(&mut audio)
+        });
+    }
+
+    // Namco WSG: three voices on different waveforms
+    {
+        let mut wsg = NamcoWsg::new(3_072_000);
+        wsg.load_waveform_rom(&noise(256, 0x1234_5678));
+        wsg.set_sound_enabled(true);
+        for (ch, base) in [(0, 0x10), (1, 0x16), (2, 0x1B)] {
+            wsg.write(0x05 + ch * 5, ch as u8 + 1); // waveform
+            for i in 1..5 {
+                wsg.write(base + i, (3 + ch as u8 + i as u8) & 0x0F); // frequency
+            }
+            wsg.write(0x15 + ch * 5, 0x0F); // volume
+        }
+        bench.run("device/namco_wsg", TICKS, "ticks", || {
+            for _ in 0..TICKS {
+                wsg.tick();
+            }
+            wsg.fill_audio(&mut audio)
+        });
+    }
+
+    // Votrax SC-01: a new phoneme whenever the chip asks for one
+    {
+        let mut votrax = VotraxSc01::new(720_000);
+        votrax.load_rom(&noise(512, 0x9E37_79B9));
+        let mut phone = 0u8;
+        bench.run("device/votrax_sc01", TICKS, "ticks", || {
+            for _ in 0..TICKS {
+                if votrax.ar_output() {
+                    phone = (phone + 7) & 0x3F;
+                    votrax.write_phoneme(phone);
+                }
+                votrax.tick();
+            }
+            votrax.drain_audio()
+        });
+    }
+
+    // Williams blitter: 64x64 transparent copies, one DMA cycle per tick
+    {
+        let mut ram = Ram(noise(0x1_0000, 0xDEAD_BEEF));
+        let mut blitter = WilliamsBlitter::new();
+        bench.run("device/williams_blitter", TICKS, "ticks", || {
+            for _ in 0..TICKS {
+                if !blitter.is_active() {
+                    blitter.write_register(2, 0x80); // source $8000
+                    blitter.write_register(3, 0x00);
+                    blitter.write_register(4, 0x10); // destination $1000
+                    blitter.write_register(5, 0x00);
+                    blitter.write_register(6, 0x40 ^ 4); // SC1 size XOR
+                    blitter.write_register(7, 0x40 ^ 4);
+                    blitter.write_register(0, 0x08); // transparent copy
+                }
+                blitter.do_dma_cycle(&mut ram);
+            }
+        });
+    }
+
+    // DVG: a display list of long vectors
+    {
+        let mut vmem = Vec::new();
+        for i in 0..VECTORS {
+            let dy = (i * 37 % 0x400) as u16 | if i % 2 == 0 { 0x400 } else { 0 };
+            let dx = (i * 53 % 0x400) as u16 | if i % 3 == 0 { 0x400 } else { 0 };
+            vmem.extend_from_slice(&(0x7000 | dy).to_le_bytes()); // VCTR, scale 7
+            vmem.extend_from_slice(&(0xC000 | dx).to_le_bytes()); // intensity 12
+        }
+        vmem.extend_from_slice(&0xB000u16.to_le_bytes()); // HALT
+        let mut dvg = Dvg::new();
+        bench.run("device/dvg", VECTORS, "vectors", || {
+            dvg.go();
+            dvg.execute(&vmem);
+            dvg.take_display_list()
+        });
+    }
+
+    // AVG: the same list in AVG encoding, with an intensity STAT first
+    {
+        // AVG reads bytes with addr ^ 1, so words are stored big-endian
+        let mut vmem = 0x60F0u16.to_be_bytes().to_vec(); // STAT: intensity 15
+        for i in 0..VECTORS {
+            let dy = (i * 37 % 0x1000) as u16;
+            let dx = (i * 53 % 0x1000) as u16;
+            vmem.extend_from_slice(&dy.to_be_bytes()); // VCTR
+            vmem.extend_from_slice(&(0x2000 | dx).to_be_bytes());
+        }
+        vmem.extend_from_slice(&0x2000u16.to_be_bytes()); // HALT
+        let color_ram = [0x07u8; 16];
+        let mut avg = Avg::new(1024, 1024);
+        bench.run("device/avg", VECTORS, "vectors", || {
+            avg.go();
+            avg.execute(&vmem, &color_ram);
+            avg.take_display_list()
+        });
+    }
+}
@@ -0,0 +1,92 @@
+//! Minimal timing harness shared by the `harness = false` benches.
+//!
+//! Each benchmark is calibrated so one sample takes about 20 ms, then
+//! timed over 15 samples; the report shows the median time per iteration,
+//! the spread between the fastest and slowest sample, and throughput in
+//! the benchmark's own unit (cycles, samples, frames).
+//!
+//! `cargo bench -- <filter>` runs only benchmarks whose name contains
+//! `<filter>`.
+
+use std::time::{Duration, Instant};
+
+pub use std::hint::black_box;
+
+const SAMPLES: usize = 15;
+const SAMPLE_TARGET: Duration = Duration::from_millis(20);
+
+pub struct Bench {
+    filter: Option<String>,
+}
+
+impl Bench {
+    /// Read the name filter from the command line (`cargo bench` also
+    /// passes `--bench`, which is ignored).
+    pub fn from_args() -> Self {
+        Self {
+            filter: std::env::args().skip(1).find(|a| !a.starts_with('-')),
+        }
+    }
+
+    /// Time `f`, where each call performs `units` of work measured in
+    /// `unit` (e.g. 100 000 "cycles").
+    pub fn run<T>(&self, name: &str, units: u64, unit: &str, mut f: impl FnMut() -> T) {
+        if let Some(filter) = &self.filter
+            && !name.contains(filter.as_str())
+        {
+            return;
+        }
+
+        // Warm up and calibrate: double the batch until it fills a sample
+        let mut iters = 1u64;
+        loop {
+            let start = Instant::now();
+            for _ in 0..iters {
+                black_box(f());
+            }
+            if start.elapsed() >= SAMPLE_TARGET / 2 || iters >= 1 << 30 {
+                break;
+            }
+            iters *= 2;
+        }
+
+        let mut per_iter: Vec<f64> = (0..SAMPLES)
+            .map(|_| {
+                let start = Instant::now();
+                for _ in 0..iters {
+                    black_box(f());
+                }
+                start.elapsed().as_secs_f64() / iters as f64
+            })
+            .collect();
+        per_iter.sort_by(f64::total_cmp);
+        let median = per_iter[SAMPLES / 2];
+        let spread = (per_iter[SAMPLES - 1] - per_iter[0]) / median * 100.0;
+
+        println!(
+            "{name:<40} {:>12}/iter  (spread {spread:>4.1}%)  {:>12} {unit}/s",
+            format_time(median),
+            format_rate(units as f64 / median),
+        );
+    }
+}
+
+fn format_time(secs: f64) -> String {
+    if secs >= 1e-3 {
+        format!("{:.3} ms", secs * 1e3)
+    } else if secs >= 1e-6 {
+        format!("{:.3} µs", secs * 1e6)
+    } else {
+        format!("{:.1} ns", secs * 1e9)
+    }
+}
+
+fn format_rate(per_sec: f64) -> String {
+    if per_sec >= 1e6 {
+        format!("{:.2} M", per_sec / 1e6)
+    } else if per_sec >= 1e3 {
+        format!("{:.2} k", per_sec / 1e3)
+    } else {
+        format!("{per_sec:.1}")
+    }
+}
@@ -23,6 +23,13 @@ pub trait Sample: Copy + Default {
     /// Add a sample value to the accumulator.
     fn accum_add(accum: &mut Self::Accum, sample: Self);
 
+    /// Add `n` copies of a sample value to the accumulator.
+    fn accum_add_n(accum: &mut Self::Accum, sample: Self, n: u32) {
+        for _ in 0..n {
+            Self::accum_add(accum, sample);
+        }
+    }
+
     /// Compute the average from the accumulator and sample count.
     fn accum_avg(accum: Self::Accum, count: u32) -> Self;
 
@@ -41,6 +48,11 @@ impl Sample for i16 {
         *accum += sample as i64;
     }
 
+    #[inline]
+    fn accum_add_n(accum: &mut i64, sample: i16, n: u32) {
+        *accum += sample as i64 * n as i64;
+    }
+
     #[inline]
     fn accum_avg(accum: i64, count: u32) -> i16 {
         (accum / count as i64) as i16
@@ -63,6 +75,11 @@ impl Sample for f32 {
         *accum += sample;
     }
 
+    #[inline]
+    fn accum_add_n(accum: &mut f32, sample: f32, n: u32) {
+        *accum += sample * n as f32;
+    }
+
     #[inline]
     fn accum_avg(accum: f32, count: u32) -> f32 {
         accum / count as f32
@@ -121,6 +138,49 @@ impl<T: Sample> AudioResampler<T> {
         }
     }
 
+    /// Accumulate `n` copies of one input sample, pushing every output
+    /// sample they complete.
+    ///
+    /// Equivalent to `n` calls to [`tick`](Self::tick) (bit-exact for `i16`),
+    /// but steps from one output boundary to the next instead of per input
+    /// clock. Devices whose output only changes on register writes use this
+    /// to render the interval since their last update in one call.
+    pub fn tick_n(&mut self, sample: T, mut n: u64) {
+        while n > 0 {
+            // Input clocks until the phase crosses the next output boundary
+            let to_edge = (self.input_rate - self.sample_phase).div_ceil(self.output_rate);
+            let k = n.min(to_edge);
+            T::accum_add_n(&mut self.sample_accum, sample, k as u32);
+            self.sample_count += k as u32;
+            self.sample_phase += k * self.output_rate;
+            n -= k;
+
+            if self.sample_phase >= self.input_rate {
+                self.sample_phase -= self.input_rate;
+                let avg = T::accum_avg(self.sample_accum, self.sample_count);
+                self.sample_accum = T::Accum::default();
+                self.sample_count = 0;
+                self.buffer.push(avg);
+            }
+        }
+    }
+
+    /// Filter state after `n` more ticks of `sample`, without the output
+    /// buffer. Lets a lazily rendering device save the state it would have
+    /// reached had it been ticked every clock.
+    pub fn advanced(&self, sample: T, n: u64) -> Self {
+        let mut copy = Self {
+            sample_accum: self.sample_accum,
+            sample_count: self.sample_count,
+            sample_phase: self.sample_phase,
+            input_rate: self.input_rate,
+            output_rate: self.output_rate,
+            buffer: Vec::new(),
+        };
+        copy.tick_n(sample, n);
+        copy
+    }
+
     /// Accumulate one input sample. If this tick completes an output sample,
     /// returns the box-filtered average without pushing it to the buffer.
     ///
@@ -198,6 +258,10 @@ impl<T: Sample> Saveable for AudioResampler<T> {
         self.buffer = Vec::new();
         Ok(())
     }
+
+    fn state_size(&self) -> usize {
+        1 + std::mem::size_of::<T::Accum>() + 4 + 8
+    }
 }
 
 #[cfg(test)]
@@ -309,6 +373,29 @@ mod tests {
         assert_eq!(r2.sample_phase, r.sample_phase);
     }
 
+    #[test]
+    fn tick_n_matches_repeated_tick() {
+        let mut a = AudioResampler::<i16>::new(1_000_000, 44_100);
+        let mut b = AudioResampler::<i16>::new(1_000_000, 44_100);
+        for (i, run) in [1u64, 7, 22, 23, 500, 3, 12_345, 1].iter().enumerate() {
+            let sample = (i as i16 - 4) * 1000;
+            for _ in 0..*run {
+                a.tick(sample);
+            }
+            b.tick_n(sample, *run);
+            assert_eq!(a.sample_accum, b.sample_accum);
+            assert_eq!(a.sample_count, b.sample_count);
+            assert_eq!(a.sample_phase, b.sample_phase);
+        }
+        assert_eq!(a.drain_audio(), b.drain_audio());
+
+        // advanced() reports the same filter state without touching self
+        let c = b.advanced(500, 99);
+        b.tick_n(500, 99);
+        assert_eq!(c.sample_accum, b.sample_accum);
+        assert_eq!(c.sample_phase, b.sample_phase);
+    }
+
     // -- AudioResampler<f32> tests --
 
     #[test]
@@ -0,0 +1,424 @@
+//! Lockstep batches of one machine, for automated play-testing and agent
+//! training.
+//!
+//! A [`MachineBatch`] owns many instances of the same machine and advances
+//! them together: one [`step`](MachineBatch::step) applies each instance's
+//! buttons, runs every instance the same number of frames on a pool of worker
+//! threads, and writes each instance's observation (its framebuffer followed
+//! by any RAM views) into one contiguous caller-provided buffer:
+//!
+//! ```text
+//! obs = [ instance 0: RGB24 frame | RAM view 0 | RAM view 1 | ... ]
+//!       [ instance 1: RGB24 frame | RAM view 0 | RAM view 1 | ... ]
+//!       ...
+//! ```
+//!
+//! The instances are split into one contiguous run per thread. The first run
+//! steps on the calling thread; each other run belongs to a worker started
+//! by [`new`](MachineBatch::new) or [`set_threads`](MachineBatch::set_threads),
+//! which receives the run by value for a step and hands it back when done.
+//! Each run writes straight into its own chunk of `obs`; the step does not
+//! return until every worker has handed its run back, so no worker touches
+//! `obs` afterwards. Create the instances from one loaded
+//! ROM set: machines decode graphics through the set's
+//! [`GfxDecodes`](crate::gfx::decode::GfxDecodes), so the pixels are decoded
+//! once and shared.
+
+use std::marker::PhantomData;
+use std::sync::{Arc, mpsc};
+use std::thread;
+
+use super::machine::Machine;
+
+/// A window of a CPU's address space copied into each observation.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct RamView {
+    pub cpu_index: usize,
+    pub start: u16,
+    pub len: u16,
+}
+
+struct Instance {
+    machine: Box<dyn Machine>,
+    /// Buttons currently held, bit `n` for input id `n`.
+    buttons: u64,
+}
+
+/// Instances of one machine stepped in lockstep across worker threads.
+pub struct MachineBatch {
+    /// One contiguous run of instances per thread, in instance order.
+    runs: Vec<Run>,
+    /// Workers for `runs[1..]`; `runs[0]` steps on the calling thread.
+    workers: Vec<Worker>,
+    len: usize,
+    /// Instances per run; only the last run may be shorter.
+    per_run: usize,
+    settings: Arc<Settings>,
+}
+
+impl MachineBatch {
+    /// Build a batch from freshly created instances. All instances must be
+    /// the same machine. Defaults: one thread per available core, one frame
+    /// per step, frames rendered, no RAM views.
+    pub fn new(machines: Vec<Box<dyn Machine>>) -> Self {
+        assert!(!machines.is_empty(), "a batch needs at least one instance");
+        let id = machines[0].machine_id().to_string();
+        let size = machines[0].display_size();
+        assert!(
+            machines
+                .iter()
+                .all(|m| m.machine_id() == id && m.display_size() == size),
+            "all instances in a batch must be the same machine"
+        );
+        let len = machines.len();
+        let mut batch = Self {
+            runs: vec![Run {
+                instances: machines
+                    .into_iter()
+                    .map(|machine| Instance {
+                        machine,
+                        buttons: 0,
+                    })
+                    .collect(),
+                ..Run::default()
+            }],
+            workers: Vec::new(),
+            len,
+            per_run: len,
+            settings: Arc::new(Settings {
+                ram_views: Vec::new(),
+                frames_per_step: 1,
+                render: true,
+                frame_bytes: (size.0 * size.1 * 3) as usize,
+            }),
+        };
+        batch.set_threads(thread::available_parallelism().map_or(1, |n| n.get()));
+        batch
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Worker threads per step (clamped to `1..=len()`). Starts or stops
+    /// workers as needed; they then persist across steps.
+    pub fn set_threads(&mut self, threads: usize) {
+        let per_run = self.len.div_ceil(threads.clamp(1, self.len));
+        let runs = std::mem::take(&mut self.runs);
+        let mut instances = runs.into_iter().flat_map(|run| run.instances);
+        while let Some(first) = instances.next() {
+            let mut run = Run::default();
+            run.instances.push(first);
+            run.instances.extend(instances.by_ref().take(per_run - 1));
+            self.runs.push(run);
+        }
+        self.per_run = per_run;
+        let workers = self.runs.len() - 1;
+        self.workers.truncate(workers);
+        while self.workers.len() < workers {
+            self.workers.push(Worker::spawn());
+        }
+    }
+
+    /// Frames each instance runs per step, holding the same buttons; only
+    /// the last frame is rendered.
+    pub fn set_frames_per_step(&mut self, frames: u32) {
+        Arc::make_mut(&mut self.settings).frames_per_step = frames.max(1);
+    }
+
+    /// Include the RGB24 framebuffer in observations. Turning it off skips
+    /// rendering entirely, for agents that only read RAM.
+    pub fn set_render(&mut self, render: bool) {
+        Arc::make_mut(&mut self.settings).render = render;
+    }
+
+    /// Append a RAM view to every observation.
+    pub fn add_ram_view(&mut self, view: RamView) {
+        Arc::make_mut(&mut self.settings).ram_views.push(view);
+    }
+
+    /// Bytes of one instance's observation.
+    pub fn observation_size(&self) -> usize {
+        self.settings.observation_size()
+    }
+
+    pub fn instance(&self, index: usize) -> &dyn Machine {
+        self.runs[index / self.per_run].instances[index % self.per_run]
+            .machine
+            .as_ref()
+    }
+
+    /// Direct access to one instance, e.g. to load an episode's start state
+    /// or deliver analog input. Buttons should go through
+    /// [`step`](Self::step), which only forwards changes.
+    pub fn instance_mut(&mut self, index: usize) -> &mut dyn Machine {
+        self.runs[index / self.per_run].instances[index % self.per_run]
+            .machine
+            .as_mut()
+    }
+
+    /// Press `buttons[i]` on instance `i` (bit `n` holds input id `n`), run
+    /// every instance for the configured frames, then write observations
+    /// into `obs`, which must hold `len() * observation_size()` bytes.
+    pub fn step(&mut self, buttons: &[u64], obs: &mut [u8]) {
+        assert_eq!(buttons.len(), self.len, "one button mask per instance");
+        for (run, buttons) in self.runs.iter_mut().zip(buttons.chunks(self.per_run)) {
+            run.buttons.clear();
+            run.buttons.extend_from_slice(buttons);
+        }
+        self.dispatch(Job::Step, obs);
+    }
+
+    /// Write the current observations without running, e.g. after a reset.
+    pub fn observe(&mut self, obs: &mut [u8]) {
+        self.dispatch(Job::Observe, obs);
+    }
+
+    /// Do `job` on every run, each writing its own chunk of `obs`: hand
+    /// the other runs to their workers while the calling thread does the
+    /// first, then wait for the workers to hand them back.
+    fn dispatch(&mut self, job: Job, obs: &mut [u8]) {
+        let obs_size = self.observation_size();
+        assert_eq!(
+            obs.len(),
+            self.len * obs_size,
+            "observation buffer must hold len() * observation_size() bytes"
+        );
+        // Without a frame or RAM views the observation is empty and `obs`
+        // has no chunks; the runs still step, with empty ones
+        let mut chunks = obs
+            .chunks_mut((self.per_run * obs_size).max(1))
+            .chain(std::iter::repeat_with(Default::default));
+        let first_obs = chunks.next().unwrap();
+        let (first, rest) = self.runs.split_first_mut().unwrap();
+        let mut handoff = Handoff {
+            workers: &self.workers,
+            runs: rest,
+            sent: 0,
+            received: 0,
+            _obs: PhantomData,
+        };
+        for chunk in chunks.take(handoff.runs.len()) {
+            handoff.send(job, &self.settings, chunk);
+        }
+        first.run(job, &self.settings, first_obs);
+        handoff.finish();
+    }
+}
+
+/// The runs handed to workers for one [`MachineBatch::dispatch`], with the
+/// chunks of `obs` they write.
+///
+/// Waiting for every run to come back is what keeps the chunks borrowed
+/// for as long as a worker can write them, so it also happens on unwind:
+/// if the calling thread's run panics, dropping the hand-off still waits
+/// for the workers before `obs` is released.
+struct Handoff<'a, 'obs> {
+    workers: &'a [Worker],
+    runs: &'a mut [Run],
+    sent: usize,
+    received: usize,
+    _obs: PhantomData<&'obs mut [u8]>,
+}
+
+impl<'obs> Handoff<'_, 'obs> {
+    fn send(&mut self, job: Job, settings: &Arc<Settings>, obs: &'obs mut [u8]) {
+        let i = self.sent;
+        let chunk = ObsChunk {
+            ptr: obs.as_mut_ptr(),
+            len: obs.len(),
+        };
+        self.workers[i]
+            .tx
+            .send((
+                job,
+                std::mem::take(&mut self.runs[i]),
+                settings.clone(),
+                chunk,
+            ))
+            .expect("batch worker exited");
+        self.sent += 1;
+    }
+
+    fn finish(mut self) {
+        while self.received < self.sent {
+            let i = self.received;
+            // Counted first: a worker that panicked holds no chunk
+            self.received += 1;
+            self.runs[i] = self.workers[i].done.recv().expect("batch worker panicked");
+        }
+    }
+}
+
+impl Drop for Handoff<'_, '_> {
+    fn drop(&mut self) {
+        for i in self.received..self.sent {
+            if let Ok(run) = self.workers[i].done.recv() {
+                self.runs[i] = run;
+            }
+        }
+    }
+}
+
+/// A run's chunk of the caller's `obs`, sent to its worker for one job.
+struct ObsChunk {
+    ptr: *mut u8,
+    len: usize,
+}
+
+// SAFETY: the chunk is an exclusive borrow split off `obs` by
+// `chunks_mut`, so no other thread sees it. `Handoff` keeps `obs` borrowed
+// until the worker has sent its run back, after which it no longer uses
+// the pointer.
+unsafe impl Send for ObsChunk {}
+
+impl ObsChunk {
+    /// # Safety
+    /// Only between receiving the chunk and sending the run back.
+    unsafe fn as_mut_slice(&mut self) -> &mut [u8] {
+        // SAFETY: see `ObsChunk`'s `Send` impl; `ptr` and `len` come from
+        // a live `&mut [u8]`.
+        unsafe { std::slice::from_raw_parts_mut(self.ptr, self.len) }
+    }
+}
+
+/// Observation layout and per-step settings, shared with the workers.
+#[derive(Clone)]
+struct Settings {
+    ram_views: Vec<RamView>,
+    frames_per_step: u32,
+    render: bool,
+    frame_bytes: usize,
+}
+
+impl Settings {
+    fn observation_size(&self) -> usize {
+        let ram: usize = self.ram_views.iter().map(|v| v.len as usize).sum();
+        if self.render {
+            self.frame_bytes + ram
+        } else {
+            ram
+        }
+    }
+
+    fn observe_into(&self, machine: &dyn Machine, out: &mut [u8]) {
+        let mut out = out;
+        if self.render {
+            let (frame, rest) = out.split_at_mut(self.frame_bytes);
+            machine.render_frame(frame);
+            out = rest;
+        }
+        for view in &self.ram_views {
+            let (dst, rest) = out.split_at_mut(view.len as usize);
+            let map = machine.memory_map(view.cpu_index);
+            for (i, byte) in dst.iter_mut().enumerate() {
+                let addr = view.start.wrapping_add(i as u16);
+                // I/O and unmapped addresses read as 0
+                *byte = map.and_then(|m| m.debug_read(addr)).unwrap_or(0);
+            }
+            out = rest;
+        }
+    }
+}
+
+#[derive(Clone, Copy)]
+enum Job {
+    /// Apply `Run::buttons`, run the configured frames, then observe.
+    Step,
+    /// Observe without running.
+    Observe,
+}
+
+/// A contiguous run of instances with its buttons.
+#[derive(Default)]
+struct Run {
+    instances: Vec<Instance>,
+    /// This step's button masks, one per instance.
+    buttons: Vec<u64>,
+}
+
+impl Run {
+    /// Do `job`, writing the observations, in instance order, into `obs`.
+    fn run(&mut self, job: Job, settings: &Settings, obs: &mut [u8]) {
+        let obs_size = settings.observation_size();
+        for (j, instance) in self.instances.iter_mut().enumerate() {
+            if let Job::Step = job {
+                instance.set_buttons(self.buttons[j]);
+                instance.run(settings.frames_per_step);
+            }
+            let start = j * obs_size;
+            settings.observe_into(instance.machine.as_ref(), &mut obs[start..start + obs_size]);
+        }
+    }
+}
+
+/// Worker thread that does jobs on the runs it is handed.
+struct Worker {
+    tx: mpsc::Sender<(Job, Run, Arc<Settings>, ObsChunk)>,
+    done: mpsc::Receiver<Run>,
+    thread: Option<thread::JoinHandle<()>>,
+}
+
+impl Worker {
+    fn spawn() -> Self {
+        let (tx, rx) = mpsc::channel();
+        let (done_tx, done) = mpsc::channel();
+        let thread = thread::Builder::new()
+            .name("batch-worker".into())
+            .spawn(move || Self::run(rx, done_tx))
+            .expect("failed to spawn batch worker thread");
+        Self {
+            tx,
+            done,
+            thread: Some(thread),
+        }
+    }
+
+    fn run(rx: mpsc::Receiver<(Job, Run, Arc<Settings>, ObsChunk)>, done: mpsc::Sender<Run>) {
+        for (job, mut run, settings, mut obs) in rx {
+            // SAFETY: the chunk is only used before the run is sent back.
+            run.run(job, &settings, unsafe { obs.as_mut_slice() });
+            drop(settings);
+            if done.send(run).is_err() {
+                return;
+            }
+        }
+    }
+}
+
+impl Drop for Worker {
+    fn drop(&mut self) {
+        // Closing the channel ends the worker loop.
+        let (tx, _) = mpsc::channel();
+        drop(std::mem::replace(&mut self.tx, tx));
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+impl Instance {
+    fn set_buttons(&mut self, buttons: u64) {
+        let mut changed = buttons ^ self.buttons;
+        while changed != 0 {
+            let id = changed.trailing_zeros();
+            self.machine.set_input(id as u8, buttons & (1 << id) != 0);
+            changed &= changed - 1;
+        }
+        self.buttons = buttons;
+    }
+
+    fn run(&mut self, frames: u32) {
+        // Audio is not part of the observation, but undrained samples would
+        // pile up in the machine's buffers
+        let mut audio = [0i16; 2048];
+        for _ in 0..frames {
+            self.machine.run_frame();
+            while self.machine.fill_audio(&mut audio) == audio.len() {}
+        }
+    }
+}
@@ -34,6 +34,60 @@ pub trait Bus {
 
     /// Generic interrupt query. CPUs pick what they need.
     fn check_interrupts(&mut self, target: BusMaster) -> InterruptState;
+
+    /// Report whether `addr` holds immutable code for this master.
+    ///
+    /// Returns the memory map's generation when the byte at `addr` can only
+    /// change through a bank switch or ROM reload (see
+    /// [`MemoryMap::code_generation`](super::MemoryMap::code_generation)),
+    /// or `None` for RAM, I/O, and unmapped space. CPUs with a predecode
+    /// cache skip refetching instruction bytes while the generation holds.
+    /// Default: `None` (never cache).
+    fn code_generation(&self, _master: BusMaster, _addr: Self::Address) -> Option<u32> {
+        None
+    }
+
+    /// Report whether a read of `addr` by this master is invisible to the
+    /// rest of the machine and returns a value only the master's own writes
+    /// can change.
+    ///
+    /// True for ROM and for RAM that no other CPU or free-running DMA
+    /// writes. False for device registers whose reads clear flags or whose
+    /// inputs move on their own (PIA, RIOT, input ports, beam counters), and
+    /// while a watchpoint has to see the access. CPUs use it to recognize
+    /// idle loops (see [`crate::cpu::idle`]): a loop that only makes pure
+    /// reads repeats exactly until an interrupt.
+    /// Default: `false` (never idle).
+    fn is_pure_read(&self, _master: BusMaster, _addr: Self::Address) -> bool {
+        false
+    }
+
+    /// Move `len` bytes for a block-transfer instruction in one call.
+    ///
+    /// Byte `i` goes from `src + i` to `dst + i` (`- i` when `descending`),
+    /// strictly in order, so overlapping ranges replicate exactly as the
+    /// CPU's per-byte loop would. Returns `false` without touching memory
+    /// unless both ranges are plain backed memory with no access side
+    /// effects (see [`MemoryMap::block_copy`](super::MemoryMap::block_copy));
+    /// the CPU then falls back to per-byte `read`/`write`.
+    ///
+    /// A cycle-stepped CPU may call this at the start of a run and then
+    /// spend the run's remaining cycles, so the destination bytes change
+    /// ahead of the instruction's own timing. Only accept destinations that
+    /// nothing but the CPU reads: not video, sprite or palette RAM sampled
+    /// by the renderer, and not RAM shared with another CPU or a DMA
+    /// controller. Boards whose NMI can fire mid-run must decline.
+    /// Default: `false` (never bulk).
+    fn block_copy(
+        &mut self,
+        _master: BusMaster,
+        _src: Self::Address,
+        _dst: Self::Address,
+        _len: u32,
+        _descending: bool,
+    ) -> bool {
+        false
+    }
 }
 
 #[derive(Clone, Copy, Debug)]
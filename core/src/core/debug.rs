@@ -52,6 +52,10 @@ pub trait DebugCpu: Debuggable {
 
     /// Disassemble one instruction from raw bytes at the given address.
     fn debug_disassemble(&self, addr: u16, bytes: &[u8]) -> DisassembledInstruction;
+
+    /// Enable or disable idle-loop skipping (see [`crate::cpu::idle`]).
+    /// CPUs without a detector ignore this.
+    fn set_idle_skip(&mut self, _enabled: bool) {}
 }
 
 /// Debug view of a bus and its connected devices.
@@ -102,4 +106,7 @@ pub trait BusDebug {
     fn memory_map(&self, _cpu_index: usize) -> Option<&MemoryMap> {
         None
     }
+
+    /// Enable or disable idle-loop skipping on every CPU of this bus.
+    fn set_idle_skip(&mut self, _enabled: bool) {}
 }
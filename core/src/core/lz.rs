@@ -0,0 +1,335 @@
+//! Small LZ77 block codec for save files.
+//!
+//! The format follows LZ4's sequence layout: a token byte whose high nibble
+//! is the literal count and low nibble the match length minus
+//! [`MIN_MATCH`], with 15 in either nibble extended by 255-continuation
+//! bytes; then the literals; then the match offset. Offsets are LEB128
+//! varints rather than LZ4's fixed 16 bits, so matches can reach back into
+//! a preset dictionary of any size. The final sequence carries literals
+//! only and ends the block.
+//!
+//! A dictionary is a byte string both sides agree on (the machine's ROM
+//! set). Matches may point into it as if it preceded the data, so state
+//! that repeats ROM contents is stored as short references.
+//!
+//! Save states are dominated by zero-filled RAM, which collapses into
+//! offset-1 matches; compression runs at a few hundred MB/s, which keeps a
+//! quick-save well under a frame.
+
+/// Shortest match worth encoding (token + offset costs about 3 bytes).
+const MIN_MATCH: usize = 4;
+
+const HASH_BITS: u32 = 16;
+
+/// Most output bytes one block byte can decode to: a 255 length
+/// continuation byte. Token and offset bytes yield less, literals one each.
+const MAX_EXPANSION: usize = 255;
+
+#[inline]
+fn hash4(v: u32) -> usize {
+    (v.wrapping_mul(2_654_435_761) >> (32 - HASH_BITS)) as usize
+}
+
+/// The dictionary followed by the input, addressed as one sequence.
+struct Window<'a> {
+    dict: &'a [u8],
+    src: &'a [u8],
+}
+
+impl Window<'_> {
+    #[inline]
+    fn len(&self) -> usize {
+        self.dict.len() + self.src.len()
+    }
+
+    #[inline]
+    fn byte(&self, i: usize) -> u8 {
+        if i < self.dict.len() {
+            self.dict[i]
+        } else {
+            self.src[i - self.dict.len()]
+        }
+    }
+
+    #[inline]
+    fn word(&self, i: usize) -> u32 {
+        let d = self.dict.len();
+        if i >= d {
+            let s = &self.src[i - d..i - d + 4];
+            u32::from_le_bytes([s[0], s[1], s[2], s[3]])
+        } else if i + 4 <= d {
+            let s = &self.dict[i..i + 4];
+            u32::from_le_bytes([s[0], s[1], s[2], s[3]])
+        } else {
+            u32::from_le_bytes([
+                self.byte(i),
+                self.byte(i + 1),
+                self.byte(i + 2),
+                self.byte(i + 3),
+            ])
+        }
+    }
+}
+
+/// Compress `src`, allowing matches into `dict`. Appends to `out`.
+pub fn compress(src: &[u8], dict: &[u8], out: &mut Vec<u8>) {
+    let win = Window { dict, src };
+    let end = win.len();
+    // Table entries are window positions + 1 (0 = empty)
+    let mut table = vec![0u32; 1 << HASH_BITS];
+
+    let mut i = 0;
+    while i + MIN_MATCH <= dict.len() {
+        table[hash4(win.word(i))] = i as u32 + 1;
+        i += 1;
+    }
+
+    let mut anchor = dict.len(); // start of pending literals
+    let mut i = dict.len();
+    while i + MIN_MATCH <= end {
+        let h = hash4(win.word(i));
+        let cand = table[h] as usize;
+        table[h] = i as u32 + 1;
+        if cand == 0 || win.word(cand - 1) != win.word(i) {
+            i += 1;
+            continue;
+        }
+        let m = cand - 1;
+        let mut len = MIN_MATCH;
+        while i + len < end && win.byte(m + len) == win.byte(i + len) {
+            len += 1;
+        }
+        write_sequence(
+            out,
+            &src[anchor - dict.len()..i - dict.len()],
+            Some((i - m, len)),
+        );
+
+        // Index a few positions inside the match so runs keep chaining
+        let stop = (i + len).min(end.saturating_sub(MIN_MATCH - 1));
+        let mut j = i + 1;
+        while j < stop && j < i + 16 {
+            table[hash4(win.word(j))] = j as u32 + 1;
+            j += 1;
+        }
+        i += len;
+        anchor = i;
+    }
+    write_sequence(out, &src[anchor - dict.len()..], None);
+}
+
+fn write_sequence(out: &mut Vec<u8>, literals: &[u8], m: Option<(usize, usize)>) {
+    let lit = literals.len();
+    let ml = m.map_or(0, |(_, len)| len - MIN_MATCH);
+    out.push(((lit.min(15) as u8) << 4) | ml.min(15) as u8);
+    if lit >= 15 {
+        write_length(out, lit - 15);
+    }
+    out.extend_from_slice(literals);
+    if let Some((offset, _)) = m {
+        write_varint(out, offset);
+        if ml >= 15 {
+            write_length(out, ml - 15);
+        }
+    }
+}
+
+fn write_length(out: &mut Vec<u8>, mut n: usize) {
+    while n >= 255 {
+        out.push(255);
+        n -= 255;
+    }
+    out.push(n as u8);
+}
+
+fn write_varint(out: &mut Vec<u8>, mut v: usize) {
+    while v >= 0x80 {
+        out.push(v as u8 | 0x80);
+        v >>= 7;
+    }
+    out.push(v as u8);
+}
+
+/// Decompress a block produced by [`compress`] with the same `dict`.
+/// Returns `None` if the block is malformed or does not decode to exactly
+/// `expected_len` bytes.
+///
+/// `expected_len` usually comes from a file header, so a length the block
+/// cannot possibly decode to is rejected before anything is allocated.
+pub fn decompress(block: &[u8], dict: &[u8], expected_len: usize) -> Option<Vec<u8>> {
+    if expected_len > block.len().saturating_mul(MAX_EXPANSION) {
+        return None;
+    }
+    let mut out = Vec::with_capacity(expected_len);
+    let mut r = 0;
+    while r < block.len() {
+        let token = block[r];
+        r += 1;
+
+        let mut lit = (token >> 4) as usize;
+        if lit == 15 {
+            lit += read_length(block, &mut r)?;
+        }
+        let literals = block.get(r..r.checked_add(lit)?)?;
+        if out.len() + lit > expected_len {
+            return None;
+        }
+        out.extend_from_slice(literals);
+        r += lit;
+        if r == block.len() {
+            break; // final literal-only sequence
+        }
+
+        let offset = read_varint(block, &mut r)?;
+        let mut len = (token & 0x0F) as usize;
+        if len == 15 {
+            len += read_length(block, &mut r)?;
+        }
+        len += MIN_MATCH;
+
+        let pos = dict.len() + out.len();
+        if offset == 0 || offset > pos || out.len() + len > expected_len {
+            return None;
+        }
+        let start = pos - offset;
+        if start >= dict.len() {
+            // Within the output. When the match overlaps what it is
+            // writing, the copied span repeats with period `offset`, so
+            // copy whole periods and let the chunk double each pass.
+            let from = start - dict.len();
+            let stop = out.len() + len;
+            while out.len() < stop {
+                let n = (out.len() - from).min(stop - out.len());
+                out.extend_from_within(from..from + n);
+            }
+        } else {
+            for k in start..start + len {
+                let b = if k < dict.len() {
+                    dict[k]
+                } else {
+                    out[k - dict.len()]
+                };
+                out.push(b);
+            }
+        }
+    }
+    (out.len() == expected_len).then_some(out)
+}
+
+fn read_length(block: &[u8], r: &mut usize) -> Option<usize> {
+    let mut n = 0usize;
+    loop {
+        let b = *block.get(*r)?;
+        *r += 1;
+        n = n.checked_add(b as usize)?;
+        if b != 255 {
+            return Some(n);
+        }
+    }
+}
+
+fn read_varint(block: &[u8], r: &mut usize) -> Option<usize> {
+    let mut v = 0usize;
+    let mut shift = 0;
+    loop {
+        let b = *block.get(*r)?;
+        *r += 1;
+        if shift >= usize::BITS {
+            return None;
+        }
+        v |= ((b & 0x7F) as usize) << shift;
+        if b & 0x80 == 0 {
+            return Some(v);
+        }
+        shift += 7;
+    }
+}
+
+// -- Tests -------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn round_trip(src: &[u8], dict: &[u8]) -> usize {
+        let mut block = Vec::new();
+        compress(src, dict, &mut block);
+        assert_eq!(decompress(&block, dict, src.len()).as_deref(), Some(src));
+        block.len()
+    }
+
+    /// Mostly-zero RAM with a few live bytes, like a save state.
+    fn sparse_state() -> Vec<u8> {
+        let mut s = vec![0u8; 48 * 1024];
+        for i in (0..s.len()).step_by(997) {
+            s[i] = (i * 31) as u8;
+        }
+        s[100..140].copy_from_slice(&[0xA5; 40]);
+        s
+    }
+
+    #[test]
+    fn round_trips_edge_cases() {
+        round_trip(&[], &[]);
+        round_trip(&[7], &[]);
+        round_trip(b"abcabcabcabcabcabcabcabc", &[]);
+        let noise: Vec<u8> = (0..5000u32)
+            .map(|i| (i.wrapping_mul(2_654_435_761) >> 13) as u8)
+            .collect();
+        round_trip(&noise, &[]);
+        round_trip(&noise, &noise[..1000]);
+    }
+
+    #[test]
+    fn zero_filled_ram_compresses_well() {
+        let state = sparse_state();
+        let size = round_trip(&state, &[]);
+        assert!(size < state.len() / 20, "{size} bytes");
+    }
+
+    #[test]
+    fn dictionary_turns_rom_copies_into_references() {
+        let mut x = 0x2545_F491u32;
+        let rom: Vec<u8> = (0..16 * 1024)
+            .map(|_| {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                x as u8
+            })
+            .collect();
+        let mut state = sparse_state();
+        state[8192..8192 + 4096].copy_from_slice(&rom[2048..2048 + 4096]);
+
+        let plain = round_trip(&state, &[]);
+        let with_dict = round_trip(&state, &rom);
+        assert!(plain > 4096);
+        assert!(with_dict < plain - 4000, "{with_dict} vs {plain}");
+    }
+
+    #[test]
+    fn rejects_malformed_blocks() {
+        let state = sparse_state();
+        let mut block = Vec::new();
+        compress(&state, &[], &mut block);
+
+        assert!(decompress(&block, &[], state.len() - 1).is_none());
+        assert!(decompress(&block[..block.len() / 2], &[], state.len()).is_none());
+        // A match reaching before the start of the window
+        assert!(decompress(&[0x00, 0x05], &[], 4).is_none());
+        // A length from a corrupt header, far past what the block can hold
+        assert!(decompress(&block, &[], usize::MAX).is_none());
+        assert!(decompress(&block, &[], block.len() * MAX_EXPANSION + 1).is_none());
+    }
+
+    #[test]
+    fn expansion_bound_is_reachable() {
+        // The longest match per block byte: all-zero RAM
+        let zeros = vec![0u8; 1 << 20];
+        let mut block = Vec::new();
+        compress(&zeros, &[], &mut block);
+        assert!(zeros.len() <= block.len() * MAX_EXPANSION);
+        assert!(zeros.len() > block.len() * (MAX_EXPANSION - 1));
+        assert_eq!(decompress(&block, &[], zeros.len()), Some(zeros));
+    }
+}
@@ -14,6 +14,7 @@ pub struct AnalogInput {
     pub name: &'static str,
 }
 
+use std::cell::RefCell;
 use std::time::Duration;
 
 use crate::device::dvg::VectorLine;
@@ -21,6 +22,7 @@ use crate::device::dvg::VectorLine;
 use super::debug::BusDebug;
 use super::memory_map::{MemoryMap, WatchpointHit, WatchpointKind};
 use super::save_state::SaveError;
+use super::state_hash;
 
 /// A named timing span from machine-level profiling.
 ///
@@ -63,6 +65,125 @@ impl TimingConfig {
     }
 }
 
+/// Incrementally tracked raster beam position.
+///
+/// Replaces `clock % cycles_per_frame() / cycles_per_scanline` in board
+/// tick loops. The (scanline, cycle-in-line) pair advances by one cycle per
+/// [`step`](Self::step), which reports when a new scanline begins, so
+/// boards do their per-line work at that event instead of dividing every
+/// cycle. [`cycles_until_next_scanline`](Self::cycles_until_next_scanline)
+/// and [`cycles_until_scanline`](Self::cycles_until_scanline) tell a board
+/// how long it can run before the next raster event.
+///
+/// The position is derived state: boards do not save it and rebuild it from
+/// their master clock with [`at_clock`](Self::at_clock) after a load.
+///
+/// # Example
+///
+/// ```
+/// use phosphor_core::core::{BeamPosition, TimingConfig};
+///
+/// const T: TimingConfig = TimingConfig {
+///     cpu_clock_hz: 1_000_000,
+///     cycles_per_scanline: 64,
+///     total_scanlines: 260,
+///     display_width: 292,
+///     display_height: 240,
+/// };
+/// let mut beam = BeamPosition::new();
+/// let mut lines = 0;
+/// for _ in 0..T.cycles_per_frame() {
+///     if beam.step(&T) { lines += 1; }
+/// }
+/// assert_eq!(lines, 260);
+/// assert_eq!(beam, BeamPosition::at_clock(&T, T.cycles_per_frame()));
+/// ```
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct BeamPosition {
+    scanline: u64,
+    cycle: u64,
+}
+
+impl BeamPosition {
+    /// Beam at the start of scanline 0.
+    pub const fn new() -> Self {
+        Self {
+            scanline: 0,
+            cycle: 0,
+        }
+    }
+
+    /// Beam position for an absolute master clock count.
+    pub const fn at_clock(timing: &TimingConfig, clock: u64) -> Self {
+        let frame_cycle = clock % timing.cycles_per_frame();
+        Self {
+            scanline: frame_cycle / timing.cycles_per_scanline,
+            cycle: frame_cycle % timing.cycles_per_scanline,
+        }
+    }
+
+    /// Current scanline (0 = first line of the frame).
+    #[inline]
+    pub const fn scanline(&self) -> u64 {
+        self.scanline
+    }
+
+    /// Cycles elapsed since the current scanline began.
+    #[inline]
+    pub const fn cycle_in_line(&self) -> u64 {
+        self.cycle
+    }
+
+    /// True on the first cycle of a scanline.
+    #[inline]
+    pub const fn at_line_start(&self) -> bool {
+        self.cycle == 0
+    }
+
+    /// Cycles elapsed since the start of the frame.
+    pub const fn frame_cycle(&self, timing: &TimingConfig) -> u64 {
+        self.scanline * timing.cycles_per_scanline + self.cycle
+    }
+
+    /// Advance one cycle. Returns `true` when the beam moves onto the start
+    /// of a new scanline (wrapping to line 0 after the last line).
+    #[inline]
+    pub fn step(&mut self, timing: &TimingConfig) -> bool {
+        self.cycle += 1;
+        if self.cycle < timing.cycles_per_scanline {
+            return false;
+        }
+        self.cycle = 0;
+        self.scanline += 1;
+        if self.scanline == timing.total_scanlines {
+            self.scanline = 0;
+        }
+        true
+    }
+
+    /// Advance `n` cycles at once.
+    pub fn advance(&mut self, timing: &TimingConfig, n: u64) {
+        *self = Self::at_clock(timing, self.frame_cycle(timing) + n);
+    }
+
+    /// Cycles until the next scanline begins.
+    pub const fn cycles_until_next_scanline(&self, timing: &TimingConfig) -> u64 {
+        timing.cycles_per_scanline - self.cycle
+    }
+
+    /// Cycles until the beam next reaches the start of `line` — a full
+    /// frame when it is on that line's first cycle now. Pass the first
+    /// blanked line to get the cycles until VBLANK.
+    pub const fn cycles_until_scanline(&self, timing: &TimingConfig, line: u64) -> u64 {
+        let frame = timing.cycles_per_frame();
+        let target = line * timing.cycles_per_scanline;
+        match (target + frame - self.frame_cycle(timing)) % frame {
+            0 => frame,
+            d => d,
+        }
+    }
+}
+
 /// Screen rotation applied at the display level (after vector generation).
 ///
 /// Matches MAME's screen orientation flags. The rotation is applied by the
@@ -74,6 +195,25 @@ pub enum ScreenRotation {
     Rot270,
 }
 
+/// How finely a machine interleaves its CPUs and devices.
+///
+/// `Cycle` steps every CPU and device one clock at a time. `Scanline` lets a
+/// board run its CPUs for a whole scanline between device syncs, catching
+/// devices up only when a CPU touches them. Boards offer it only when they
+/// have no mid-line raster effects, so both levels produce identical frames
+/// and audio; `Scanline` just spends less time switching between components.
+/// Boards whose CPUs talk through shared RAM may instead use `Scanline` to
+/// run each CPU for up to a scanline in turn; cross-CPU timing is then exact
+/// only at slice boundaries, so output can differ from `Cycle`. Such a level
+/// is opt-in: the machine registry only defaults to levels that match
+/// `Cycle` exactly.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum Accuracy {
+    #[default]
+    Cycle,
+    Scanline,
+}
+
 // ---------------------------------------------------------------------------
 // Sub-traits
 // ---------------------------------------------------------------------------
@@ -229,6 +369,16 @@ pub trait MachineDebug {
     fn memory_map(&self, cpu_index: usize) -> Option<&MemoryMap> {
         self.debug_bus()?.memory_map(cpu_index)
     }
+
+    /// Enable or disable idle-loop skipping (on by default). The debugger
+    /// turns it off to see every pass of a polling loop.
+    ///
+    /// Default: delegates to `BusDebug::set_idle_skip()` via `debug_bus_mut()`.
+    fn set_idle_skip(&mut self, enabled: bool) {
+        if let Some(bus) = self.debug_bus_mut() {
+            bus.set_idle_skip(enabled);
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -243,8 +393,9 @@ pub trait MachineDebug {
 /// palette formats, etc.).
 ///
 /// Composed from sub-traits: [`Renderable`], [`AudioSource`],
-/// [`InputReceiver`], and [`MachineDebug`].
-pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug {
+/// [`InputReceiver`], and [`MachineDebug`]. Machines are `Send` so batches
+/// and batch runners can step instances on worker threads.
+pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug + Send {
     /// Run one frame of emulation (advance the clock by one frame's worth of cycles).
     fn run_frame(&mut self);
 
@@ -257,6 +408,12 @@ pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug {
         60.0
     }
 
+    /// Main CPU clock in Hz (`TimingConfig::cpu_clock_hz`), for reporting
+    /// emulation speed. `None` if the machine does not say.
+    fn cpu_clock_hz(&self) -> Option<u64> {
+        None
+    }
+
     /// Short identifier for this machine type (e.g., "joust", "pacman").
     /// Used to validate save files against the correct machine.
     fn machine_id(&self) -> &str {
@@ -269,6 +426,35 @@ pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug {
         None
     }
 
+    /// Like `save_state()`, but writes the snapshot into `buf` (replacing
+    /// its contents) so per-frame callers such as rewind and run-ahead reuse
+    /// one allocation. Returns `false` if save states are not supported.
+    /// Default: copies from `save_state()`.
+    fn save_state_into(&self, buf: &mut Vec<u8>) -> bool {
+        match self.save_state() {
+            Some(data) => {
+                *buf = data;
+                true
+            }
+            None => false,
+        }
+    }
+
+    /// 64-bit hash of the machine's full state, for comparing runs frame
+    /// by frame (determinism tests, movie and run-ahead checks). Equal
+    /// states hash equally; see `state_hash::hash_bytes`. Returns `None`
+    /// if save states are not supported.
+    /// Default: hashes `save_state_into()` output in a per-thread buffer.
+    fn state_hash(&self) -> Option<u64> {
+        thread_local! {
+            static SCRATCH: RefCell<Vec<u8>> = const { RefCell::new(Vec::new()) };
+        }
+        SCRATCH.with_borrow_mut(|buf| {
+            self.save_state_into(buf)
+                .then(|| state_hash::hash_bytes(buf))
+        })
+    }
+
     /// Restore machine state from a previous `save_state()` snapshot.
     fn load_state(&mut self, _data: &[u8]) -> Result<(), SaveError> {
         Err(SaveError::InvalidFormat("save states not supported".into()))
@@ -282,6 +468,19 @@ pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug {
     /// Load battery-backed RAM contents from a previous save.
     fn load_nvram(&mut self, _data: &[u8]) {}
 
+    /// Allow running independent subsystems on worker threads (e.g. a
+    /// sound board that only receives commands from the main board).
+    ///
+    /// Emulation results are identical either way; this only trades
+    /// threads for frame time. Default: no-op.
+    fn set_threaded(&mut self, _enabled: bool) {}
+
+    /// Select the scheduling granularity (see [`Accuracy`]).
+    ///
+    /// Machines that only support cycle interleaving ignore this.
+    /// Default: no-op.
+    fn set_accuracy(&mut self, _accuracy: Accuracy) {}
+
     /// Enable or disable internal sub-span profiling.
     ///
     /// Machines that support fine-grained timing should start/stop capturing
@@ -296,3 +495,49 @@ pub trait Machine: Renderable + AudioSource + InputReceiver + MachineDebug {
         &[]
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const TIMING: TimingConfig = TimingConfig {
+        cpu_clock_hz: 1_000_000,
+        cycles_per_scanline: 64,
+        total_scanlines: 260,
+        display_width: 292,
+        display_height: 240,
+    };
+
+    #[test]
+    fn beam_tracks_modulo_arithmetic() {
+        let mut beam = BeamPosition::new();
+        for clock in 0..3 * TIMING.cycles_per_frame() {
+            let frame_cycle = clock % TIMING.cycles_per_frame();
+            assert_eq!(beam.frame_cycle(&TIMING), frame_cycle);
+            assert_eq!(beam.scanline(), frame_cycle / TIMING.cycles_per_scanline);
+            assert_eq!(
+                beam.at_line_start(),
+                frame_cycle.is_multiple_of(TIMING.cycles_per_scanline)
+            );
+            let new_line = beam.step(&TIMING);
+            assert_eq!(new_line, beam.at_line_start());
+        }
+    }
+
+    #[test]
+    fn beam_event_queries() {
+        let mut beam = BeamPosition::at_clock(&TIMING, 239 * 64 + 10);
+        assert_eq!(beam.cycles_until_next_scanline(&TIMING), 54);
+        assert_eq!(beam.cycles_until_scanline(&TIMING, 240), 54);
+        // Line 0 of the next frame: rest of line 239 plus lines 240-259
+        assert_eq!(beam.cycles_until_scanline(&TIMING, 0), 54 + 20 * 64);
+
+        beam.advance(&TIMING, 54);
+        assert_eq!(beam.scanline(), 240);
+        assert!(beam.at_line_start());
+        assert_eq!(
+            beam.cycles_until_scanline(&TIMING, 240),
+            TIMING.cycles_per_frame()
+        );
+    }
+}
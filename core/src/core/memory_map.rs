@@ -112,6 +112,12 @@ pub struct MemoryMap {
     region_backing: [u32; 256],
     /// Byte length of each region's backing.
     region_lengths: [u32; 256],
+    /// Access characteristics of each region_id (for code-cacheability queries).
+    region_access: [AccessKind; 256],
+
+    /// Bumped whenever the page table or read-only backing changes, so
+    /// predecode caches keyed on it drop stale entries (see `code_generation`).
+    generation: u32,
 
     active_watch_count: u16,
     pending_hit: Option<WatchpointHit>,
@@ -129,6 +135,8 @@ impl MemoryMap {
             backing: Vec::new(),
             region_backing: [u32::MAX; 256],
             region_lengths: [0; 256],
+            region_access: [AccessKind::Unmapped; 256],
+            generation: 0,
             active_watch_count: 0,
             pending_hit: None,
             watched_addrs: Vec::new(),
@@ -190,6 +198,8 @@ impl MemoryMap {
             end_addr,
             access,
         });
+        self.region_access[id as usize] = access;
+        self.generation = self.generation.wrapping_add(1);
 
         // Allocate backing memory for non-I/O regions
         if matches!(
@@ -229,6 +239,8 @@ impl MemoryMap {
             end_addr: 0,
             access: AccessKind::ReadOnly,
         });
+        self.region_access[id as usize] = AccessKind::ReadOnly;
+        self.generation = self.generation.wrapping_add(1);
 
         self
     }
@@ -254,12 +266,14 @@ impl MemoryMap {
                 };
             }
         }
+        self.generation = self.generation.wrapping_add(1);
         self
     }
 
     /// Remap a range of pages to a different region (for bank switching).
     ///
-    /// Called at runtime when a bank register is written.
+    /// Called at runtime when a bank register is written. Bumps the mapping
+    /// generation, invalidating any predecoded instructions.
     pub fn remap_pages(
         &mut self,
         start_page: u8,
@@ -275,6 +289,7 @@ impl MemoryMap {
                 self.pages[idx].base_offset = new_base_offset + (i as u16) * 256;
             }
         }
+        self.generation = self.generation.wrapping_add(1);
     }
 
     // -----------------------------------------------------------------------
@@ -318,11 +333,14 @@ impl MemoryMap {
     /// Side-effect-free write to backing memory. No-op for I/O and unmapped regions.
     #[inline]
     pub fn debug_write(&mut self, addr: u16, data: u8) {
-        let page = self.page(addr);
+        let page = *self.page(addr);
         let backing_offset = self.region_backing[page.region_id as usize];
         if backing_offset == u32::MAX {
             return;
         }
+        if self.region_access[page.region_id as usize] == AccessKind::ReadOnly {
+            self.generation = self.generation.wrapping_add(1);
+        }
         let byte_offset =
             backing_offset as usize + page.base_offset as usize + (addr as usize & 0xFF);
         self.backing[byte_offset] = data;
@@ -383,9 +401,14 @@ impl MemoryMap {
 
     /// Get a mutable slice of a region's backing store.
     ///
-    /// Panics if the region has no backing (I/O or unregistered).
+    /// Mutable access to a read-only region (ROM loading, decryption) bumps
+    /// the mapping generation. Panics if the region has no backing (I/O or
+    /// unregistered).
     pub fn region_data_mut(&mut self, region_id: impl Into<RegionId>) -> &mut [u8] {
         let region_id = region_id.into();
+        if self.region_access[region_id as usize] == AccessKind::ReadOnly {
+            self.generation = self.generation.wrapping_add(1);
+        }
         let offset = self.region_backing[region_id as usize];
         debug_assert!(
             offset != u32::MAX,
@@ -422,6 +445,107 @@ impl MemoryMap {
         dest[offset..end].copy_from_slice(&data[..len]);
     }
 
+    // -----------------------------------------------------------------------
+    // Code cacheability
+    // -----------------------------------------------------------------------
+
+    /// Current mapping generation.
+    ///
+    /// Bumped by every page-table change (`region`, `mirror`, `remap_pages`)
+    /// and by every mutable access to a read-only region's backing.
+    #[inline]
+    pub fn generation(&self) -> u32 {
+        self.generation
+    }
+
+    /// Return the mapping generation if `addr` lies in immutable memory.
+    ///
+    /// A byte on a `ReadOnly` page can only change through a bank switch or
+    /// a ROM reload, both of which bump the generation. CPUs use this to
+    /// keep predecoded instructions keyed by PC: an entry tagged with the
+    /// returned value stays valid until the generation moves. Returns `None`
+    /// for RAM, I/O, unmapped pages, and while any watchpoint is active (so
+    /// instruction fetches keep reaching `check_read_watch`).
+    #[inline]
+    pub fn code_generation(&self, addr: u16) -> Option<u32> {
+        if self.active_watch_count != 0 {
+            return None;
+        }
+        let id = self.page(addr).region_id as usize;
+        if self.region_access[id] == AccessKind::ReadOnly && self.region_backing[id] != u32::MAX {
+            Some(self.generation)
+        } else {
+            None
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Block transfers
+    // -----------------------------------------------------------------------
+
+    /// Copy `len` bytes between backed regions on behalf of a block-move
+    /// instruction (Z80 LDIR/LDDR, 8088 REP MOVS/STOS).
+    ///
+    /// Byte `i` moves from `src + i` to `dst + i` (`- i` when `descending`)
+    /// one at a time in order, so overlapping ranges replicate exactly as
+    /// the CPU loop would (the `LDIR` fill idiom). Returns `false` without
+    /// touching memory if either range wraps the 64K space, a source page
+    /// has no backing, a destination page is not backed `ReadWrite`, or any
+    /// watchpoint is active. Callers must only forward ranges their
+    /// `Bus::read`/`write` serve straight from backing.
+    pub fn block_copy(&mut self, src: u16, dst: u16, len: u32, descending: bool) -> bool {
+        if len == 0 {
+            return true;
+        }
+        if self.active_watch_count != 0 || len > 0x1_0000 {
+            return false;
+        }
+        let span = (len - 1) as u16;
+        let (src_lo, dst_lo) = if descending {
+            if (src as u32) < len - 1 || (dst as u32) < len - 1 {
+                return false;
+            }
+            (src - span, dst - span)
+        } else {
+            if src as u32 + len > 0x1_0000 || dst as u32 + len > 0x1_0000 {
+                return false;
+            }
+            (src, dst)
+        };
+        if !self.range_backed(src_lo, span, AccessKind::ReadOnly)
+            || !self.range_backed(dst_lo, span, AccessKind::ReadWrite)
+        {
+            return false;
+        }
+
+        for i in 0..=span {
+            let (s, d) = if descending {
+                (src - i, dst - i)
+            } else {
+                (src + i, dst + i)
+            };
+            let data = self.read_backing(s);
+            self.write_backing(d, data);
+        }
+        true
+    }
+
+    /// True if every page in `start..=start + span` has backing that allows
+    /// `need` (`ReadOnly` accepts read-only or read-write regions).
+    fn range_backed(&self, start: u16, span: u16, need: AccessKind) -> bool {
+        let first = (start >> 8) as usize;
+        let last = ((start + span) >> 8) as usize;
+        self.pages[first..=last].iter().all(|page| {
+            let id = page.region_id as usize;
+            self.region_backing[id] != u32::MAX
+                && match self.region_access[id] {
+                    AccessKind::ReadWrite => true,
+                    AccessKind::ReadOnly => need == AccessKind::ReadOnly,
+                    _ => false,
+                }
+        })
+    }
+
     // -----------------------------------------------------------------------
     // Watchpoint methods
     // -----------------------------------------------------------------------
@@ -1095,4 +1219,76 @@ mod tests {
         assert_eq!(map.debug_read(0x0000), Some(0x11));
         assert_eq!(map.debug_read(0xD000), Some(0x22));
     }
+
+    #[test]
+    fn code_generation_tracks_immutable_pages() {
+        const BANK: RegionId = 5;
+
+        let mut map = MemoryMap::new();
+        map.region(RAM, "RAM", 0x0000, 0x8000, AccessKind::ReadWrite)
+            .region(ROM, "ROM", 0x8000, 0x4000, AccessKind::ReadOnly)
+            .region(IO, "IO", 0xC000, 0x0100, AccessKind::Io)
+            .backing_region(BANK, "Bank", 0x4000);
+
+        let generation = map.generation();
+        assert_eq!(map.code_generation(0x8000), Some(generation));
+        assert_eq!(map.code_generation(0x0000), None);
+        assert_eq!(map.code_generation(0xC000), None);
+        assert_eq!(map.code_generation(0xF000), None);
+
+        // Bank switch moves the generation; banked ROM stays cacheable
+        map.remap_pages(0x80, 0x40, BANK, 0);
+        assert_ne!(map.generation(), generation);
+        assert_eq!(map.code_generation(0x8000), Some(map.generation()));
+
+        // Rewriting ROM contents also moves it
+        let generation = map.generation();
+        map.region_data_mut(BANK)[0] = 0x12;
+        assert_ne!(map.generation(), generation);
+
+        // RAM writes do not
+        let generation = map.generation();
+        map.write_backing(0x0010, 0x34);
+        map.region_data_mut(RAM)[0] = 0x56;
+        assert_eq!(map.generation(), generation);
+
+        // Watchpoints disable caching so fetches keep reaching the bus
+        map.set_watchpoint(0x8000, WatchpointKind::Read);
+        assert_eq!(map.code_generation(0x8000), None);
+        map.clear_all_watchpoints();
+        assert_eq!(map.code_generation(0x8000), Some(generation));
+    }
+
+    #[test]
+    fn block_copy_replicates_per_byte_order() {
+        let mut map = MemoryMap::new();
+        map.region(RAM, "RAM", 0x0000, 0x8000, AccessKind::ReadWrite)
+            .region(ROM, "ROM", 0x8000, 0x4000, AccessKind::ReadOnly)
+            .region(IO, "IO", 0xC000, 0x0100, AccessKind::Io);
+        map.region_data_mut(ROM)[..4].copy_from_slice(&[1, 2, 3, 4]);
+
+        // ROM → RAM across a page boundary
+        assert!(map.block_copy(0x8000, 0x00FE, 4, false));
+        assert_eq!(map.debug_read(0x00FE), Some(1));
+        assert_eq!(map.debug_read(0x0101), Some(4));
+
+        // Overlapping ascending copy fills (dst = src + 1)
+        map.write_backing(0x1000, 0xAA);
+        assert!(map.block_copy(0x1000, 0x1001, 0x200, false));
+        assert!((0x1000..=0x1200).all(|a| map.debug_read(a) == Some(0xAA)));
+
+        // Descending copy walks down from the given addresses
+        assert!(map.block_copy(0x0101, 0x2003, 4, true));
+        assert_eq!(map.debug_read(0x2000), Some(1));
+        assert_eq!(map.debug_read(0x2003), Some(4));
+
+        // Rejected: writes to ROM, I/O sources, wraparound, watchpoints
+        assert!(!map.block_copy(0x0000, 0x8000, 1, false));
+        assert!(!map.block_copy(0xC000, 0x0000, 1, false));
+        assert!(!map.block_copy(0xFFFF, 0x0000, 2, false));
+        assert!(!map.block_copy(0x0001, 0x2000, 3, true));
+        map.set_watchpoint(0x4000, WatchpointKind::Write);
+        assert!(!map.block_copy(0x0000, 0x1000, 1, false));
+        assert_eq!(map.debug_read(0x1000), Some(0xAA));
+    }
 }
@@ -1,18 +1,28 @@
+pub mod batch;
 pub mod bus;
 pub mod clock;
 pub mod component;
 pub mod debug;
+pub mod lz;
 pub mod machine;
 pub mod memory_map;
+pub mod movie;
+pub mod rewind;
 pub mod save_state;
+pub mod state_hash;
 
+pub use batch::{MachineBatch, RamView};
 pub use bus::{Bus, BusMaster, InterruptState};
 pub use clock::ClockDivider;
 pub use component::BusMasterComponent;
 pub use debug::{BusDebug, DebugCpu, DebugDisassembly, DebugRegister, Debuggable};
 pub use machine::{
-    AnalogInput, AudioSource, InputButton, InputReceiver, Machine, MachineDebug, Renderable,
-    TimingConfig,
+    Accuracy, AnalogInput, AudioSource, BeamPosition, InputButton, InputReceiver, Machine,
+    MachineDebug, Renderable, TimingConfig,
 };
 pub use memory_map::{MemoryMap, WatchpointHit, WatchpointKind};
-pub use save_state::{SaveError, Saveable, StateReader, StateWriter, load_machine, save_machine};
+pub use movie::{Movie, MoviePlayer, MovieRecorder};
+pub use rewind::RewindBuffer;
+pub use save_state::{
+    SaveError, Saveable, StateReader, StateWriter, load_machine, save_machine, save_machine_into,
+};
@@ -0,0 +1,348 @@
+//! Input movies: deterministic recording and replay of a session.
+//!
+//! A [`Movie`] is the machine's state at the start of recording plus every
+//! `set_input`/`set_analog` call, stamped with the frame it was delivered
+//! before. Front-ends latch input between frames, so the frame number is
+//! the exact point the machine saw the event, and replaying the log from
+//! the start state reproduces the session bit for bit.
+//!
+//! Every `keyframe_interval` frames the recorder also stores a compressed
+//! save state. [`MoviePlayer::seek`] loads the nearest keyframe at or before
+//! the target and fast-forwards from there, so a seek costs at most one
+//! keyframe interval of emulation no matter where it lands.
+//!
+//! Save states are lossless, including each CPU's progress through its
+//! current instruction, so a machine restored from a keyframe continues
+//! exactly as the original did. Taking a keyframe is a plain save that
+//! leaves the session untouched, and playback only loads one to start or
+//! seek.
+
+use super::machine::Machine;
+use super::save_state::{self, SaveError, StateReader, StateWriter};
+
+/// Magic bytes at the start of every movie file.
+pub const MOVIE_MAGIC: &[u8; 4] = b"PHMV";
+
+/// Current movie format version.
+pub const MOVIE_VERSION: u32 = 1;
+
+/// Default frames between keyframes (one second at 60 Hz).
+pub const DEFAULT_KEYFRAME_INTERVAL: u64 = 60;
+
+/// One recorded input call.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum MovieInput {
+    Button { id: u8, pressed: bool },
+    Analog { axis: u8, delta: i32 },
+}
+
+impl MovieInput {
+    /// Deliver this input to `machine`.
+    pub fn apply(self, machine: &mut dyn Machine) {
+        match self {
+            MovieInput::Button { id, pressed } => machine.set_input(id, pressed),
+            MovieInput::Analog { axis, delta } => machine.set_analog(axis, delta),
+        }
+    }
+}
+
+/// An input delivered before frame `frame` ran (frames count from 0 at the
+/// start of recording).
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct MovieEvent {
+    pub frame: u64,
+    pub input: MovieInput,
+}
+
+/// Save state at the start of `frame`, packed with
+/// [`save_state::pack_state`] (no dictionary).
+struct Keyframe {
+    frame: u64,
+    state: Vec<u8>,
+}
+
+/// A recorded session: start state, input log and seek keyframes.
+pub struct Movie {
+    machine_id: String,
+    keyframe_interval: u64,
+    frames: u64,
+    events: Vec<MovieEvent>,
+    keyframes: Vec<Keyframe>,
+}
+
+impl Movie {
+    pub fn machine_id(&self) -> &str {
+        &self.machine_id
+    }
+
+    /// Number of recorded frames.
+    pub fn frames(&self) -> u64 {
+        self.frames
+    }
+
+    pub fn events(&self) -> &[MovieEvent] {
+        &self.events
+    }
+
+    /// Serialize for writing to disk.
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let size: usize = self.keyframes.iter().map(|k| 12 + k.state.len()).sum();
+        let mut w = StateWriter::with_capacity(64 + self.events.len() * 15 + size);
+        w.write_slice_le(MOVIE_MAGIC);
+        w.write_u32_le(MOVIE_VERSION);
+        w.write_bytes(self.machine_id.as_bytes());
+        w.write_u64_le(self.keyframe_interval);
+        w.write_u64_le(self.frames);
+
+        w.write_u32_le(self.events.len() as u32);
+        for e in &self.events {
+            w.write_u64_le(e.frame);
+            match e.input {
+                MovieInput::Button { id, pressed } => {
+                    w.write_u8(0);
+                    w.write_u8(id);
+                    w.write_bool(pressed);
+                }
+                MovieInput::Analog { axis, delta } => {
+                    w.write_u8(1);
+                    w.write_u8(axis);
+                    w.write_i32_le(delta);
+                }
+            }
+        }
+
+        w.write_u32_le(self.keyframes.len() as u32);
+        for k in &self.keyframes {
+            w.write_u64_le(k.frame);
+            w.write_bytes(&k.state);
+        }
+        w.into_vec()
+    }
+
+    /// Parse a movie written by [`to_bytes`](Self::to_bytes).
+    pub fn from_bytes(data: &[u8]) -> Result<Self, SaveError> {
+        let mut r = StateReader::new(data);
+        let mut magic = [0u8; 4];
+        r.read_slice_le_into(&mut magic)?;
+        if &magic != MOVIE_MAGIC {
+            return Err(SaveError::InvalidFormat("not a movie file".into()));
+        }
+        let version = r.read_u32_le()?;
+        if version != MOVIE_VERSION {
+            return Err(SaveError::InvalidFormat(format!(
+                "unsupported movie version {version}"
+            )));
+        }
+        let machine_id = std::str::from_utf8(r.read_bytes()?)
+            .map_err(|_| SaveError::InvalidFormat("non-UTF8 machine id".into()))?
+            .to_string();
+        let keyframe_interval = r.read_u64_le()?;
+        let frames = r.read_u64_le()?;
+
+        let n = r.read_u32_le()? as usize;
+        let mut events = Vec::with_capacity(n.min(data.len()));
+        for _ in 0..n {
+            let frame = r.read_u64_le()?;
+            let input = match r.read_u8()? {
+                0 => MovieInput::Button {
+                    id: r.read_u8()?,
+                    pressed: r.read_bool()?,
+                },
+                1 => MovieInput::Analog {
+                    axis: r.read_u8()?,
+                    delta: r.read_i32_le()?,
+                },
+                k => {
+                    return Err(SaveError::InvalidFormat(format!(
+                        "unknown movie event kind {k}"
+                    )));
+                }
+            };
+            events.push(MovieEvent { frame, input });
+        }
+
+        let n = r.read_u32_le()? as usize;
+        let mut keyframes = Vec::with_capacity(n.min(data.len()));
+        for _ in 0..n {
+            let frame = r.read_u64_le()?;
+            let state = r.read_bytes()?.to_vec();
+            keyframes.push(Keyframe { frame, state });
+        }
+        if keyframes.first().map(|k| k.frame) != Some(0) {
+            return Err(SaveError::InvalidFormat("movie has no start state".into()));
+        }
+
+        Ok(Self {
+            machine_id,
+            keyframe_interval,
+            frames,
+            events,
+            keyframes,
+        })
+    }
+}
+
+// -- Recording ---------------------------------------------------------------
+
+/// Builds a [`Movie`] while a machine runs.
+///
+/// Deliver input through [`button`](Self::button) / [`analog`](Self::analog)
+/// (which forward to the machine and log the call) and call
+/// [`end_frame`](Self::end_frame) after every `run_frame()`.
+pub struct MovieRecorder {
+    movie: Movie,
+}
+
+impl MovieRecorder {
+    /// Start recording from the machine's current state. Returns `None` if
+    /// the machine does not support save states.
+    pub fn new(machine: &dyn Machine, keyframe_interval: u64) -> Option<Self> {
+        let start = keyframe_state(machine)?;
+        Some(Self {
+            movie: Movie {
+                machine_id: machine.machine_id().to_string(),
+                keyframe_interval: keyframe_interval.max(1),
+                frames: 0,
+                events: Vec::new(),
+                keyframes: vec![Keyframe {
+                    frame: 0,
+                    state: start,
+                }],
+            },
+        })
+    }
+
+    /// Frames recorded so far.
+    pub fn frames(&self) -> u64 {
+        self.movie.frames
+    }
+
+    pub fn button(&mut self, machine: &mut dyn Machine, id: u8, pressed: bool) {
+        self.input(machine, MovieInput::Button { id, pressed });
+    }
+
+    pub fn analog(&mut self, machine: &mut dyn Machine, axis: u8, delta: i32) {
+        self.input(machine, MovieInput::Analog { axis, delta });
+    }
+
+    fn input(&mut self, machine: &mut dyn Machine, input: MovieInput) {
+        input.apply(machine);
+        self.movie.events.push(MovieEvent {
+            frame: self.movie.frames,
+            input,
+        });
+    }
+
+    /// Mark the end of a frame, storing a keyframe when one is due.
+    pub fn end_frame(&mut self, machine: &dyn Machine) {
+        self.movie.frames += 1;
+        if self
+            .movie
+            .frames
+            .is_multiple_of(self.movie.keyframe_interval)
+            && let Some(state) = keyframe_state(machine)
+        {
+            self.movie.keyframes.push(Keyframe {
+                frame: self.movie.frames,
+                state,
+            });
+        }
+    }
+
+    pub fn finish(self) -> Movie {
+        self.movie
+    }
+}
+
+/// The machine's current state, packed as a keyframe.
+fn keyframe_state(machine: &dyn Machine) -> Option<Vec<u8>> {
+    let raw = machine.save_state()?;
+    Some(save_state::pack_state(&raw, &[]))
+}
+
+// -- Playback ----------------------------------------------------------------
+
+/// Replays a [`Movie`] into a machine.
+pub struct MoviePlayer {
+    movie: Movie,
+    frame: u64,
+    next_event: usize,
+    audio_scratch: Vec<i16>,
+}
+
+impl MoviePlayer {
+    /// Load the movie's start state into `machine`, ready to play frame 0.
+    pub fn new(movie: Movie, machine: &mut dyn Machine) -> Result<Self, SaveError> {
+        if movie.machine_id != machine.machine_id() {
+            return Err(SaveError::MachineMismatch {
+                expected: machine.machine_id().to_string(),
+                found: movie.machine_id.clone(),
+            });
+        }
+        let mut player = Self {
+            movie,
+            frame: 0,
+            next_event: 0,
+            audio_scratch: vec![0; 4096],
+        };
+        player.load_keyframe(0, machine)?;
+        Ok(player)
+    }
+
+    pub fn movie(&self) -> &Movie {
+        &self.movie
+    }
+
+    /// Next frame to be played.
+    pub fn frame(&self) -> u64 {
+        self.frame
+    }
+
+    pub fn is_finished(&self) -> bool {
+        self.frame >= self.movie.frames
+    }
+
+    /// Deliver this frame's input and run it. The caller drains audio and
+    /// renders as usual. Returns `false` once the movie has ended.
+    pub fn step(&mut self, machine: &mut dyn Machine) -> bool {
+        if self.is_finished() {
+            return false;
+        }
+        let events = &self.movie.events;
+        while let Some(e) = events.get(self.next_event)
+            && e.frame == self.frame
+        {
+            e.input.apply(machine);
+            self.next_event += 1;
+        }
+        machine.run_frame();
+        self.frame += 1;
+        true
+    }
+
+    /// Put the machine in its state at the start of `frame`: load the
+    /// nearest keyframe at or before it, then fast-forward. Skipped frames
+    /// are neither rendered nor played; their audio is discarded.
+    pub fn seek(&mut self, machine: &mut dyn Machine, frame: u64) -> Result<(), SaveError> {
+        let frame = frame.min(self.movie.frames);
+        // Resume from the current position when it is closer than a keyframe
+        let key = self.movie.keyframes.partition_point(|k| k.frame <= frame) - 1;
+        if !(self.movie.keyframes[key].frame <= self.frame && self.frame <= frame) {
+            self.load_keyframe(key, machine)?;
+        }
+        while self.frame < frame {
+            self.step(machine);
+            machine.fill_audio(&mut self.audio_scratch);
+        }
+        Ok(())
+    }
+
+    fn load_keyframe(&mut self, index: usize, machine: &mut dyn Machine) -> Result<(), SaveError> {
+        let key = &self.movie.keyframes[index];
+        let state = save_state::unpack_state(&key.state, &[])?;
+        machine.load_state(&state)?;
+        self.frame = key.frame;
+        self.next_event = self.movie.events.partition_point(|e| e.frame < key.frame);
+        Ok(())
+    }
+}
@@ -0,0 +1,338 @@
+//! Rewind history built from per-frame save states.
+//!
+//! Full snapshots are too large to keep for every frame, but consecutive
+//! frames differ in only a few hundred bytes (RAM, CPU registers, a handful
+//! of device fields). [`RewindBuffer`] stores every Nth state whole as a
+//! *keyframe* and the states in between as run-length deltas against that
+//! keyframe. Deltas are keyframe-relative rather than chained, so any state
+//! is rebuilt with one copy plus one patch, and stepping backward costs the
+//! same no matter how far back the history goes.
+//!
+//! Memory is capped by a byte budget; when it is exceeded the oldest
+//! keyframe is dropped together with all the deltas that depend on it.
+
+use std::collections::VecDeque;
+
+/// Default number of states per keyframe group.
+pub const DEFAULT_KEYFRAME_INTERVAL: usize = 60;
+
+/// Changed-byte runs separated by fewer equal bytes than this are merged,
+/// since a new run header costs about as much as the bytes it would skip.
+const MERGE_GAP: usize = 8;
+
+/// A keyframe and the deltas encoded against it, oldest first.
+struct Group {
+    key: Vec<u8>,
+    deltas: Vec<Vec<u8>>,
+}
+
+impl Group {
+    fn bytes(&self) -> usize {
+        self.key.len() + self.deltas.iter().map(Vec::len).sum::<usize>()
+    }
+}
+
+/// Ring of save states for stepping a machine backward in time.
+///
+/// Push the machine's state once per frame with [`push`](Self::push);
+/// [`pop`](Self::pop) returns the most recent state and removes it, so
+/// repeated pops walk backward one frame at a time.
+pub struct RewindBuffer {
+    budget: usize,
+    keyframe_interval: usize,
+    groups: VecDeque<Group>,
+    used: usize,
+    scratch: Vec<u8>,
+}
+
+impl RewindBuffer {
+    /// Create a buffer that keeps at most `budget` bytes of encoded states.
+    pub fn new(budget: usize) -> Self {
+        Self::with_keyframe_interval(budget, DEFAULT_KEYFRAME_INTERVAL)
+    }
+
+    /// Create a buffer that starts a new keyframe every `interval` states.
+    pub fn with_keyframe_interval(budget: usize, interval: usize) -> Self {
+        Self {
+            budget,
+            keyframe_interval: interval.max(1),
+            groups: VecDeque::new(),
+            used: 0,
+            scratch: Vec::new(),
+        }
+    }
+
+    /// Number of states that can be popped.
+    pub fn len(&self) -> usize {
+        self.groups.iter().map(|g| 1 + g.deltas.len()).sum()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.groups.is_empty()
+    }
+
+    /// Bytes of encoded state currently held.
+    pub fn memory_used(&self) -> usize {
+        self.used
+    }
+
+    pub fn clear(&mut self) {
+        self.groups.clear();
+        self.used = 0;
+    }
+
+    /// Record `state` as the newest entry, evicting the oldest keyframe
+    /// groups if the budget is exceeded. The newest group is always kept.
+    pub fn push(&mut self, state: &[u8]) {
+        let delta = match self.groups.back() {
+            Some(g)
+                if g.deltas.len() + 1 < self.keyframe_interval && g.key.len() == state.len() =>
+            {
+                encode_delta(&g.key, state, &mut self.scratch);
+                // A delta bigger than half a keyframe saves little and makes
+                // every later delta in the group diverge further.
+                self.scratch.len() <= state.len() / 2
+            }
+            _ => false,
+        };
+
+        if delta {
+            self.used += self.scratch.len();
+            let g = self.groups.back_mut().expect("delta needs a keyframe");
+            g.deltas.push(self.scratch.clone());
+        } else {
+            self.used += state.len();
+            self.groups.push_back(Group {
+                key: state.to_vec(),
+                deltas: Vec::new(),
+            });
+        }
+
+        while self.used > self.budget && self.groups.len() > 1 {
+            let old = self.groups.pop_front().expect("len > 1");
+            self.used -= old.bytes();
+        }
+    }
+
+    /// Remove the newest state and write it to `out`.
+    /// Returns `false` when the history is empty.
+    pub fn pop(&mut self, out: &mut Vec<u8>) -> bool {
+        let Some(g) = self.groups.back_mut() else {
+            return false;
+        };
+        match g.deltas.pop() {
+            Some(delta) => {
+                self.used -= delta.len();
+                out.clear();
+                out.extend_from_slice(&g.key);
+                apply_delta(&delta, out);
+            }
+            None => {
+                let g = self.groups.pop_back().expect("back exists");
+                self.used -= g.key.len();
+                *out = g.key;
+            }
+        }
+        true
+    }
+}
+
+// -- Delta encoding ----------------------------------------------------------
+//
+// A delta is a sequence of records `skip, len, bytes[len]`, with `skip` and
+// `len` as LEB128 varints: leave `skip` bytes of the keyframe as they are,
+// then overwrite the next `len` bytes with the literal ones.
+
+/// Encode `state` against `key` (same length) into `out`.
+fn encode_delta(key: &[u8], state: &[u8], out: &mut Vec<u8>) {
+    debug_assert_eq!(key.len(), state.len());
+    out.clear();
+    let n = state.len();
+    let mut pos = 0; // end of the last emitted run
+    let mut i = 0;
+    while i < n {
+        // Skip unchanged bytes, a word at a time where possible
+        while i + 8 <= n && word(key, i) == word(state, i) {
+            i += 8;
+        }
+        while i < n && key[i] == state[i] {
+            i += 1;
+        }
+        if i == n {
+            break;
+        }
+
+        // Extend the changed run across short equal gaps
+        let start = i;
+        let mut end;
+        loop {
+            while i < n && key[i] != state[i] {
+                i += 1;
+            }
+            end = i;
+            let mut j = i;
+            while j < n && j - i < MERGE_GAP && key[j] == state[j] {
+                j += 1;
+            }
+            if j < n && j - i < MERGE_GAP {
+                i = j;
+            } else {
+                break;
+            }
+        }
+
+        write_varint(out, start - pos);
+        write_varint(out, end - start);
+        out.extend_from_slice(&state[start..end]);
+        pos = end;
+        i = end;
+    }
+}
+
+/// Patch `out` (a copy of the keyframe) with `delta`.
+fn apply_delta(delta: &[u8], out: &mut [u8]) {
+    let mut r = 0;
+    let mut pos = 0;
+    while r < delta.len() {
+        pos += read_varint(delta, &mut r);
+        let len = read_varint(delta, &mut r);
+        out[pos..pos + len].copy_from_slice(&delta[r..r + len]);
+        r += len;
+        pos += len;
+    }
+}
+
+#[inline]
+fn word(bytes: &[u8], i: usize) -> u64 {
+    u64::from_ne_bytes(bytes[i..i + 8].try_into().unwrap())
+}
+
+fn write_varint(out: &mut Vec<u8>, mut v: usize) {
+    while v >= 0x80 {
+        out.push(v as u8 | 0x80);
+        v >>= 7;
+    }
+    out.push(v as u8);
+}
+
+fn read_varint(data: &[u8], r: &mut usize) -> usize {
+    let mut v = 0;
+    let mut shift = 0;
+    loop {
+        let b = data[*r];
+        *r += 1;
+        v |= ((b & 0x7F) as usize) << shift;
+        if b & 0x80 == 0 {
+            return v;
+        }
+        shift += 7;
+    }
+}
+
+// -- Tests -------------------------------------------------------------------
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Deterministic "machine state" for frame `f`: a mostly static blob
+    /// with a few fields that change every frame.
+    fn state_for_frame(f: usize) -> Vec<u8> {
+        let mut s: Vec<u8> = (0..4096).map(|i| (i * 7) as u8).collect();
+        s[10] = f as u8;
+        s[11] = (f >> 8) as u8;
+        for k in 0..(f % 5) {
+            s[1000 + k * 97] = (f + k) as u8;
+        }
+        s[4095] = !(f as u8);
+        s
+    }
+
+    #[test]
+    fn delta_round_trip() {
+        let key = state_for_frame(0);
+        let mut state = state_for_frame(123);
+        state[0] ^= 0xFF;
+        state[2000..2040].fill(0xEE);
+
+        let mut delta = Vec::new();
+        encode_delta(&key, &state, &mut delta);
+        assert!(delta.len() < 100);
+
+        let mut out = key.clone();
+        apply_delta(&delta, &mut out);
+        assert_eq!(out, state);
+    }
+
+    #[test]
+    fn identical_state_encodes_empty() {
+        let key = state_for_frame(5);
+        let mut delta = vec![1, 2, 3];
+        encode_delta(&key, &key, &mut delta);
+        assert!(delta.is_empty());
+    }
+
+    #[test]
+    fn pops_states_newest_first() {
+        let mut rb = RewindBuffer::with_keyframe_interval(usize::MAX, 16);
+        for f in 0..100 {
+            rb.push(&state_for_frame(f));
+        }
+        assert_eq!(rb.len(), 100);
+
+        let mut out = Vec::new();
+        for f in (0..100).rev() {
+            assert!(rb.pop(&mut out));
+            assert_eq!(out, state_for_frame(f), "frame {f}");
+        }
+        assert!(!rb.pop(&mut out));
+        assert!(rb.is_empty());
+        assert_eq!(rb.memory_used(), 0);
+    }
+
+    #[test]
+    fn deltas_are_much_smaller_than_keyframes() {
+        let mut rb = RewindBuffer::with_keyframe_interval(usize::MAX, 60);
+        for f in 0..60 {
+            rb.push(&state_for_frame(f));
+        }
+        // One keyframe plus 59 small deltas
+        assert!(rb.memory_used() < 4096 + 59 * 64);
+    }
+
+    #[test]
+    fn budget_evicts_oldest_groups() {
+        let budget = 3 * 4096;
+        let mut rb = RewindBuffer::with_keyframe_interval(budget, 10);
+        for f in 0..200 {
+            rb.push(&state_for_frame(f));
+            assert!(rb.memory_used() <= budget);
+        }
+
+        // The surviving history is the most recent frames, contiguous
+        let n = rb.len();
+        assert!(n >= 10);
+        let mut out = Vec::new();
+        for f in (200 - n..200).rev() {
+            assert!(rb.pop(&mut out));
+            assert_eq!(out, state_for_frame(f));
+        }
+    }
+
+    #[test]
+    fn size_change_starts_new_keyframe() {
+        let mut rb = RewindBuffer::new(usize::MAX);
+        rb.push(&state_for_frame(1));
+        let longer = vec![0xAB; 5000];
+        rb.push(&longer);
+        rb.push(&state_for_frame(2));
+
+        let mut out = Vec::new();
+        assert!(rb.pop(&mut out));
+        assert_eq!(out, state_for_frame(2));
+        assert!(rb.pop(&mut out));
+        assert_eq!(out, longer);
+        assert!(rb.pop(&mut out));
+        assert_eq!(out, state_for_frame(1));
+    }
+}
@@ -5,6 +5,15 @@
 //! multi-byte values are stored in little-endian order so save files are
 //! portable across architectures. Each component that participates in save
 //! states implements the [`Saveable`] trait.
+//!
+//! Save files on disk may be *packed* with [`pack_state`]: the same header
+//! magic, a version word with [`PACKED_FLAG`] set, and the raw state
+//! compressed with the [`lz`](super::lz) codec against the machine's ROM set.
+//! [`unpack_state`] accepts packed and raw files alike.
+
+use std::borrow::Cow;
+
+use super::lz;
 
 /// Errors that can occur during save-state operations.
 #[derive(Debug)]
@@ -37,12 +46,65 @@ pub const SAVE_MAGIC: &[u8; 4] = b"PHOS";
 /// Current save-state format version.
 pub const SAVE_VERSION: u32 = 3;
 
+/// Set in the version word of a packed save file. The low bits still hold
+/// the [`SAVE_VERSION`] of the state inside.
+pub const PACKED_FLAG: u32 = 0x8000_0000;
+
 // -- Saveable trait ----------------------------------------------------------
 
 /// A component whose mutable state can be captured and restored.
 pub trait Saveable {
     fn save_state(&self, w: &mut StateWriter);
     fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError>;
+
+    /// Number of bytes `save_state` will write, used to size the output
+    /// buffer up front. Only a hint: an underestimate costs a reallocation,
+    /// never correctness. `#[derive(Saveable)]` computes it exactly.
+    /// Default: 0 (unknown).
+    fn state_size(&self) -> usize {
+        0
+    }
+}
+
+// -- Little-endian primitives ------------------------------------------------
+
+/// A primitive with a fixed-width little-endian encoding, for bulk slice
+/// I/O via [`StateWriter::write_slice_le`] and
+/// [`StateReader::read_slice_le_into`]. Slices encode exactly as the
+/// equivalent per-element `write_*` calls, with no length prefix.
+pub trait LePrimitive: Copy {
+    const SIZE: usize;
+    fn put_le(self, out: &mut Vec<u8>);
+    fn get_le(bytes: &[u8]) -> Self;
+}
+
+macro_rules! impl_le_primitive {
+    ($($t:ty),*) => {$(
+        impl LePrimitive for $t {
+            const SIZE: usize = std::mem::size_of::<$t>();
+            #[inline]
+            fn put_le(self, out: &mut Vec<u8>) {
+                out.extend_from_slice(&self.to_le_bytes());
+            }
+            #[inline]
+            fn get_le(bytes: &[u8]) -> Self {
+                <$t>::from_le_bytes(bytes.try_into().unwrap())
+            }
+        }
+    )*};
+}
+impl_le_primitive!(u8, u16, u32, u64, i16, i32, i64, f32, f64);
+
+impl LePrimitive for bool {
+    const SIZE: usize = 1;
+    #[inline]
+    fn put_le(self, out: &mut Vec<u8>) {
+        out.push(self as u8);
+    }
+    #[inline]
+    fn get_le(bytes: &[u8]) -> Self {
+        bytes[0] != 0
+    }
 }
 
 // -- StateWriter -------------------------------------------------------------
@@ -59,6 +121,28 @@ impl StateWriter {
         }
     }
 
+    pub fn with_capacity(capacity: usize) -> Self {
+        Self {
+            data: Vec::with_capacity(capacity),
+        }
+    }
+
+    /// Write into `buf`, discarding its contents but keeping its allocation.
+    /// Recover the buffer with [`into_vec`](Self::into_vec).
+    pub fn from_vec(mut buf: Vec<u8>) -> Self {
+        buf.clear();
+        Self { data: buf }
+    }
+
+    /// Bytes written so far.
+    pub fn len(&self) -> usize {
+        self.data.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.data.is_empty()
+    }
+
     pub fn write_u8(&mut self, v: u8) {
         self.data.push(v);
     }
@@ -105,6 +189,15 @@ impl StateWriter {
         self.data.extend_from_slice(bytes);
     }
 
+    /// Write every element of `values` in little-endian order, without a
+    /// length prefix. Same encoding as a `write_*` call per element.
+    pub fn write_slice_le<T: LePrimitive>(&mut self, values: &[T]) {
+        self.data.reserve(values.len() * T::SIZE);
+        for &v in values {
+            v.put_le(&mut self.data);
+        }
+    }
+
     /// Write a component version tag. Each `Saveable` implementation should
     /// call this first in `save_state()` so format changes can be detected.
     pub fn write_version(&mut self, version: u8) {
@@ -215,6 +308,19 @@ impl<'a> StateReader<'a> {
         Ok(())
     }
 
+    /// Fill `values` from data written by
+    /// [`StateWriter::write_slice_le`] (or per-element `write_*` calls).
+    pub fn read_slice_le_into<T: LePrimitive>(
+        &mut self,
+        values: &mut [T],
+    ) -> Result<(), SaveError> {
+        let bytes = self.take(values.len() * T::SIZE)?;
+        for (v, b) in values.iter_mut().zip(bytes.chunks_exact(T::SIZE)) {
+            *v = T::get_le(b);
+        }
+        Ok(())
+    }
+
     /// Read a length-prefixed byte blob, returning a borrowed slice.
     pub fn read_bytes(&mut self) -> Result<&'a [u8], SaveError> {
         let len = self.read_u32_le()? as usize;
@@ -236,6 +342,11 @@ impl<'a> StateReader<'a> {
 
 // -- Header helpers ----------------------------------------------------------
 
+/// Size in bytes of the header written by [`write_header`].
+pub fn header_size(machine_id: &str) -> usize {
+    SAVE_MAGIC.len() + 4 + 4 + machine_id.len()
+}
+
 /// Write the save-file header (magic + version + machine id).
 pub fn write_header(w: &mut StateWriter, machine_id: &str) {
     w.data.extend_from_slice(SAVE_MAGIC);
@@ -278,12 +389,93 @@ pub fn read_header<'a>(data: &'a [u8], expected_id: &str) -> Result<StateReader<
 
 /// Serialize a `Saveable` struct with the standard machine header.
 pub fn save_machine(saveable: &impl Saveable, machine_id: &str) -> Vec<u8> {
-    let mut w = StateWriter::new();
+    let mut w = StateWriter::with_capacity(header_size(machine_id) + saveable.state_size());
     write_header(&mut w, machine_id);
     saveable.save_state(&mut w);
     w.into_vec()
 }
 
+/// Like [`save_machine`], but writes into `buf` (replacing its contents)
+/// so a caller snapshotting every frame reuses one allocation.
+pub fn save_machine_into(saveable: &impl Saveable, machine_id: &str, buf: &mut Vec<u8>) {
+    let mut w = StateWriter::from_vec(std::mem::take(buf));
+    w.data
+        .reserve(header_size(machine_id) + saveable.state_size());
+    write_header(&mut w, machine_id);
+    saveable.save_state(&mut w);
+    *buf = w.into_vec();
+}
+
+// -- Packed save files -------------------------------------------------------
+//
+// Layout: magic, u32 version | PACKED_FLAG, u32 raw length, u64 dictionary
+// id (0 = no dictionary), then one LZ block holding the raw state.
+
+const PACKED_HEADER_LEN: usize = 4 + 4 + 4 + 8;
+
+/// Identify a compression dictionary so a file packed against one ROM set is
+/// not unpacked against another. FNV-1a over 8-byte words; never 0 for a
+/// non-empty dictionary.
+fn dictionary_id(dict: &[u8]) -> u64 {
+    if dict.is_empty() {
+        return 0;
+    }
+    let mut words = dict.chunks_exact(8);
+    let mut h = 0xCBF2_9CE4_8422_2325u64 ^ dict.len() as u64;
+    for w in &mut words {
+        h = (h ^ u64::from_le_bytes(w.try_into().unwrap())).wrapping_mul(0x0000_0100_0000_01B3);
+    }
+    for &b in words.remainder() {
+        h = (h ^ b as u64).wrapping_mul(0x0000_0100_0000_01B3);
+    }
+    h.max(1)
+}
+
+/// Compress a raw save state (as returned by `Machine::save_state`) for
+/// writing to disk. `dict` is normally the machine's ROM set
+/// (`RomSet::dictionary`); any RAM contents that repeat ROM data are stored
+/// as references into it. Pass an empty slice for a self-contained file.
+pub fn pack_state(raw: &[u8], dict: &[u8]) -> Vec<u8> {
+    let mut out = Vec::with_capacity(PACKED_HEADER_LEN + raw.len() / 4);
+    out.extend_from_slice(SAVE_MAGIC);
+    out.extend_from_slice(&(SAVE_VERSION | PACKED_FLAG).to_le_bytes());
+    out.extend_from_slice(&(raw.len() as u32).to_le_bytes());
+    out.extend_from_slice(&dictionary_id(dict).to_le_bytes());
+    lz::compress(raw, dict, &mut out);
+    out
+}
+
+/// Return the raw save state held in a save file: decompressed if the file
+/// was written by [`pack_state`] (with the same `dict`), or `data` itself
+/// for a raw file.
+pub fn unpack_state<'a>(data: &'a [u8], dict: &[u8]) -> Result<Cow<'a, [u8]>, SaveError> {
+    let mut r = StateReader::new(data);
+    if r.take(4).ok() != Some(SAVE_MAGIC.as_slice()) {
+        return Ok(Cow::Borrowed(data));
+    }
+    let version = r.read_u32_le()?;
+    if version & PACKED_FLAG == 0 {
+        return Ok(Cow::Borrowed(data));
+    }
+    if version & !PACKED_FLAG != SAVE_VERSION {
+        return Err(SaveError::InvalidFormat(format!(
+            "unsupported version {}",
+            version & !PACKED_FLAG
+        )));
+    }
+    let raw_len = r.read_u32_le()? as usize;
+    let id = r.read_u64_le()?;
+    if id != 0 && id != dictionary_id(dict) {
+        return Err(SaveError::InvalidFormat(
+            "packed against a different ROM set".into(),
+        ));
+    }
+    let dict = if id == 0 { &[][..] } else { dict };
+    lz::decompress(&data[PACKED_HEADER_LEN..], dict, raw_len)
+        .map(Cow::Owned)
+        .ok_or_else(|| SaveError::InvalidFormat("corrupt compressed data".into()))
+}
+
 /// Deserialize a `Saveable` struct, validating the machine header first.
 pub fn load_machine(
     saveable: &mut impl Saveable,
@@ -357,6 +549,118 @@ mod tests {
         assert!(r.read_bytes_into(&mut dst).is_err());
     }
 
+    #[test]
+    fn slice_le_matches_per_element_encoding() {
+        let words = [0x1234u16, 0xBEEF, 0x0001];
+        let flags = [true, false, true];
+        let floats = [1.5f64, -0.25];
+
+        let mut bulk = StateWriter::new();
+        bulk.write_slice_le(&words);
+        bulk.write_slice_le(&flags);
+        bulk.write_slice_le(&floats);
+
+        let mut each = StateWriter::new();
+        words.iter().for_each(|&v| each.write_u16_le(v));
+        flags.iter().for_each(|&v| each.write_bool(v));
+        floats.iter().for_each(|&v| each.write_f64_le(v));
+
+        let data = bulk.into_vec();
+        assert_eq!(data, each.into_vec());
+
+        let mut r = StateReader::new(&data);
+        let mut w2 = [0u16; 3];
+        let mut f2 = [false; 3];
+        let mut d2 = [0.0f64; 2];
+        r.read_slice_le_into(&mut w2).unwrap();
+        r.read_slice_le_into(&mut f2).unwrap();
+        r.read_slice_le_into(&mut d2).unwrap();
+        assert_eq!((w2, f2, d2), (words, flags, floats));
+        assert!(matches!(
+            r.read_slice_le_into(&mut [0u32; 1]),
+            Err(SaveError::UnexpectedEnd)
+        ));
+    }
+
+    #[derive(phosphor_macros::Saveable, Default, Debug, PartialEq)]
+    #[save_version(2)]
+    struct Inner {
+        flag: bool,
+        ram: [u8; 5],
+    }
+
+    #[derive(phosphor_macros::Saveable, Default, Debug, PartialEq)]
+    struct Outer {
+        a: u16,
+        counters: [u16; 3],
+        gains: [f32; 2],
+        #[save_elements]
+        regs: [u8; 4],
+        blob: Vec<u8>,
+        inner: Inner,
+        pair: [Inner; 2],
+        #[save_skip]
+        scratch: u32,
+    }
+
+    #[test]
+    fn derived_state_size_is_exact() {
+        let mut src = Outer {
+            a: 0x1234,
+            counters: [1, 0x200, 0xFFFF],
+            gains: [0.5, -2.0],
+            regs: [9, 8, 7, 6],
+            blob: vec![1, 2, 3],
+            scratch: 77,
+            ..Default::default()
+        };
+        src.inner.flag = true;
+        src.inner.ram = [5; 5];
+        src.pair[1].ram[4] = 0xAA;
+
+        let mut w = StateWriter::new();
+        src.save_state(&mut w);
+        let data = w.into_vec();
+        assert_eq!(data.len(), src.state_size());
+
+        let mut dst = Outer {
+            blob: vec![0; 64],
+            ..Default::default()
+        };
+        dst.load_state(&mut StateReader::new(&data)).unwrap();
+        dst.scratch = src.scratch;
+        assert_eq!(dst, src);
+    }
+
+    #[test]
+    fn save_machine_into_reuses_buffer() {
+        struct Blob([u8; 300]);
+        impl Saveable for Blob {
+            fn save_state(&self, w: &mut StateWriter) {
+                w.write_bytes(&self.0);
+            }
+            fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+                r.read_bytes_into(&mut self.0)
+            }
+            fn state_size(&self) -> usize {
+                4 + self.0.len()
+            }
+        }
+
+        let blob = Blob([0x5A; 300]);
+        let expected = save_machine(&blob, "blob");
+        assert_eq!(expected.len(), header_size("blob") + blob.state_size());
+        assert_eq!(expected.capacity(), expected.len());
+
+        let mut buf = vec![0xFF; 10];
+        save_machine_into(&blob, "blob", &mut buf);
+        assert_eq!(buf, expected);
+        let ptr = buf.as_ptr();
+        save_machine_into(&blob, "blob", &mut buf);
+        assert_eq!(buf, expected);
+        assert_eq!(buf.as_ptr(), ptr);
+    }
+
     #[test]
     fn reader_unexpected_end() {
         let mut r = StateReader::new(&[0x01]);
@@ -385,6 +689,39 @@ mod tests {
         assert!(matches!(err, SaveError::MachineMismatch { .. }));
     }
 
+    #[test]
+    fn packed_state_round_trip() {
+        let mut w = StateWriter::new();
+        write_header(&mut w, "joust");
+        w.write_bytes(&[0u8; 4096]);
+        w.write_bytes(b"high score table");
+        let raw = w.into_vec();
+        let rom = b"high score table and other rom bytes".repeat(4);
+
+        let packed = pack_state(&raw, &rom);
+        assert!(packed.len() < raw.len() / 10);
+        assert_eq!(unpack_state(&packed, &rom).unwrap(), raw.as_slice());
+
+        // Raw files pass through untouched
+        assert!(matches!(
+            unpack_state(&raw, &rom).unwrap(),
+            Cow::Borrowed(_)
+        ));
+
+        // Wrong ROM set, and a truncated file
+        assert!(unpack_state(&packed, b"other").is_err());
+        assert!(unpack_state(&packed[..packed.len() - 3], &rom).is_err());
+
+        // A corrupt length field is rejected, not allocated
+        let mut huge = packed.clone();
+        huge[8..12].copy_from_slice(&u32::MAX.to_le_bytes());
+        assert!(unpack_state(&huge, &rom).is_err());
+
+        // Without a dictionary the file unpacks against any ROM set
+        let plain = pack_state(&raw, &[]);
+        assert_eq!(unpack_state(&plain, b"other").unwrap(), raw.as_slice());
+    }
+
     #[test]
     fn header_bad_magic() {
         let data = b"BAD!\x02\x00\x00\x00\x05\x00\x00\x00joust";
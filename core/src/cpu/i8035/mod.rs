@@ -733,6 +733,8 @@ use crate::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
 
 const STATE_TAG_FETCH: u8 = 0;
 const STATE_TAG_STOPPED: u8 = 1;
+const STATE_TAG_EXECUTE: u8 = 2;
+const STATE_TAG_INTERRUPT: u8 = 3;
 
 impl I8035 {
     /// Returns true when the CPU is at a saveable instruction boundary.
@@ -772,7 +774,7 @@ impl DebugCpu for I8035 {
 
 impl Saveable for I8035 {
     fn save_state(&self, w: &mut StateWriter) {
-        w.write_version(1);
+        w.write_version(2);
         // Registers
         w.write_u8(self.a);
         w.write_u16_le(self.pc);
@@ -800,16 +802,21 @@ impl Saveable for I8035 {
         w.write_bool(self.in_interrupt);
         w.write_bool(self.irq_pending);
         w.write_bool(self.timer_irq_pending);
-        // ExecState tag
-        let tag = match self.state {
-            ExecState::Stopped => STATE_TAG_STOPPED,
-            _ => STATE_TAG_FETCH,
+        // ExecState tag, cycle, and the instruction in flight
+        let (tag, cycle) = match self.state {
+            ExecState::Fetch => (STATE_TAG_FETCH, 0),
+            ExecState::Stopped => (STATE_TAG_STOPPED, 0),
+            ExecState::Execute(cycle) => (STATE_TAG_EXECUTE, cycle),
+            ExecState::Interrupt(cycle) => (STATE_TAG_INTERRUPT, cycle),
         };
         w.write_u8(tag);
+        w.write_u8(cycle);
+        w.write_u8(self.opcode);
+        w.write_u8(self.temp_data);
     }
 
     fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
-        r.read_version(1)?;
+        r.read_version(2)?;
         self.a = r.read_u8()?;
         self.pc = r.read_u16_le()?;
         self.psw = r.read_u8()?;
@@ -839,13 +846,16 @@ impl Saveable for I8035 {
         self.irq_pending = r.read_bool()?;
         self.timer_irq_pending = r.read_bool()?;
         // ExecState
-        let tag = r.read_u8()?;
+        let (tag, cycle) = (r.read_u8()?, r.read_u8()?);
         self.state = match tag {
+            STATE_TAG_FETCH => ExecState::Fetch,
             STATE_TAG_STOPPED => ExecState::Stopped,
-            _ => ExecState::Fetch,
+            STATE_TAG_EXECUTE => ExecState::Execute(cycle),
+            STATE_TAG_INTERRUPT => ExecState::Interrupt(cycle),
+            n => return Err(SaveError::InvalidFormat(format!("I8035 exec state {n}"))),
         };
-        self.opcode = 0;
-        self.temp_data = 0;
+        self.opcode = r.read_u8()?;
+        self.temp_data = r.read_u8()?;
         Ok(())
     }
 }
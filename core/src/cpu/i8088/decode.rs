@@ -4,6 +4,7 @@
 //! byte parsing. The decoder consumes bytes from the instruction stream via
 //! the bus and produces decoded operand information used by the execute stage.
 
+use super::addressing::Operand;
 use super::registers::SegReg;
 use super::{I8088, RepPrefix};
 use crate::core::{Bus, BusMaster};
@@ -68,6 +69,144 @@ impl ModRM {
     }
 }
 
+/// A ModR/M byte together with its resolved r/m operand.
+///
+/// Produced by `I8088::fetch_operands` so handlers get both the reg field and
+/// the r/m location from one call. Register forms (mod == 11) resolve without
+/// any effective-address work, so handlers can match `Operand::Register` for
+/// a direct register-to-register path.
+#[derive(Copy, Clone, Debug, PartialEq)]
+pub(crate) struct DecodedModRM {
+    pub modrm: ModRM,
+    pub operand: Operand,
+}
+
+// ---------------------------------------------------------------------------
+// Predecode cache
+// ---------------------------------------------------------------------------
+
+/// Number of direct-mapped predecode entries (indexed by physical address).
+const DECODE_CACHE_ENTRIES: usize = 1024;
+
+/// Longest instruction (prefixes + opcode + operands) the cache will hold.
+/// Covers every 8088 encoding without redundant prefixes.
+const MAX_CACHED_LEN: usize = 8;
+
+/// One predecoded instruction from immutable code memory.
+///
+/// Holds the prefix state and opcode produced by `consume_prefixes`, plus
+/// the raw operand bytes (ModR/M, displacement, immediate) that execution
+/// fetches from the instruction stream. Tagged with CS:IP and the bus's
+/// code generation at the time it was recorded.
+#[derive(Copy, Clone, Debug)]
+pub(crate) struct DecodedInstruction {
+    cs: u16,
+    ip: u16,
+    generation: u32,
+    valid: bool,
+    segment_override: Option<SegReg>,
+    rep_prefix: Option<RepPrefix>,
+    opcode: u8,
+    /// Prefix count + 1 (bytes consumed before the operand stream).
+    opcode_len: u8,
+    /// Total instruction length in bytes.
+    len: u8,
+    bytes: [u8; MAX_CACHED_LEN],
+}
+
+impl DecodedInstruction {
+    const EMPTY: Self = Self {
+        cs: 0,
+        ip: 0,
+        generation: 0,
+        valid: false,
+        segment_override: None,
+        rep_prefix: None,
+        opcode: 0,
+        opcode_len: 0,
+        len: 0,
+        bytes: [0; MAX_CACHED_LEN],
+    };
+}
+
+/// Decoded-instruction cache keyed by CS:IP for ROM-resident code.
+///
+/// On a miss, every byte fetched through `fetch_byte` is recorded; if the
+/// whole instruction came from pages the bus reports as immutable (see
+/// [`Bus::code_generation`]), the entry is stored. On a hit, the prefix
+/// state and opcode are restored directly and the operand bytes are
+/// replayed from the entry instead of being re-read over the bus. Any
+/// bank switch or ROM reload moves the generation and retires the entry.
+pub(crate) struct DecodeCache {
+    entries: Box<[DecodedInstruction]>,
+    /// Operand bytes being replayed for the current instruction (hit).
+    replay: [u8; MAX_CACHED_LEN],
+    replay_pos: u8,
+    replay_len: u8,
+    /// Bytes fetched so far for the current instruction (miss).
+    record: [u8; MAX_CACHED_LEN],
+    record_len: u8,
+    record_generation: u32,
+    recording: bool,
+}
+
+impl DecodeCache {
+    pub(crate) fn new() -> Self {
+        Self {
+            entries: vec![DecodedInstruction::EMPTY; DECODE_CACHE_ENTRIES].into_boxed_slice(),
+            replay: [0; MAX_CACHED_LEN],
+            replay_pos: 0,
+            replay_len: 0,
+            record: [0; MAX_CACHED_LEN],
+            record_len: 0,
+            record_generation: 0,
+            recording: false,
+        }
+    }
+
+    /// Drop every cached instruction.
+    pub(crate) fn invalidate(&mut self) {
+        self.entries.fill(DecodedInstruction::EMPTY);
+    }
+
+    #[inline]
+    fn index(phys: u32) -> usize {
+        phys as usize & (DECODE_CACHE_ENTRIES - 1)
+    }
+
+    /// Next replayed operand byte, if the current instruction is a hit.
+    #[inline(always)]
+    fn next_replayed(&mut self) -> Option<u8> {
+        if self.replay_pos < self.replay_len {
+            let byte = self.replay[self.replay_pos as usize];
+            self.replay_pos += 1;
+            Some(byte)
+        } else {
+            None
+        }
+    }
+
+    /// Note a byte fetched over the bus while recording a miss. Instructions
+    /// longer than `MAX_CACHED_LEN` simply stop recording.
+    #[inline(always)]
+    fn note_fetched(&mut self, byte: u8) {
+        if self.recording {
+            if (self.record_len as usize) < MAX_CACHED_LEN {
+                self.record[self.record_len as usize] = byte;
+                self.record_len += 1;
+            } else {
+                self.recording = false;
+            }
+        }
+    }
+}
+
+impl Default for DecodeCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Bus fetch helpers on I8088
 // ---------------------------------------------------------------------------
@@ -80,8 +219,15 @@ impl I8088 {
         bus: &mut B,
         master: BusMaster,
     ) -> u8 {
-        let addr = Self::physical_addr(self.cs, self.ip);
-        let byte = bus.read(master, addr);
+        let byte = match self.decode_cache.next_replayed() {
+            Some(byte) => byte,
+            None => {
+                let addr = Self::physical_addr(self.cs, self.ip);
+                let byte = bus.read(master, addr);
+                self.decode_cache.note_fetched(byte);
+                byte
+            }
+        };
         self.ip = self.ip.wrapping_add(1);
         byte
     }
@@ -109,6 +255,115 @@ impl I8088 {
         ModRM::decode(byte)
     }
 
+    /// Fetch a ModR/M byte and resolve its r/m operand, fetching any
+    /// displacement. Register forms skip effective-address computation.
+    #[inline(always)]
+    pub(crate) fn fetch_operands<B: Bus<Address = u32, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+    ) -> DecodedModRM {
+        let modrm = self.fetch_modrm(bus, master);
+        let operand = if modrm.is_reg() {
+            Operand::Register(modrm.rm)
+        } else {
+            self.resolve_modrm(modrm, bus, master)
+        };
+        DecodedModRM { modrm, operand }
+    }
+
+    /// Fetch the next instruction's prefixes and opcode, through the
+    /// predecode cache when CS:IP lies in immutable code.
+    ///
+    /// On a hit, prefix state and opcode come from the cache and the operand
+    /// bytes are armed for replay by `fetch_byte`. On a miss, the bytes are
+    /// fetched over the bus and recorded; `retire_instruction` stores them
+    /// once execution has consumed the whole instruction.
+    pub(crate) fn fetch_instruction<B: Bus<Address = u32, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+    ) -> u8 {
+        let phys = Self::physical_addr(self.cs, self.ip);
+        let cache = &mut self.decode_cache;
+        cache.replay_len = 0;
+        cache.replay_pos = 0;
+        cache.record_len = 0;
+
+        let generation = bus.code_generation(master, phys);
+        let entry = &cache.entries[DecodeCache::index(phys)];
+        if entry.valid
+            && entry.cs == self.cs
+            && entry.ip == self.ip
+            && generation == Some(entry.generation)
+        {
+            let start = entry.opcode_len as usize;
+            let operands = entry.len as usize - start;
+            cache.replay[..operands].copy_from_slice(&entry.bytes[start..entry.len as usize]);
+            cache.replay_len = operands as u8;
+            cache.recording = false;
+            self.segment_override = entry.segment_override;
+            self.rep_prefix = entry.rep_prefix;
+            self.ip = self.ip.wrapping_add(entry.opcode_len as u16);
+            return entry.opcode;
+        }
+
+        cache.recording = generation.is_some();
+        cache.record_generation = generation.unwrap_or(0);
+        self.consume_prefixes(bus, master)
+    }
+
+    /// Store the instruction just executed if it was a recorded miss lying
+    /// entirely in immutable code. `cs`/`ip` are its starting address and
+    /// `opcode_len` the prefix count + 1 returned alongside the opcode.
+    pub(crate) fn retire_instruction<B: Bus<Address = u32, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+        cs: u16,
+        ip: u16,
+        opcode: u8,
+    ) {
+        let cache = &mut self.decode_cache;
+        if !cache.recording {
+            return;
+        }
+        cache.recording = false;
+        let len = cache.record_len;
+        let opcode_len = cache
+            .record
+            .iter()
+            .position(|&b| decode_prefix(b).is_none());
+        let Some(opcode_len) = opcode_len.filter(|&n| n < len as usize) else {
+            return;
+        };
+
+        // The instruction itself may have switched banks; only store it if
+        // both ends still belong to the generation it was fetched under.
+        let generation = cache.record_generation;
+        let first = Self::physical_addr(cs, ip);
+        let last = Self::physical_addr(cs, ip.wrapping_add(len as u16 - 1));
+        if bus.code_generation(master, first) != Some(generation)
+            || bus.code_generation(master, last) != Some(generation)
+        {
+            return;
+        }
+
+        let (segment_override, rep_prefix) = (self.segment_override, self.rep_prefix);
+        cache.entries[DecodeCache::index(first)] = DecodedInstruction {
+            cs,
+            ip,
+            generation,
+            valid: true,
+            segment_override,
+            rep_prefix,
+            opcode,
+            opcode_len: opcode_len as u8 + 1,
+            len,
+            bytes: cache.record,
+        };
+    }
+
     /// Consume all prefix bytes from the instruction stream, updating
     /// `segment_override` and `rep_prefix`. Returns the first non-prefix
     /// opcode byte.
@@ -328,4 +583,114 @@ mod tests {
             assert_eq!(m.reg, 0);
         }
     }
+
+    // -- Predecode cache --
+
+    use crate::core::bus::InterruptState;
+
+    /// Bus whose upper half (0x8000-0xFFFF) is reported as immutable code.
+    struct RomBus {
+        mem: Vec<u8>,
+        generation: u32,
+        reads: usize,
+    }
+
+    impl RomBus {
+        fn new(program: &[u8]) -> Self {
+            let mut mem = vec![0; 0x1_0000];
+            mem[0x8000..0x8000 + program.len()].copy_from_slice(program);
+            Self {
+                mem,
+                generation: 0,
+                reads: 0,
+            }
+        }
+    }
+
+    impl Bus for RomBus {
+        type Address = u32;
+        type Data = u8;
+
+        fn read(&mut self, _master: BusMaster, addr: u32) -> u8 {
+            self.reads += 1;
+            self.mem[(addr & 0xFFFF) as usize]
+        }
+
+        fn write(&mut self, _master: BusMaster, addr: u32, data: u8) {
+            self.mem[(addr & 0xFFFF) as usize] = data;
+        }
+
+        fn is_halted_for(&self, _master: BusMaster) -> bool {
+            false
+        }
+
+        fn check_interrupts(&mut self, _target: BusMaster) -> InterruptState {
+            InterruptState::default()
+        }
+
+        fn code_generation(&self, _master: BusMaster, addr: u32) -> Option<u32> {
+            (addr & 0xFFFF >= 0x8000).then_some(self.generation)
+        }
+    }
+
+    const MASTER: BusMaster = BusMaster::Cpu(0);
+
+    fn run_from(cpu: &mut I8088, bus: &mut RomBus, ip: u16, count: usize) {
+        cpu.cs = 0;
+        cpu.ip = ip;
+        for _ in 0..count {
+            cpu.execute_cycle(bus, MASTER);
+        }
+    }
+
+    #[test]
+    fn decode_cache_replays_rom_instructions() {
+        // MOV AX,0x1234 ; MOV AL,CS:[BX] ; JMP short back to start
+        let mut bus = RomBus::new(&[0xB8, 0x34, 0x12, 0x2E, 0x8A, 0x07, 0xEB, 0xF8]);
+        bus.mem[0x8100] = 0x5A;
+        let mut cpu = I8088::new();
+        cpu.bx = 0x8100;
+
+        run_from(&mut cpu, &mut bus, 0x8000, 3);
+        assert_eq!(cpu.ax, 0x125A);
+        assert_eq!(cpu.ip, 0x8000);
+        // 3 + 3 + 2 instruction bytes plus one data read
+        assert_eq!(bus.reads, 9);
+
+        cpu.ax = 0;
+        bus.reads = 0;
+        run_from(&mut cpu, &mut bus, 0x8000, 3);
+        assert_eq!(cpu.ax, 0x125A);
+        assert_eq!(cpu.ip, 0x8000);
+        // Only the CS:[BX] data read reaches the bus
+        assert_eq!(bus.reads, 1);
+    }
+
+    #[test]
+    fn decode_cache_skips_ram() {
+        let mut bus = RomBus::new(&[]);
+        bus.mem[0x0100..0x0103].copy_from_slice(&[0xB8, 0x34, 0x12]);
+        let mut cpu = I8088::new();
+
+        run_from(&mut cpu, &mut bus, 0x0100, 1);
+        bus.reads = 0;
+        run_from(&mut cpu, &mut bus, 0x0100, 1);
+        assert_eq!(cpu.ax, 0x1234);
+        assert_eq!(bus.reads, 3);
+    }
+
+    #[test]
+    fn decode_cache_invalidated_by_generation() {
+        let mut bus = RomBus::new(&[0xB8, 0x34, 0x12]);
+        let mut cpu = I8088::new();
+        run_from(&mut cpu, &mut bus, 0x8000, 1);
+        assert_eq!(cpu.ax, 0x1234);
+
+        // Simulate a bank switch: new bytes under a new generation
+        bus.mem[0x8001] = 0x78;
+        bus.mem[0x8002] = 0x56;
+        bus.generation += 1;
+        run_from(&mut cpu, &mut bus, 0x8000, 1);
+        assert_eq!(cpu.ax, 0x5678);
+    }
 }
@@ -6,6 +6,7 @@
 
 use super::addressing::Operand;
 use super::alu;
+use super::decode::DecodedModRM;
 use super::flags::{self, Flag};
 use super::registers::SegReg;
 use super::{ExecState, I8088, RepPrefix};
@@ -210,8 +211,7 @@ impl I8088 {
             //   0x83: ALU r/m16, imm8 (sign-extended to 16-bit)
             // =============================================================
             0x80 | 0x82 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let imm = self.fetch_byte(bus, master);
                 let val = self.read_operand8(operand, bus, master);
                 let result = self.alu_op8(modrm.reg, val, imm);
@@ -221,8 +221,7 @@ impl I8088 {
                 }
             }
             0x81 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let imm = self.fetch_word(bus, master);
                 let val = self.read_operand16(operand, bus, master);
                 let result = self.alu_op16(modrm.reg, val, imm);
@@ -231,8 +230,7 @@ impl I8088 {
                 }
             }
             0x83 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 // Sign-extend imm8 to 16-bit
                 let imm = self.fetch_byte(bus, master) as i8 as u16;
                 let val = self.read_operand16(operand, bus, master);
@@ -246,15 +244,13 @@ impl I8088 {
             // TEST r/m8, reg8 (0x84) | TEST r/m16, reg16 (0x85)
             // =============================================================
             0x84 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let a = self.read_operand8(operand, bus, master);
                 let b = self.get_reg8(modrm.reg);
                 alu::and8(&mut self.flags, a, b);
             }
             0x85 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let a = self.read_operand16(operand, bus, master);
                 let b = self.get_reg16(modrm.reg);
                 alu::and16(&mut self.flags, a, b);
@@ -264,16 +260,14 @@ impl I8088 {
             // XCHG r/m8, reg8 (0x86) | XCHG r/m16, reg16 (0x87)
             // =============================================================
             0x86 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let a = self.get_reg8(modrm.reg);
                 let b = self.read_operand8(operand, bus, master);
                 self.set_reg8(modrm.reg, b);
                 self.write_operand8(operand, bus, master, a);
             }
             0x87 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let a = self.get_reg16(modrm.reg);
                 let b = self.read_operand16(operand, bus, master);
                 self.set_reg16(modrm.reg, b);
@@ -288,9 +282,16 @@ impl I8088 {
             0x88..=0x8B => {
                 let w = opcode & 1 != 0;
                 let d = opcode & 2 != 0;
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
-                if w {
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
+                if let Operand::Register(rm) = operand {
+                    // Register-register fast path
+                    let (dst, src) = if d { (modrm.reg, rm) } else { (rm, modrm.reg) };
+                    if w {
+                        self.set_reg16(dst, self.get_reg16(src));
+                    } else {
+                        self.set_reg8(dst, self.get_reg8(src));
+                    }
+                } else if w {
                     if d {
                         let val = self.read_operand16(operand, bus, master);
                         self.set_reg16(modrm.reg, val);
@@ -311,8 +312,7 @@ impl I8088 {
             // MOV r/m16, segreg (0x8C)
             // =============================================================
             0x8C => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let seg = I8088::decode_seg(modrm.reg & 3);
                 let val = self.get_seg(seg);
                 self.write_operand16(operand, bus, master, val);
@@ -322,8 +322,7 @@ impl I8088 {
             // LEA reg16, mem (0x8D)
             // =============================================================
             0x8D => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 if let Operand::Memory { offset, .. } = operand {
                     self.set_reg16(modrm.reg, offset);
                 }
@@ -334,8 +333,7 @@ impl I8088 {
             // MOV segreg, r/m16 (0x8E)
             // =============================================================
             0x8E => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let val = self.read_operand16(operand, bus, master);
                 let seg = I8088::decode_seg(modrm.reg & 3);
                 self.set_seg(seg, val);
@@ -347,8 +345,7 @@ impl I8088 {
             // POP r/m16 (0x8F /0)
             // =============================================================
             0x8F => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 if modrm.reg == 0 {
                     let val = self.pop16(bus, master);
                     self.write_operand16(operand, bus, master, val);
@@ -531,8 +528,7 @@ impl I8088 {
             // LDS reg16, mem32 (0xC5): load far pointer into DS:reg
             // =============================================================
             0xC4 | 0xC5 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 if let Operand::Memory { segment, offset } = operand {
                     let new_offset = self.read_word(bus, master, segment, offset);
                     let new_seg = self.read_word(bus, master, segment, offset.wrapping_add(2));
@@ -549,8 +545,7 @@ impl I8088 {
             // MOV r/m8, imm8 (0xC6) — reg field ignored on 8088
             // =============================================================
             0xC6 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let operand = self.fetch_operands(bus, master).operand;
                 let imm = self.fetch_byte(bus, master);
                 self.write_operand8(operand, bus, master, imm);
             }
@@ -559,8 +554,7 @@ impl I8088 {
             // MOV r/m16, imm16 (0xC7) — reg field ignored on 8088
             // =============================================================
             0xC7 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let operand = self.fetch_operands(bus, master).operand;
                 let imm = self.fetch_word(bus, master);
                 self.write_operand16(operand, bus, master, imm);
             }
@@ -594,30 +588,26 @@ impl I8088 {
             //   0xD2: r/m8, CL   0xD3: r/m16, CL
             // =============================================================
             0xD0 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let val = self.read_operand8(operand, bus, master);
                 let result = alu::shift_rotate8(&mut self.flags, val, 1, modrm.reg);
                 self.write_operand8(operand, bus, master, result);
             }
             0xD1 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let val = self.read_operand16(operand, bus, master);
                 let result = alu::shift_rotate16(&mut self.flags, val, 1, modrm.reg);
                 self.write_operand16(operand, bus, master, result);
             }
             0xD2 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let val = self.read_operand8(operand, bus, master);
                 let cl = self.cl();
                 let result = alu::shift_rotate8(&mut self.flags, val, cl, modrm.reg);
                 self.write_operand8(operand, bus, master, result);
             }
             0xD3 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 let val = self.read_operand16(operand, bus, master);
                 let cl = self.cl();
                 let result = alu::shift_rotate16(&mut self.flags, val, cl, modrm.reg);
@@ -799,8 +789,7 @@ impl I8088 {
             // Unary group 0xF6 (byte)
             // =============================================================
             0xF6 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 match modrm.reg {
                     0 => {
                         // TEST r/m8, imm8
@@ -885,8 +874,7 @@ impl I8088 {
             // Unary group 0xF7 (word)
             // =============================================================
             0xF7 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 match modrm.reg {
                     0 => {
                         // TEST r/m16, imm16
@@ -973,8 +961,7 @@ impl I8088 {
             // 0xFE group (byte): /0=INC r/m8, /1=DEC r/m8
             // =============================================================
             0xFE => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 match modrm.reg {
                     0 => {
                         let val = self.read_operand8(operand, bus, master);
@@ -996,8 +983,7 @@ impl I8088 {
             // /5=JMP far indirect, /6=PUSH r/m16
             // =============================================================
             0xFF => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
                 match modrm.reg {
                     0 => {
                         let val = self.read_operand16(operand, bus, master);
@@ -1124,49 +1110,67 @@ impl I8088 {
     ) {
         let sub = opcode & 7;
         match sub {
-            // r/m8, reg8
-            0 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
-                let a = self.read_operand8(operand, bus, master);
-                let b = self.get_reg8(modrm.reg);
-                let result = self.alu_op8(op, a, b);
-                if op != 7 {
-                    // not CMP
-                    self.write_operand8(operand, bus, master, result);
-                }
-            }
-            // r/m16, reg16
-            1 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
-                let a = self.read_operand16(operand, bus, master);
-                let b = self.get_reg16(modrm.reg);
-                let result = self.alu_op16(op, a, b);
-                if op != 7 {
-                    self.write_operand16(operand, bus, master, result);
-                }
-            }
-            // reg8, r/m8
-            2 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
-                let a = self.get_reg8(modrm.reg);
-                let b = self.read_operand8(operand, bus, master);
-                let result = self.alu_op8(op, a, b);
-                if op != 7 {
-                    self.set_reg8(modrm.reg, result);
-                }
-            }
-            // reg16, r/m16
-            3 => {
-                let modrm = self.fetch_modrm(bus, master);
-                let operand = self.resolve_modrm(modrm, bus, master);
-                let a = self.get_reg16(modrm.reg);
-                let b = self.read_operand16(operand, bus, master);
-                let result = self.alu_op16(op, a, b);
-                if op != 7 {
-                    self.set_reg16(modrm.reg, result);
+            0..=3 => {
+                let DecodedModRM { modrm, operand } = self.fetch_operands(bus, master);
+                let word = sub & 1 != 0;
+                let to_reg = sub & 2 != 0;
+                match (operand, word) {
+                    // Register-register forms: d bit selects the destination
+                    (Operand::Register(rm), false) => {
+                        let (dst, src) = if to_reg {
+                            (modrm.reg, rm)
+                        } else {
+                            (rm, modrm.reg)
+                        };
+                        let result = self.alu_op8(op, self.get_reg8(dst), self.get_reg8(src));
+                        if op != 7 {
+                            // not CMP
+                            self.set_reg8(dst, result);
+                        }
+                    }
+                    (Operand::Register(rm), true) => {
+                        let (dst, src) = if to_reg {
+                            (modrm.reg, rm)
+                        } else {
+                            (rm, modrm.reg)
+                        };
+                        let result = self.alu_op16(op, self.get_reg16(dst), self.get_reg16(src));
+                        if op != 7 {
+                            self.set_reg16(dst, result);
+                        }
+                    }
+                    // r/m8, reg8 | reg8, r/m8
+                    (_, false) => {
+                        let mem = self.read_operand8(operand, bus, master);
+                        let reg = self.get_reg8(modrm.reg);
+                        if to_reg {
+                            let result = self.alu_op8(op, reg, mem);
+                            if op != 7 {
+                                self.set_reg8(modrm.reg, result);
+                            }
+                        } else {
+                            let result = self.alu_op8(op, mem, reg);
+                            if op != 7 {
+                                self.write_operand8(operand, bus, master, result);
+                            }
+                        }
+                    }
+                    // r/m16, reg16 | reg16, r/m16
+                    (_, true) => {
+                        let mem = self.read_operand16(operand, bus, master);
+                        let reg = self.get_reg16(modrm.reg);
+                        if to_reg {
+                            let result = self.alu_op16(op, reg, mem);
+                            if op != 7 {
+                                self.set_reg16(modrm.reg, result);
+                            }
+                        } else {
+                            let result = self.alu_op16(op, mem, reg);
+                            if op != 7 {
+                                self.write_operand16(operand, bus, master, result);
+                            }
+                        }
+                    }
                 }
             }
             // AL, imm8
@@ -1279,6 +1283,94 @@ impl I8088 {
         self.effective_segment(SegReg::DS)
     }
 
+    /// True if `count` elements of `width` bytes starting at `offset` stay
+    /// inside the segment (no 16-bit offset wrap) when walking in direction DF.
+    fn string_run_fits(offset: u16, count: u16, width: u16, descending: bool) -> bool {
+        let bytes = count as u32 * width as u32;
+        let top = offset as u32 + width as u32;
+        if descending {
+            top <= 0x1_0000 && top >= bytes
+        } else {
+            offset as u32 + bytes <= 0x1_0000
+        }
+    }
+
+    /// Bulk path for REP MOVSB/MOVSW: hand the whole run to
+    /// `Bus::block_copy`. Returns false (nothing moved) if either run wraps
+    /// its segment, a word run aliases, or the bus declines.
+    fn rep_movs_bulk<B: Bus<Address = u32, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+        word: bool,
+    ) -> bool {
+        let count = self.cx;
+        let width: u16 = if word { 2 } else { 1 };
+        let descending = flags::get(self.flags, Flag::DF);
+        if count < 2
+            || !Self::string_run_fits(self.si, count, width, descending)
+            || !Self::string_run_fits(self.di, count, width, descending)
+        {
+            return false;
+        }
+        // Descending word runs start from the high byte of the first word
+        let lead = if descending { width - 1 } else { 0 };
+        let src = Self::physical_addr(self.string_src_seg(), self.si.wrapping_add(lead));
+        let dst = Self::physical_addr(self.es, self.di.wrapping_add(lead));
+        let bytes = count as u32 * width as u32;
+        // Byte-ordered replay only matches word-at-a-time moves without aliasing
+        if word && src.abs_diff(dst) < bytes {
+            return false;
+        }
+        if !bus.block_copy(master, src, dst, bytes, descending) {
+            return false;
+        }
+        let advance = self.string_step(word).wrapping_mul(count);
+        self.si = self.si.wrapping_add(advance);
+        self.di = self.di.wrapping_add(advance);
+        self.cx = 0;
+        true
+    }
+
+    /// Bulk path for REP STOSB/STOSW: store the first element through the
+    /// bus, then let `Bus::block_copy` replicate it across the rest of the
+    /// run (an overlapping copy one element behind). Anything the bus
+    /// declines is left in CX for the per-element loop.
+    fn rep_stos_bulk<B: Bus<Address = u32, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+        word: bool,
+    ) {
+        let count = self.cx;
+        let width: u16 = if word { 2 } else { 1 };
+        let descending = flags::get(self.flags, Flag::DF);
+        if count < 2 || !Self::string_run_fits(self.di, count, width, descending) {
+            return;
+        }
+        let step = self.string_step(word);
+        if word {
+            self.write_word(bus, master, self.es, self.di, self.ax);
+        } else {
+            self.write_byte(bus, master, self.es, self.di, self.al());
+        }
+        let (src, dst) = if descending {
+            (self.di.wrapping_add(width - 1), self.di.wrapping_sub(1))
+        } else {
+            (self.di, self.di.wrapping_add(width))
+        };
+        self.di = self.di.wrapping_add(step);
+        self.cx -= 1;
+
+        let rest = self.cx;
+        let src = Self::physical_addr(self.es, src);
+        let dst = Self::physical_addr(self.es, dst);
+        if bus.block_copy(master, src, dst, rest as u32 * width as u32, descending) {
+            self.di = self.di.wrapping_add(step.wrapping_mul(rest));
+            self.cx = 0;
+        }
+    }
+
     /// MOVSB: [ES:DI] <- [DS:SI], SI += step, DI += step
     fn string_op_movsb<B: Bus<Address = u32, Data = u8> + ?Sized>(
         &mut self,
@@ -1289,6 +1381,9 @@ impl I8088 {
         let step = self.string_step(false);
         match rep {
             Some(_) => {
+                if self.rep_movs_bulk(bus, master, false) {
+                    return;
+                }
                 while self.cx != 0 {
                     let seg = self.string_src_seg();
                     let val = self.read_byte(bus, master, seg, self.si);
@@ -1318,6 +1413,9 @@ impl I8088 {
         let step = self.string_step(true);
         match rep {
             Some(_) => {
+                if self.rep_movs_bulk(bus, master, true) {
+                    return;
+                }
                 while self.cx != 0 {
                     let seg = self.string_src_seg();
                     let val = self.read_word(bus, master, seg, self.si);
@@ -1437,6 +1535,7 @@ impl I8088 {
         let al = self.al();
         match rep {
             Some(_) => {
+                self.rep_stos_bulk(bus, master, false);
                 while self.cx != 0 {
                     self.write_byte(bus, master, self.es, self.di, al);
                     self.di = self.di.wrapping_add(step);
@@ -1461,6 +1560,7 @@ impl I8088 {
         let ax = self.ax;
         match rep {
             Some(_) => {
+                self.rep_stos_bulk(bus, master, true);
                 while self.cx != 0 {
                     self.write_word(bus, master, self.es, self.di, ax);
                     self.di = self.di.wrapping_add(step);
@@ -1619,12 +1719,17 @@ mod tests {
     /// 1 MB test bus (heap-allocated to avoid stack overflow).
     struct TestBus {
         mem: Box<[u8; 0x10_0000]>,
+        /// Accept `block_copy` requests (counted in `block_copies`).
+        bulk: bool,
+        block_copies: u32,
     }
 
     impl TestBus {
         fn new() -> Self {
             Self {
                 mem: Box::new([0; 0x10_0000]),
+                bulk: false,
+                block_copies: 0,
             }
         }
     }
@@ -1648,6 +1753,29 @@ mod tests {
         fn check_interrupts(&mut self, _target: BusMaster) -> InterruptState {
             InterruptState::default()
         }
+
+        fn block_copy(
+            &mut self,
+            _master: BusMaster,
+            src: u32,
+            dst: u32,
+            len: u32,
+            descending: bool,
+        ) -> bool {
+            if !self.bulk {
+                return false;
+            }
+            for i in 0..len {
+                let (s, d) = if descending {
+                    (src.wrapping_sub(i), dst.wrapping_sub(i))
+                } else {
+                    (src + i, dst + i)
+                };
+                self.mem[(d & 0xF_FFFF) as usize] = self.mem[(s & 0xF_FFFF) as usize];
+            }
+            self.block_copies += 1;
+            true
+        }
     }
 
     const M: BusMaster = BusMaster::Cpu(0);
@@ -3362,6 +3490,64 @@ mod tests {
         assert_eq!(cpu.ax, 0x5000); // unchanged
     }
 
+    #[test]
+    fn alu_register_forms_match_memory_forms() {
+        // Every ALU op in all four ModR/M forms: the register-register path
+        // (rm = CX/CL) must give the same result and flags as the memory
+        // path with the same value at [BX].
+        for op in 0..8u8 {
+            for sub in 0..4u8 {
+                let opcode = (op << 3) | sub;
+                let word = sub & 1 != 0;
+
+                let (mut reg_cpu, mut reg_bus) = setup();
+                reg_cpu.ax = 0x9C7F;
+                reg_cpu.cx = 0x4381;
+                reg_cpu.flags |= 1; // CF set for ADC/SBB
+                // ModR/M: mod=11 reg=000(AX/AL) rm=001(CX/CL) = 0xC1
+                reg_bus.mem[0x100] = 0xC1;
+                reg_cpu.execute(opcode, &mut reg_bus, M);
+
+                let (mut mem_cpu, mut mem_bus) = setup();
+                mem_cpu.ax = 0x9C7F;
+                mem_cpu.bx = 0x0050;
+                mem_cpu.flags |= 1;
+                mem_bus.mem[0x20050] = 0x81;
+                mem_bus.mem[0x20051] = 0x43;
+                // ModR/M: mod=00 reg=000(AX/AL) rm=111([BX]) = 0x07
+                mem_bus.mem[0x100] = 0x07;
+                mem_cpu.execute(opcode, &mut mem_bus, M);
+
+                let mem_rm = mem_bus.mem[0x20050] as u16 | (mem_bus.mem[0x20051] as u16) << 8;
+                let (reg_rm, mem_rm) = if word {
+                    (reg_cpu.cx, mem_rm)
+                } else {
+                    (reg_cpu.cx & 0xFF, mem_rm & 0xFF)
+                };
+                assert_eq!(reg_cpu.ax, mem_cpu.ax, "opcode {opcode:02X}");
+                assert_eq!(reg_rm, mem_rm, "opcode {opcode:02X}");
+                assert_eq!(reg_cpu.flags, mem_cpu.flags, "opcode {opcode:02X}");
+            }
+        }
+    }
+
+    #[test]
+    fn mov_register_forms() {
+        let (mut cpu, mut bus) = setup();
+        cpu.ax = 0x1234;
+        cpu.dx = 0xABCD;
+        // MOV DH, AL: 0x88 ModR/M mod=11 reg=000(AL) rm=110(DH) = 0xC6
+        bus.mem[0x100] = 0xC6;
+        cpu.execute(0x88, &mut bus, M);
+        assert_eq!(cpu.dx, 0x34CD);
+
+        // MOV AX, DX: 0x8B ModR/M mod=11 reg=000(AX) rm=010(DX) = 0xC2
+        cpu.ip = 0x100;
+        bus.mem[0x100] = 0xC2;
+        cpu.execute(0x8B, &mut bus, M);
+        assert_eq!(cpu.ax, 0x34CD);
+    }
+
     // =====================================================================
     // ADD overflow edge case: signed boundary
     // =====================================================================
@@ -4047,6 +4233,49 @@ mod tests {
         assert_eq!(cpu.di, 0xFFFF);
     }
 
+    #[test]
+    fn rep_string_bulk_matches_per_element() {
+        use super::super::flags::{self as fl, Flag};
+        // (opcode, DF, SI, DI, CX, bulk expected)
+        let cases = [
+            (0xA4, false, 0x0100, 0x0101, 300, true), // overlapping fill
+            (0xA4, true, 0x0200, 0x0100, 200, true),
+            (0xA5, false, 0x0100, 0x0800, 100, true),
+            (0xA5, false, 0x0100, 0x0101, 50, false), // aliasing words
+            (0xA5, true, 0x0900, 0x0100, 100, true),
+            (0xAA, false, 0, 0x0100, 500, true),
+            (0xAA, true, 0, 0x0500, 500, true),
+            (0xAB, false, 0, 0x0101, 300, true),
+            (0xAB, true, 0, 0x0801, 300, true),
+            (0xA4, false, 0xFFF0, 0x0100, 0x20, false), // SI wraps
+            (0xAB, true, 0, 0x0004, 5, false),          // DI wraps
+        ];
+        for (opcode, df, si, di, cx, expect_bulk) in cases {
+            let mut results = Vec::new();
+            for bulk in [false, true] {
+                let (mut cpu, mut bus) = setup();
+                bus.bulk = bulk;
+                cpu.ds = cpu.es; // one segment so runs can overlap
+                for i in 0..0x1_0000usize {
+                    bus.mem[0x40000 + i] = (i ^ (i >> 8)) as u8;
+                }
+                cpu.ax = 0xBEEF;
+                fl::set(&mut cpu.flags, Flag::DF, df);
+                cpu.si = si;
+                cpu.di = di;
+                cpu.cx = cx;
+                cpu.rep_prefix = Some(super::RepPrefix::Rep);
+                cpu.execute(opcode, &mut bus, M);
+                assert_eq!(bus.block_copies > 0, bulk && expect_bulk);
+                results.push((bus.mem[0x40000..0x50000].to_vec(), cpu.si, cpu.di, cpu.cx));
+            }
+            assert!(
+                results[0] == results[1],
+                "opcode {opcode:#04X} df={df} si={si:#06X} di={di:#06X} cx={cx}"
+            );
+        }
+    }
+
     // =====================================================================
     // CMPSB/CMPSW (0xA6-0xA7)
     // =====================================================================
@@ -21,10 +21,12 @@ pub use registers::SegReg;
 
 use crate::core::bus::InterruptState;
 use crate::core::component::BusMasterComponent;
+use crate::core::save_state::{SaveError, StateReader, StateWriter};
 use crate::core::{Bus, BusMaster};
 use crate::cpu::Cpu;
 use crate::cpu::state::CpuStateTrait;
 use crate::prelude::Saveable;
+use decode::DecodeCache;
 
 /// Execution state machine for multi-cycle instructions.
 #[derive(Clone, Debug)]
@@ -40,6 +42,34 @@ pub(crate) enum ExecState {
     Halted,
 }
 
+/// Serialized as a tag byte and the remaining-cycle count.
+impl Saveable for ExecState {
+    fn save_state(&self, w: &mut StateWriter) {
+        let (tag, left) = match *self {
+            ExecState::Fetch => (0, 0),
+            ExecState::Execute(left) => (1, left),
+            ExecState::Halted => (2, 0),
+        };
+        w.write_u8(tag);
+        w.write_u16_le(left);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        let (tag, left) = (r.read_u8()?, r.read_u16_le()?);
+        *self = match tag {
+            0 => ExecState::Fetch,
+            1 => ExecState::Execute(left),
+            2 => ExecState::Halted,
+            n => return Err(SaveError::InvalidFormat(format!("I8088 exec state {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        3
+    }
+}
+
 /// REP/REPZ/REPNZ prefix state.
 #[derive(Copy, Clone, Debug, PartialEq)]
 pub enum RepPrefix {
@@ -60,9 +90,9 @@ pub(crate) enum InterruptType {
     Software = 2,
 }
 
-/// Fields are ordered to match the save-state serialization layout (version 1).
+/// Fields are ordered to match the save-state serialization layout (version 2).
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct I8088 {
     // General-purpose registers (accessible as 16-bit or 8-bit halves)
     pub ax: u16,
@@ -94,15 +124,21 @@ pub struct I8088 {
     pub(crate) nmi_prev: bool,
     pub(crate) nmi_pending: bool,
 
-    // Internal state (not serialized)
-    #[save_skip(default = ExecState::Fetch)]
+    // Wait states left in the current instruction (or HLT), saved so a
+    // snapshot taken mid-instruction resumes exactly where it left off
     pub(crate) state: ExecState,
+
+    // Prefix state lives only within the fetch cycle that decodes it (not
+    // serialized)
     #[save_skip(default)]
     pub(crate) segment_override: Option<SegReg>,
     #[save_skip(default)]
     pub(crate) rep_prefix: Option<RepPrefix>,
     #[save_skip(default)]
     pub(crate) irq_line: bool,
+    // Predecoded ROM instructions (derived state, rebuilt on demand)
+    #[save_skip]
+    pub(crate) decode_cache: DecodeCache,
     // Cycle counter (total bus cycles executed, not serialized, keeps current value)
     #[save_skip]
     pub(crate) clock: u64,
@@ -138,6 +174,7 @@ impl I8088 {
             nmi_pending: false,
             nmi_prev: false,
             irq_line: false,
+            decode_cache: DecodeCache::new(),
             clock: 0,
         }
     }
@@ -168,11 +205,14 @@ impl I8088 {
                     return;
                 }
 
-                // Consume any prefix bytes and fetch the opcode
-                let opcode = self.consume_prefixes(bus, master);
+                // Consume any prefix bytes and fetch the opcode (or replay
+                // them from the predecode cache)
+                let (cs, ip) = (self.cs, self.ip);
+                let opcode = self.fetch_instruction(bus, master);
 
                 // Execute the instruction
                 self.execute(opcode, bus, master);
+                self.retire_instruction(bus, master, cs, ip, opcode);
             }
             ExecState::Execute(remaining) => {
                 if remaining <= 1 {
@@ -284,6 +324,7 @@ impl Cpu for I8088 {
         self.nmi_pending = false;
         self.nmi_prev = false;
         self.irq_line = false;
+        self.decode_cache.invalidate();
 
         // The 8088 starts executing at CS:IP = FFFF:0000 (physical 0xFFFF0).
         // Unlike 6502/6809 which read a reset vector, the 8088 simply begins
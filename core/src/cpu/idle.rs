@@ -0,0 +1,327 @@
+//! Idle-loop detection shared by the cycle-stepped CPUs.
+//!
+//! Between interrupts many ROMs spin in a short loop that only reads
+//! memory: `BRA *`, or a poll of a RAM flag the interrupt handler sets.
+//! Such a pass is a function of the registers and the bytes it reads. If it
+//! returns to its first instruction with the registers unchanged, having
+//! made only reads the bus reports as pure ([`Bus::is_pure_read`]), every
+//! later pass repeats it exactly: nothing it reads can change until the
+//! CPU itself writes, and it cannot write before an interrupt takes it out
+//! of the loop.
+//!
+//! Detection runs in two stages. A jump back by at most [`MAX_LOOP_BYTES`]
+//! to an instruction whose opcode byte is pure starts *watching* that head.
+//! While watching, the CPU executes through an [`IdleProbe`] that flags any
+//! write, I/O access, impure read or bus halt, and counts cycles. Arriving
+//! back at the head after a clean pass with the same registers *confirms*
+//! the loop with that period. A clean pass that changed registers is
+//! probed again a few times; anything else rejects the head until the
+//! next interrupt. Taking an interrupt, a reset or a state load forgets
+//! the loop.
+//!
+//! A confirmed loop is only skipped on request. The board knows when its
+//! next event (a scanline start, a timer) can raise an interrupt line, and
+//! calls the CPU's `skip_idle` with the cycles up to it. The CPU hands back
+//! whole passes that fit, and the board charges them to its clocks and
+//! devices in one step.
+
+use std::cell::Cell;
+
+use crate::core::{Bus, BusMaster, bus::InterruptState};
+
+/// Longest backward jump (in bytes) that starts watching its target.
+pub const MAX_LOOP_BYTES: u16 = 32;
+
+/// Longest pass (in cycles) that can be confirmed.
+pub const MAX_PERIOD: u32 = 256;
+
+/// Passes probed from one head before giving up on registers settling.
+/// The first pass usually starts from whatever state the code before the
+/// loop left; a countdown never settles.
+const MAX_PASSES: u8 = 3;
+
+/// CPU registers compared between passes, packed by each CPU. Registers
+/// that advance on every pass by design (Z80 R) are passed separately as
+/// the loop's counter.
+pub type IdleRegs = [u8; 32];
+
+#[derive(Clone, Copy, Debug)]
+enum Phase {
+    Off,
+    /// Probing one pass from `head`.
+    Watching {
+        head: u16,
+        regs: IdleRegs,
+        counter: u8,
+        /// Cycles of the pass so far. A pass that starts outside a probe
+        /// counts its first cycle up front, since `observe` won't see it.
+        cycles: u32,
+        /// Passes probed from this head so far, including this one.
+        passes: u8,
+    },
+    /// `head` repeats every `period` cycles, advancing the counter by
+    /// `counter_step` per pass.
+    Confirmed {
+        head: u16,
+        regs: IdleRegs,
+        period: u32,
+        counter_step: u8,
+    },
+    /// `head` failed a probe; not watched again until disarmed.
+    Rejected(u16),
+}
+
+/// Per-CPU idle-loop detector.
+#[derive(Clone, Copy, Debug)]
+pub struct IdleLoop {
+    /// Allow detection and skipping. On by default; the debugger can turn
+    /// it off to see every pass.
+    pub enabled: bool,
+    /// PC of the previous instruction boundary (to spot backward jumps).
+    last_pc: u16,
+    phase: Phase,
+}
+
+impl Default for IdleLoop {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl IdleLoop {
+    pub const fn new() -> Self {
+        Self {
+            enabled: true,
+            last_pc: 0,
+            phase: Phase::Off,
+        }
+    }
+
+    /// Forget the loop (reset, interrupt entry).
+    pub fn disarm(&mut self) {
+        self.phase = Phase::Off;
+    }
+
+    /// This detector disarmed, keeping `enabled`. Used as the value
+    /// restored by `load_state`, which can put the CPU anywhere.
+    pub const fn disarmed(self) -> Self {
+        Self {
+            phase: Phase::Off,
+            ..self
+        }
+    }
+
+    /// True while a pass is being probed; the CPU then runs the cycle
+    /// through an [`IdleProbe`] and reports it with [`observe`](Self::observe).
+    #[inline]
+    pub fn watching(&self) -> bool {
+        matches!(self.phase, Phase::Watching { .. })
+    }
+
+    /// Account for one probed cycle that was `pure`.
+    #[inline]
+    pub fn observe(&mut self, pure: bool) {
+        if let Phase::Watching { head, cycles, .. } = &mut self.phase {
+            *cycles += 1;
+            if !pure || *cycles >= MAX_PERIOD {
+                self.phase = Phase::Rejected(*head);
+            }
+        }
+    }
+
+    /// Called at every instruction boundary the CPU reaches without taking
+    /// an interrupt, before the opcode fetch. Returns `true` when a pass
+    /// starts or ends at `pc`; the CPU then reports its registers with
+    /// [`sample`](Self::sample).
+    #[inline]
+    pub fn boundary<B: Bus<Address = u16, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &B,
+        master: BusMaster,
+        pc: u16,
+    ) -> bool {
+        let last = std::mem::replace(&mut self.last_pc, pc);
+        match self.phase {
+            Phase::Off | Phase::Rejected(_) => {
+                if !self.enabled || pc > last || last - pc > MAX_LOOP_BYTES {
+                    return false;
+                }
+                if matches!(self.phase, Phase::Rejected(head) if head == pc) {
+                    return false;
+                }
+                // The head's opcode is fetched in this cycle, before probing
+                // starts, so its purity is checked here.
+                bus.is_pure_read(master, pc)
+            }
+            Phase::Watching { head, .. } => pc == head,
+            Phase::Confirmed { .. } => false,
+        }
+    }
+
+    /// Start or finish a pass at `pc` after [`boundary`](Self::boundary)
+    /// asked for it. `counter` is the register that advances every pass by
+    /// design (Z80 R), 0 on CPUs without one.
+    pub fn sample(&mut self, pc: u16, regs: IdleRegs, counter: u8) {
+        self.phase = match self.phase {
+            Phase::Watching {
+                head,
+                regs: before,
+                counter: start,
+                cycles,
+                passes,
+            } => {
+                if regs == before {
+                    Phase::Confirmed {
+                        head,
+                        regs,
+                        period: cycles,
+                        counter_step: counter.wrapping_sub(start),
+                    }
+                } else if passes < MAX_PASSES {
+                    Phase::Watching {
+                        head,
+                        regs,
+                        counter,
+                        cycles: 0,
+                        passes: passes + 1,
+                    }
+                } else {
+                    Phase::Rejected(head)
+                }
+            }
+            _ => Phase::Watching {
+                head: pc,
+                regs,
+                counter,
+                cycles: 1,
+                passes: 1,
+            },
+        };
+    }
+
+    /// Whole passes of the confirmed loop that fit in `max_cycles`, if the
+    /// CPU is at its head with the confirmed registers and no interrupt
+    /// line is asserted. Returns the cycles to charge and the counter
+    /// advance, or `None` when the CPU must keep stepping.
+    ///
+    /// The caller checks that the CPU is about to fetch (not mid-instruction,
+    /// halted or waiting) and has no edge-detect state pending.
+    #[inline]
+    pub fn skip(
+        &self,
+        pc: u16,
+        regs: impl FnOnce() -> IdleRegs,
+        ints: impl FnOnce() -> InterruptState,
+        max_cycles: u64,
+    ) -> Option<(u64, u8)> {
+        let Phase::Confirmed {
+            head,
+            regs: confirmed,
+            period,
+            counter_step,
+        } = self.phase
+        else {
+            return None;
+        };
+        if !self.enabled || pc != head || max_cycles < period as u64 || regs() != confirmed {
+            return None;
+        }
+        let ints = ints();
+        if ints.nmi || ints.irq || ints.firq {
+            return None;
+        }
+        let passes = max_cycles / period as u64;
+        Some((
+            passes * period as u64,
+            (passes as u8).wrapping_mul(counter_step),
+        ))
+    }
+}
+
+/// Bus wrapper a watching CPU executes through for one cycle.
+///
+/// Forwards every access and records whether the cycle stayed pure: no
+/// writes, no I/O, no halt, and only reads [`Bus::is_pure_read`] accepts.
+pub struct IdleProbe<'a, B: ?Sized> {
+    bus: &'a mut B,
+    pure: Cell<bool>,
+}
+
+impl<'a, B: Bus<Address = u16, Data = u8> + ?Sized> IdleProbe<'a, B> {
+    pub fn new(bus: &'a mut B) -> Self {
+        Self {
+            bus,
+            pure: Cell::new(true),
+        }
+    }
+
+    /// True if nothing the cycle did can be seen outside the CPU.
+    pub fn is_pure(&self) -> bool {
+        self.pure.get()
+    }
+
+    /// Mark the cycle impure for a reason only the CPU can see (e.g. a
+    /// wait state whose length depends on an interrupt line).
+    pub fn taint(&self) {
+        self.pure.set(false);
+    }
+}
+
+impl<B: Bus<Address = u16, Data = u8> + ?Sized> Bus for IdleProbe<'_, B> {
+    type Address = u16;
+    type Data = u8;
+
+    fn read(&mut self, master: BusMaster, addr: u16) -> u8 {
+        if !self.bus.is_pure_read(master, addr) {
+            self.pure.set(false);
+        }
+        self.bus.read(master, addr)
+    }
+
+    fn write(&mut self, master: BusMaster, addr: u16, data: u8) {
+        self.pure.set(false);
+        self.bus.write(master, addr, data);
+    }
+
+    fn io_read(&mut self, master: BusMaster, addr: u16) -> u8 {
+        self.pure.set(false);
+        self.bus.io_read(master, addr)
+    }
+
+    fn io_write(&mut self, master: BusMaster, addr: u16, data: u8) {
+        self.pure.set(false);
+        self.bus.io_write(master, addr, data);
+    }
+
+    fn is_halted_for(&self, master: BusMaster) -> bool {
+        let halted = self.bus.is_halted_for(master);
+        if halted {
+            self.pure.set(false);
+        }
+        halted
+    }
+
+    fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
+        self.bus.check_interrupts(target)
+    }
+
+    fn code_generation(&self, master: BusMaster, addr: u16) -> Option<u32> {
+        self.bus.code_generation(master, addr)
+    }
+
+    fn is_pure_read(&self, master: BusMaster, addr: u16) -> bool {
+        self.bus.is_pure_read(master, addr)
+    }
+
+    fn block_copy(
+        &mut self,
+        master: BusMaster,
+        src: u16,
+        dst: u16,
+        len: u32,
+        descending: bool,
+    ) -> bool {
+        self.pure.set(false);
+        self.bus.block_copy(master, src, dst, len, descending)
+    }
+}
@@ -59,9 +59,9 @@ impl Saveable for InterruptType {
     }
 }
 
-/// Field order matches save-state serialization order (version 1).
+/// Field order matches save-state serialization order (version 2).
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct M6502 {
     // Registers
     pub a: u8,
@@ -77,15 +77,12 @@ pub struct M6502 {
     /// Interrupt type being processed (BRK has its own handler)
     pub(crate) interrupt_type: InterruptType,
 
-    // Execution temporaries — not saved, reset to defaults on load
-    #[save_skip(default = ExecState::Fetch)]
+    // Execution temporaries — saved so a snapshot taken mid-instruction
+    // resumes exactly where it left off
     pub(crate) state: ExecState,
-    #[save_skip(default)]
     pub(crate) opcode: u8,
-    #[save_skip(default)]
     pub(crate) temp_addr: u16,
     /// Temporary data storage for multi-cycle operations (RMW operand, address bytes)
-    #[save_skip(default)]
     pub(crate) temp_data: u8,
 }
 
@@ -97,6 +94,35 @@ pub(crate) enum ExecState {
     Interrupt(u8),
 }
 
+/// Serialized as a tag byte and two payload bytes, unused payload zero.
+impl Saveable for ExecState {
+    fn save_state(&self, w: &mut StateWriter) {
+        let (tag, a, b) = match *self {
+            ExecState::Fetch => (0, 0, 0),
+            ExecState::Execute(op, cycle) => (1, op, cycle),
+            ExecState::Interrupt(cycle) => (2, cycle, 0),
+        };
+        w.write_u8(tag);
+        w.write_u8(a);
+        w.write_u8(b);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        let (tag, a, b) = (r.read_u8()?, r.read_u8()?, r.read_u8()?);
+        *self = match tag {
+            0 => ExecState::Fetch,
+            1 => ExecState::Execute(a, b),
+            2 => ExecState::Interrupt(a),
+            n => return Err(SaveError::InvalidFormat(format!("M6502 exec state {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        3
+    }
+}
+
 impl Default for M6502 {
     fn default() -> Self {
         Self::new()
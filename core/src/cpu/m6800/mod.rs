@@ -4,6 +4,7 @@ pub mod disasm;
 mod load_store;
 mod stack;
 
+use crate::core::save_state::{SaveError, StateReader, StateWriter};
 use crate::core::{Bus, BusMaster, bus::InterruptState, component::BusMasterComponent};
 use crate::cpu::{
     Cpu,
@@ -27,9 +28,34 @@ pub(crate) enum InterruptType {
     Swi = 3,
 }
 
-/// Fields are ordered to match the save-state serialization layout (version 1).
+impl Saveable for InterruptType {
+    fn save_state(&self, w: &mut StateWriter) {
+        w.write_u8(*self as u8);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        *self = match r.read_u8()? {
+            0 => InterruptType::None,
+            1 => InterruptType::Nmi,
+            2 => InterruptType::Irq,
+            3 => InterruptType::Swi,
+            n => {
+                return Err(SaveError::InvalidFormat(format!(
+                    "M6800 interrupt type {n}"
+                )));
+            }
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        1
+    }
+}
+
+/// Fields are ordered to match the save-state serialization layout (version 2).
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct M6800 {
     // Registers
     pub a: u8,
@@ -44,18 +70,14 @@ pub struct M6800 {
     /// True when the bus HALT line is asserted (TSC logic)
     pub(crate) halted: bool,
 
-    // Internal state (not serialized)
-    #[save_skip(default = ExecState::Fetch)]
+    // Internal state, saved so a snapshot taken mid-instruction resumes
+    // exactly where it left off
     pub(crate) state: ExecState,
-    #[save_skip(default)]
     pub(crate) opcode: u8,
-    #[save_skip(default)]
     pub(crate) temp_addr: u16,
     /// Temporary data storage for multi-cycle operations (RMW operand, 16-bit hi byte)
-    #[save_skip(default)]
     pub(crate) temp_data: u8,
     /// Interrupt type being processed
-    #[save_skip(default = InterruptType::None)]
     pub(crate) interrupt_type: InterruptType,
 }
 
@@ -69,6 +91,37 @@ pub(crate) enum ExecState {
     WaitForInterrupt,
 }
 
+/// Serialized as a tag byte and two payload bytes, unused payload zero.
+impl Saveable for ExecState {
+    fn save_state(&self, w: &mut StateWriter) {
+        let (tag, a, b) = match *self {
+            ExecState::Fetch => (0, 0, 0),
+            ExecState::Execute(op, cycle) => (1, op, cycle),
+            ExecState::Interrupt(cycle) => (2, cycle, 0),
+            ExecState::WaitForInterrupt => (3, 0, 0),
+        };
+        w.write_u8(tag);
+        w.write_u8(a);
+        w.write_u8(b);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        let (tag, a, b) = (r.read_u8()?, r.read_u8()?, r.read_u8()?);
+        *self = match tag {
+            0 => ExecState::Fetch,
+            1 => ExecState::Execute(a, b),
+            2 => ExecState::Interrupt(a),
+            3 => ExecState::WaitForInterrupt,
+            n => return Err(SaveError::InvalidFormat(format!("M6800 exec state {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        3
+    }
+}
+
 impl Default for M6800 {
     fn default() -> Self {
         Self::new()
@@ -5,12 +5,14 @@ mod load_store;
 mod stack;
 mod transfer;
 
+use crate::core::save_state::{SaveError, StateReader, StateWriter};
 use crate::core::{Bus, BusMaster, bus::InterruptState, component::BusMasterComponent};
 use crate::cpu::{
     Cpu,
+    idle::{IdleLoop, IdleProbe, IdleRegs},
     state::{CpuStateTrait, M6809State},
 };
-use phosphor_macros::Saveable;
+use crate::prelude::Saveable;
 
 pub use super::m68xx::CcFlag;
 use super::m68xx::{Acc, M68xxAlu};
@@ -26,9 +28,34 @@ pub(crate) enum InterruptType {
     Irq = 3,
 }
 
-/// Fields are ordered to match the save-state serialization layout (version 2).
+impl Saveable for InterruptType {
+    fn save_state(&self, w: &mut StateWriter) {
+        w.write_u8(*self as u8);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        *self = match r.read_u8()? {
+            0 => InterruptType::None,
+            1 => InterruptType::Nmi,
+            2 => InterruptType::Firq,
+            3 => InterruptType::Irq,
+            n => {
+                return Err(SaveError::InvalidFormat(format!(
+                    "M6809 interrupt type {n}"
+                )));
+            }
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        1
+    }
+}
+
+/// Fields are ordered to match the save-state serialization layout (version 3).
 #[derive(Saveable)]
-#[save_version(2)]
+#[save_version(3)]
 pub struct M6809 {
     // Registers (a,b,x,y,u,s,pc,cc)
     pub a: u8,
@@ -47,25 +74,23 @@ pub struct M6809 {
     /// True when the bus HALT line is asserted (TSC/RDY logic)
     pub(crate) halted: bool,
 
-    // Execution temporaries — not saved, reset to defaults on load
-    #[save_skip(default = ExecState::Fetch)]
+    // Execution temporaries — saved so a snapshot taken mid-instruction
+    // resumes exactly where it left off
     pub(crate) state: ExecState,
-    #[save_skip(default)]
     pub(crate) opcode: u8,
     /// Transient scratch storage for postbyte, high-byte, or RMW operand
-    #[save_skip(default)]
     pub(crate) scratch: u8,
-    #[save_skip(default)]
     pub(crate) temp_addr: u16,
     /// Interrupt type being processed
-    #[save_skip(default = InterruptType::None)]
     pub(crate) interrupt_type: InterruptType,
     /// Countdown for internal cycles during indexed addressing
-    #[save_skip(default)]
     pub(crate) indexed_internal: u8,
     #[save_skip(default)]
     #[allow(dead_code)]
     resume_delay: u8, // For TSC/RDY release timing
+    /// Idle-loop detector (not saved; disarmed on load, keeping `enabled`)
+    #[save_skip(default = self.idle.disarmed())]
+    pub idle: IdleLoop,
 }
 
 #[derive(Clone, Debug)]
@@ -82,6 +107,43 @@ pub(crate) enum ExecState {
     SyncWait,
 }
 
+/// Serialized as a tag byte and two payload bytes, unused payload zero.
+impl Saveable for ExecState {
+    fn save_state(&self, w: &mut StateWriter) {
+        let (tag, a, b) = match *self {
+            ExecState::Fetch => (0, 0, 0),
+            ExecState::Execute(op, cycle) => (1, op, cycle),
+            ExecState::ExecutePage2(op, cycle) => (2, op, cycle),
+            ExecState::ExecutePage3(op, cycle) => (3, op, cycle),
+            ExecState::Interrupt(cycle) => (4, cycle, 0),
+            ExecState::WaitForInterrupt => (5, 0, 0),
+            ExecState::SyncWait => (6, 0, 0),
+        };
+        w.write_u8(tag);
+        w.write_u8(a);
+        w.write_u8(b);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        let (tag, a, b) = (r.read_u8()?, r.read_u8()?, r.read_u8()?);
+        *self = match tag {
+            0 => ExecState::Fetch,
+            1 => ExecState::Execute(a, b),
+            2 => ExecState::ExecutePage2(a, b),
+            3 => ExecState::ExecutePage3(a, b),
+            4 => ExecState::Interrupt(a),
+            5 => ExecState::WaitForInterrupt,
+            6 => ExecState::SyncWait,
+            n => return Err(SaveError::InvalidFormat(format!("M6809 exec state {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        3
+    }
+}
+
 impl Default for M6809 {
     fn default() -> Self {
         Self::new()
@@ -109,6 +171,7 @@ impl M6809 {
             interrupt_type: InterruptType::None,
             indexed_internal: 0,
             resume_delay: 0,
+            idle: IdleLoop::new(),
         }
     }
 
@@ -144,6 +207,23 @@ impl M6809 {
         bus: &mut B,
         master: BusMaster,
     ) {
+        if self.idle.watching() {
+            let mut probe = IdleProbe::new(bus);
+            // CWAI/SYNC last until an interrupt line moves
+            if matches!(
+                self.state,
+                ExecState::WaitForInterrupt | ExecState::SyncWait
+            ) {
+                probe.taint();
+            }
+            self.step(&mut probe, master);
+            self.idle.observe(probe.is_pure());
+        } else {
+            self.step(bus, master);
+        }
+    }
+
+    fn step<B: Bus<Address = u16, Data = u8> + ?Sized>(&mut self, bus: &mut B, master: BusMaster) {
         // Check TSC via the generic bus
         if bus.is_halted_for(master) {
             self.halted = true;
@@ -160,9 +240,14 @@ impl M6809 {
             ExecState::Fetch => {
                 let ints = bus.check_interrupts(master);
                 if self.handle_interrupts(ints) {
+                    self.idle.disarm();
                     return; // Interrupt taken, state changed to Interrupt sequence
                 }
 
+                if self.idle.boundary(bus, master, self.pc) {
+                    self.idle.sample(self.pc, self.idle_regs(), 0);
+                }
+
                 self.opcode = bus.read(master, self.pc);
                 self.pc = self.pc.wrapping_add(1);
                 self.state = ExecState::Execute(self.opcode, 0);
@@ -574,6 +659,45 @@ impl M6809 {
     /// Check for pending hardware interrupts at instruction boundary.
     /// Returns true if an interrupt is taken (state changed to Interrupt sequence).
     /// Priority: NMI (edge-triggered) > FIRQ (level, masked by F) > IRQ (level, masked by I).
+    /// Skip whole passes of a confirmed idle loop (see [`crate::cpu::idle`]),
+    /// at most `max_cycles`, leaving the CPU exactly where stepping them
+    /// would. Returns the cycles skipped, 0 if the CPU must be stepped.
+    ///
+    /// The caller guarantees that no interrupt line changes within
+    /// `max_cycles` and charges the returned cycles to everything else.
+    pub fn skip_idle<B: Bus<Address = u16, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+        max_cycles: u64,
+    ) -> u64 {
+        if !matches!(self.state, ExecState::Fetch)
+            || self.halted
+            || self.nmi_previous
+            || bus.is_halted_for(master)
+        {
+            return 0;
+        }
+        self.idle
+            .skip(
+                self.pc,
+                || self.idle_regs(),
+                || bus.check_interrupts(master),
+                max_cycles,
+            )
+            .map_or(0, |(cycles, _)| cycles)
+    }
+
+    /// Registers an idle-loop pass must leave unchanged.
+    fn idle_regs(&self) -> IdleRegs {
+        let mut regs = [0; 32];
+        regs[..4].copy_from_slice(&[self.a, self.b, self.dp, self.cc]);
+        for (i, r) in [self.x, self.y, self.u, self.s].into_iter().enumerate() {
+            regs[4 + i * 2..6 + i * 2].copy_from_slice(&r.to_be_bytes());
+        }
+        regs
+    }
+
     fn handle_interrupts(&mut self, ints: InterruptState) -> bool {
         // NMI is edge-triggered: detect rising edge
         let nmi_edge = crate::cpu::flags::detect_rising_edge(ints.nmi, &mut self.nmi_previous);
@@ -618,6 +742,7 @@ impl Cpu for M6809 {
         let hi = bus.read(master, 0xFFFE);
         let lo = bus.read(master, 0xFFFF);
         self.pc = u16::from_be_bytes([hi, lo]);
+        self.idle.disarm();
     }
 
     fn signal_interrupt(&mut self, _int: InterruptState) {
@@ -688,4 +813,8 @@ impl DebugCpu for M6809 {
     fn debug_disassemble(&self, addr: u16, bytes: &[u8]) -> DisassembledInstruction {
         <Self as crate::cpu::Disassemble>::disassemble(addr, bytes)
     }
+
+    fn set_idle_skip(&mut self, enabled: bool) {
+        self.idle.enabled = enabled;
+    }
 }
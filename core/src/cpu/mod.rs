@@ -27,6 +27,9 @@ pub use state::{
 // Shared flag and signal helpers
 pub mod flags;
 
+// Shared idle-loop detection
+pub mod idle;
+
 // Shared M68xx ALU trait
 pub mod m68xx;
 
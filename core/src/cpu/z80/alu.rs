@@ -1,100 +1,128 @@
 use crate::core::{Bus, BusMaster};
 use crate::cpu::z80::{ExecState, Flag, IndexMode, Z80};
 
+// --- Flag tables ---
+//
+// Precomputed at compile time from the same rules the helpers used to
+// evaluate per operation. Every 8-bit result goes through one of these.
+
+const XY: u8 = Flag::X as u8 | Flag::Y as u8;
+
+/// S, Z, and undocumented X/Y for each 8-bit result.
+pub(super) const SZXY: [u8; 256] = {
+    let mut t = [0u8; 256];
+    let mut i = 0;
+    while i < 256 {
+        let v = i as u8;
+        t[i] = (v & (Flag::S as u8 | XY)) | if v == 0 { Flag::Z as u8 } else { 0 };
+        i += 1;
+    }
+    t
+};
+
+/// S, Z, X/Y, and even parity in PV for each 8-bit result (logic ops,
+/// rotates, IN, DAA).
+pub(super) const SZXYP: [u8; 256] = {
+    let mut t = [0u8; 256];
+    let mut i = 0;
+    while i < 256 {
+        let parity = if (i as u8).count_ones().is_multiple_of(2) {
+            Flag::PV as u8
+        } else {
+            0
+        };
+        t[i] = SZXY[i] | parity;
+        i += 1;
+    }
+    t
+};
+
+/// INC flags (everything but C) indexed by the value before increment.
+const INC_FLAGS: [u8; 256] = {
+    let mut t = [0u8; 256];
+    let mut i = 0;
+    while i < 256 {
+        let val = i as u8;
+        let mut f = SZXY[val.wrapping_add(1) as usize];
+        if val & 0x0F == 0x0F {
+            f |= Flag::H as u8;
+        }
+        if val == 0x7F {
+            f |= Flag::PV as u8; // Overflow 7F -> 80
+        }
+        t[i] = f;
+        i += 1;
+    }
+    t
+};
+
+/// DEC flags (everything but C) indexed by the value before decrement.
+const DEC_FLAGS: [u8; 256] = {
+    let mut t = [0u8; 256];
+    let mut i = 0;
+    while i < 256 {
+        let val = i as u8;
+        let mut f = SZXY[val.wrapping_sub(1) as usize] | Flag::N as u8;
+        if val & 0x0F == 0 {
+            f |= Flag::H as u8; // Borrow from bit 4
+        }
+        if val == 0x80 {
+            f |= Flag::PV as u8; // Overflow 80 -> 7F
+        }
+        t[i] = f;
+        i += 1;
+    }
+    t
+};
+
 impl Z80 {
     // --- Flag Helpers ---
 
+    #[inline]
     pub(super) fn get_parity(val: u8) -> bool {
-        val.count_ones().is_multiple_of(2)
+        SZXYP[val as usize] & Flag::PV as u8 != 0
     }
 
     fn update_flags_logic(&mut self, result: u8, is_and: bool) {
-        let mut f = 0;
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if Self::get_parity(result) {
-            f |= Flag::PV as u8;
-        }
-        if is_and {
-            f |= Flag::H as u8;
-        } // AND sets H, others clear it
-        // N is 0, C is 0
-
-        // Undocumented X/Y
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
-        self.f = f;
+        // AND sets H, others clear it; N and C are 0
+        self.f = SZXYP[result as usize] | ((is_and as u8) << 4);
         self.q = self.f;
     }
 
+    // ADD/SUB: H is bit 4 of a ^ val ^ result (the carry into bit 4), C is
+    // bit 8 of the 9-bit result, and the overflow term's bit 7 is shifted
+    // down to PV. S/Z/X/Y come from the table.
+
     fn do_add(&mut self, val: u8, carry_in: bool) {
         let a = self.a;
-        let c_val = if carry_in && (self.f & Flag::C as u8) != 0 {
-            1
-        } else {
-            0
-        };
+        let c_val = (carry_in as u8) & (self.f & Flag::C as u8);
         let result_u16 = (a as u16) + (val as u16) + (c_val as u16);
         let result = result_u16 as u8;
 
-        let mut f = 0;
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if ((a & 0xF) + (val & 0xF) + (c_val as u8)) > 0xF {
-            f |= Flag::H as u8;
-        }
-        if ((a ^ result) & (val ^ result) & 0x80) != 0 {
-            f |= Flag::PV as u8;
-        }
-        if result_u16 > 0xFF {
-            f |= Flag::C as u8;
-        }
-
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
+        let overflow = ((a ^ result) & (val ^ result) & 0x80) >> 5;
         self.a = result;
-        self.f = f;
+        self.f = SZXY[result as usize]
+            | ((a ^ val ^ result) & Flag::H as u8)
+            | overflow
+            | (result_u16 >> 8) as u8;
         self.q = self.f;
     }
 
     fn do_sub(&mut self, val: u8, carry_in: bool) {
         let a = self.a;
-        let c_val = if carry_in && (self.f & Flag::C as u8) != 0 {
-            1
-        } else {
-            0
-        };
+        let c_val = (carry_in as u8) & (self.f & Flag::C as u8);
         let result_u16 = (a as u16)
             .wrapping_sub(val as u16)
             .wrapping_sub(c_val as u16);
         let result = result_u16 as u8;
 
-        let mut f = Flag::N as u8;
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if (a & 0xF) < ((val & 0xF) + (c_val as u8)) {
-            f |= Flag::H as u8;
-        }
-        if ((a ^ val) & (a ^ result) & 0x80) != 0 {
-            f |= Flag::PV as u8;
-        }
-        if result_u16 > 0xFF {
-            f |= Flag::C as u8;
-        }
-
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
+        let overflow = ((a ^ val) & (a ^ result) & 0x80) >> 5;
         self.a = result;
-        self.f = f;
+        self.f = SZXY[result as usize]
+            | Flag::N as u8
+            | ((a ^ val ^ result) & Flag::H as u8)
+            | overflow
+            | ((result_u16 >> 8) as u8 & Flag::C as u8);
         self.q = self.f;
     }
 
@@ -103,26 +131,14 @@ impl Z80 {
         let result_u16 = (a as u16).wrapping_sub(val as u16);
         let result = result_u16 as u8;
 
-        let mut f = Flag::N as u8;
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if (a & 0xF) < (val & 0xF) {
-            f |= Flag::H as u8;
-        }
-        if ((a ^ val) & (a ^ result) & 0x80) != 0 {
-            f |= Flag::PV as u8;
-        }
-        if result_u16 > 0xFF {
-            f |= Flag::C as u8;
-        }
-
+        let overflow = ((a ^ val) & (a ^ result) & 0x80) >> 5;
         // X/Y come from the operand for CP, not the result
-        f |= val & (Flag::X as u8 | Flag::Y as u8);
-        self.f = f;
+        self.f = (SZXY[result as usize] & !XY)
+            | (val & XY)
+            | Flag::N as u8
+            | ((a ^ val ^ result) & Flag::H as u8)
+            | overflow
+            | ((result_u16 >> 8) as u8 & Flag::C as u8);
         self.q = self.f;
     }
 
@@ -348,46 +364,15 @@ impl Z80 {
     }
 
     fn calc_inc_flags(&mut self, val: u8) -> u8 {
-        let result = val.wrapping_add(1);
-        let mut f = self.f & Flag::C as u8; // Preserve C
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if (val & 0xF) == 0xF {
-            f |= Flag::H as u8;
-        }
-        if val == 0x7F {
-            f |= Flag::PV as u8;
-        } // Overflow 7F -> 80
-        // N is 0
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
-        self.f = f;
+        self.f = (self.f & Flag::C as u8) | INC_FLAGS[val as usize]; // Preserve C
         self.q = self.f;
-        result
+        val.wrapping_add(1)
     }
 
     fn calc_dec_flags(&mut self, val: u8) -> u8 {
-        let result = val.wrapping_sub(1);
-        let mut f = (self.f & Flag::C as u8) | Flag::N as u8; // Preserve C, Set N
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if (val & 0xF) == 0x0 {
-            f |= Flag::H as u8;
-        } // Borrow from bit 4
-        if val == 0x80 {
-            f |= Flag::PV as u8;
-        } // Overflow 80 -> 7F
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
-        self.f = f;
+        self.f = (self.f & Flag::C as u8) | DEC_FLAGS[val as usize]; // Preserve C
         self.q = self.f;
-        result
+        val.wrapping_sub(1)
     }
 
     // --- 16-bit ALU ---
@@ -560,27 +545,7 @@ impl Z80 {
         };
 
         self.a = result;
-        let mut f = 0;
-        if new_c {
-            f |= Flag::C as u8;
-        }
-        if n {
-            f |= Flag::N as u8;
-        }
-        if new_h {
-            f |= Flag::H as u8;
-        }
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if Self::get_parity(result) {
-            f |= Flag::PV as u8;
-        }
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
-        self.f = f;
+        self.f = SZXYP[result as usize] | (new_c as u8) | ((n as u8) << 1) | ((new_h as u8) << 4);
         self.q = self.f;
         self.state = ExecState::Fetch;
     }
@@ -792,18 +757,7 @@ impl Z80 {
                 self.memptr = self.temp_addr.wrapping_add(1);
 
                 // Flags from A: S, Z, PV(parity), H=0, N=0, C preserved, X/Y from A
-                let mut f = self.f & Flag::C as u8;
-                if self.a == 0 {
-                    f |= Flag::Z as u8;
-                }
-                if (self.a & 0x80) != 0 {
-                    f |= Flag::S as u8;
-                }
-                if Self::get_parity(self.a) {
-                    f |= Flag::PV as u8;
-                }
-                f |= self.a & (Flag::X as u8 | Flag::Y as u8);
-                self.f = f;
+                self.f = (self.f & Flag::C as u8) | SZXYP[self.a as usize];
                 self.q = self.f;
                 self.state = ExecState::ExecuteED(opcode, 4);
             }
@@ -842,18 +796,7 @@ impl Z80 {
                 self.temp_data = new_mem;
                 self.memptr = self.temp_addr.wrapping_add(1);
 
-                let mut f = self.f & Flag::C as u8;
-                if self.a == 0 {
-                    f |= Flag::Z as u8;
-                }
-                if (self.a & 0x80) != 0 {
-                    f |= Flag::S as u8;
-                }
-                if Self::get_parity(self.a) {
-                    f |= Flag::PV as u8;
-                }
-                f |= self.a & (Flag::X as u8 | Flag::Y as u8);
-                self.f = f;
+                self.f = (self.f & Flag::C as u8) | SZXYP[self.a as usize];
                 self.q = self.f;
                 self.state = ExecState::ExecuteED(opcode, 4);
             }
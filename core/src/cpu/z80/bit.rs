@@ -1,4 +1,5 @@
 use crate::core::{Bus, BusMaster};
+use crate::cpu::z80::alu::SZXYP;
 use crate::cpu::z80::{ExecState, Flag, Z80};
 
 impl Z80 {
@@ -56,23 +57,8 @@ impl Z80 {
             _ => unreachable!(),
         };
 
-        let mut f = 0;
-        if result == 0 {
-            f |= Flag::Z as u8;
-        }
-        if (result & 0x80) != 0 {
-            f |= Flag::S as u8;
-        }
-        if Self::get_parity(result) {
-            f |= Flag::PV as u8;
-        }
-        if carry != 0 {
-            f |= Flag::C as u8;
-        }
         // H = 0, N = 0
-        f |= result & (Flag::X as u8 | Flag::Y as u8);
-
-        (result, f)
+        (result, SZXYP[result as usize] | (carry & Flag::C as u8))
     }
 
     /// Execute CB-prefixed instruction.
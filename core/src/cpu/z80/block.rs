@@ -59,6 +59,26 @@ impl Z80 {
     /// Like LDI/LDD but repeats while BC != 0.
     /// H=0, N=0, PV=0 (always terminates with BC=0), C preserved. S, Z preserved.
     /// 9 handler cycles when done, 14 when repeating (extra 5T for PC -= 2).
+    ///
+    /// Bulk path: at the start of a run with maskable interrupts disabled,
+    /// the remaining BC-1 repeating bytes are offered to `Bus::block_copy`.
+    /// If the bus accepts, those iterations skip their read/write but still
+    /// step every T-state, so timing, registers and flags stay exact. The
+    /// final iteration always goes through the bus (its X/Y flags depend on
+    /// the byte). The credit is saved with the CPU, so a save/load mid-run
+    /// carries on where it left off.
+    ///
+    /// The accepted bytes land in memory ahead of their own iterations, so
+    /// nothing else may look at them mid-run: the bus only accepts
+    /// destinations no other device reads (see `Bus::block_copy`), and with
+    /// IFF1 clear no maskable interrupt handler can run before the copy
+    /// completes. An NMI drops the credit and the resumed loop rewrites the
+    /// remaining bytes through the bus. That is only sound while no byte
+    /// written ahead is one a later iteration still has to read, so the
+    /// bulk path is skipped when the destination trails the source within
+    /// the run (e.g. LDIR with HL = DE + 1). The fill idiom (DE = HL + 1)
+    /// writes only bytes that have already been read and stays on the bulk
+    /// path.
     pub fn op_ldir_lddr<B: Bus<Address = u16, Data = u8> + ?Sized>(
         &mut self,
         opcode: u8,
@@ -70,11 +90,26 @@ impl Z80 {
         match cycle {
             0 | 2 | 4 | 5 | 7 => self.state = ExecState::ExecuteED(opcode, cycle + 1),
             1 => {
-                self.temp_data = bus.read(master, self.get_hl());
+                let bc = self.get_bc();
+                if self.block_credit == 0
+                    && bc > 1
+                    && !self.iff1
+                    && !writes_ahead_of_reads(self.get_hl(), self.get_de(), bc - 1, dec)
+                    && bus.block_copy(master, self.get_hl(), self.get_de(), bc as u32 - 1, dec)
+                {
+                    self.block_credit = bc - 1;
+                }
+                if self.block_credit == 0 {
+                    self.temp_data = bus.read(master, self.get_hl());
+                }
                 self.state = ExecState::ExecuteED(opcode, 2);
             }
             3 => {
-                bus.write(master, self.get_de(), self.temp_data);
+                if self.block_credit == 0 {
+                    bus.write(master, self.get_de(), self.temp_data);
+                } else {
+                    self.block_credit -= 1;
+                }
                 self.state = ExecState::ExecuteED(opcode, 4);
             }
             6 => {
@@ -543,3 +578,15 @@ impl Z80 {
         }
     }
 }
+
+/// Whether copying `n` bytes from `hl` to `de` in one go would overwrite a
+/// source byte before its own iteration reads it: the destination trails
+/// the source by fewer than `n` bytes in the direction of travel.
+fn writes_ahead_of_reads(hl: u16, de: u16, n: u16, dec: bool) -> bool {
+    let trail = if dec {
+        de.wrapping_sub(hl)
+    } else {
+        hl.wrapping_sub(de)
+    };
+    trail != 0 && trail < n
+}
@@ -1,4 +1,5 @@
 use crate::core::{Bus, BusMaster};
+use crate::cpu::z80::alu::SZXYP;
 use crate::cpu::z80::{ExecState, Flag, IndexMode, Z80};
 
 impl Z80 {
@@ -673,18 +674,7 @@ impl Z80 {
                     self.set_reg8(r, val);
                 }
                 // Set flags from input value
-                let mut f = self.f & Flag::C as u8;
-                if val == 0 {
-                    f |= Flag::Z as u8;
-                }
-                if (val & 0x80) != 0 {
-                    f |= Flag::S as u8;
-                }
-                if Self::get_parity(val) {
-                    f |= Flag::PV as u8;
-                }
-                f |= val & (Flag::X as u8 | Flag::Y as u8);
-                self.f = f;
+                self.f = (self.f & Flag::C as u8) | SZXYP[val as usize];
                 self.q = self.f;
                 self.memptr = port.wrapping_add(1);
                 self.state = ExecState::Fetch;
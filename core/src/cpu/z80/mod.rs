@@ -6,9 +6,11 @@ pub mod disasm;
 mod load_store;
 mod stack;
 
+use crate::core::save_state::{SaveError, StateReader, StateWriter};
 use crate::core::{Bus, BusMaster, bus::InterruptState, component::BusMasterComponent};
 use crate::cpu::{
     Cpu,
+    idle::{IdleLoop, IdleProbe, IdleRegs},
     state::{CpuStateTrait, Z80State},
 };
 use crate::prelude::Saveable;
@@ -27,7 +29,7 @@ pub enum Flag {
 }
 
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct Z80 {
     // Registers
     pub a: u8,
@@ -69,21 +71,22 @@ pub struct Z80 {
     // Interrupt state
     pub(crate) nmi_previous: bool,
 
-    // Execution temporaries — not saved, reset to defaults on load
-    #[save_skip(default = ExecState::Fetch)]
+    // Execution temporaries — saved so a snapshot taken mid-instruction
+    // resumes exactly where it left off
     pub(crate) state: ExecState,
-    #[save_skip(default)]
     pub(crate) opcode: u8,
-    #[save_skip(default)]
     pub(crate) temp_addr: u16,
-    #[save_skip(default)]
     pub(crate) temp_data: u8,
+    /// LDIR/LDDR iterations whose byte was already moved by `Bus::block_copy`.
+    pub(crate) block_credit: u16,
 
-    // Prefix handling — not saved, reset to defaults on load
-    #[save_skip(default = IndexMode::HL)]
+    // Prefix handling
     pub(crate) index_mode: IndexMode,
-    #[save_skip(default)]
     pub(crate) prefix_pending: bool,
+
+    /// Idle-loop detector (not saved; disarmed on load, keeping `enabled`)
+    #[save_skip(default = self.idle.disarmed())]
+    pub idle: IdleLoop,
 }
 
 #[derive(Clone, Copy, Debug, PartialEq)]
@@ -93,6 +96,26 @@ pub enum IndexMode {
     IY,
 }
 
+impl Saveable for IndexMode {
+    fn save_state(&self, w: &mut StateWriter) {
+        w.write_u8(*self as u8);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        *self = match r.read_u8()? {
+            0 => IndexMode::HL,
+            1 => IndexMode::IX,
+            2 => IndexMode::IY,
+            n => return Err(SaveError::InvalidFormat(format!("Z80 index mode {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        1
+    }
+}
+
 /// Z80 interrupt response type, stored in ExecState::Interrupt.
 #[repr(u8)]
 #[derive(Copy, Clone, Debug, PartialEq)]
@@ -124,6 +147,61 @@ pub(crate) enum ExecState {
     Interrupt(InterruptType, u8),
 }
 
+/// Serialized as a tag byte and two payload bytes, unused payload zero.
+impl Saveable for ExecState {
+    fn save_state(&self, w: &mut StateWriter) {
+        let (tag, a, b) = match *self {
+            ExecState::Fetch => (0, 0, 0),
+            ExecState::FetchRead => (1, 0, 0),
+            ExecState::Execute(op, cycle) => (2, op, cycle),
+            ExecState::PrefixCB(cycle) => (3, cycle, 0),
+            ExecState::ExecuteCB(op, cycle) => (4, op, cycle),
+            ExecState::PrefixED(cycle) => (5, cycle, 0),
+            ExecState::ExecuteED(op, cycle) => (6, op, cycle),
+            ExecState::PrefixIndexCB_ReadOffset(cycle) => (7, cycle, 0),
+            ExecState::PrefixIndexCB_FetchOp(cycle) => (8, cycle, 0),
+            ExecState::ExecuteIndexCB(op, cycle) => (9, op, cycle),
+            ExecState::Interrupt(kind, cycle) => (10, kind as u8, cycle),
+        };
+        w.write_u8(tag);
+        w.write_u8(a);
+        w.write_u8(b);
+    }
+
+    fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
+        let (tag, a, b) = (r.read_u8()?, r.read_u8()?, r.read_u8()?);
+        *self = match tag {
+            0 => ExecState::Fetch,
+            1 => ExecState::FetchRead,
+            2 => ExecState::Execute(a, b),
+            3 => ExecState::PrefixCB(a),
+            4 => ExecState::ExecuteCB(a, b),
+            5 => ExecState::PrefixED(a),
+            6 => ExecState::ExecuteED(a, b),
+            7 => ExecState::PrefixIndexCB_ReadOffset(a),
+            8 => ExecState::PrefixIndexCB_FetchOp(a),
+            9 => ExecState::ExecuteIndexCB(a, b),
+            10 => {
+                let kind = match a {
+                    0 => InterruptType::Nmi,
+                    1 => InterruptType::IrqIm01,
+                    2 => InterruptType::IrqIm2,
+                    n => {
+                        return Err(SaveError::InvalidFormat(format!("Z80 interrupt type {n}")));
+                    }
+                };
+                ExecState::Interrupt(kind, b)
+            }
+            n => return Err(SaveError::InvalidFormat(format!("Z80 exec state {n}"))),
+        };
+        Ok(())
+    }
+
+    fn state_size(&self) -> usize {
+        3
+    }
+}
+
 impl Default for Z80 {
     fn default() -> Self {
         Self::new()
@@ -169,8 +247,10 @@ impl Z80 {
             opcode: 0,
             temp_addr: 0,
             temp_data: 0,
+            block_credit: 0,
             index_mode: IndexMode::HL,
             prefix_pending: false,
+            idle: IdleLoop::new(),
         }
     }
 
@@ -192,8 +272,10 @@ impl Z80 {
         self.nmi_previous = false;
         // Reset execution state machine
         self.state = ExecState::Fetch;
+        self.block_credit = 0;
         self.prefix_pending = false;
         self.index_mode = IndexMode::HL;
+        self.idle.disarm();
     }
 
     // Helpers for 16-bit register access
@@ -353,6 +435,16 @@ impl Z80 {
         bus: &mut B,
         master: BusMaster,
     ) {
+        if self.idle.watching() {
+            let mut probe = IdleProbe::new(bus);
+            self.step(&mut probe, master);
+            self.idle.observe(probe.is_pure());
+        } else {
+            self.step(bus, master);
+        }
+    }
+
+    fn step<B: Bus<Address = u16, Data = u8> + ?Sized>(&mut self, bus: &mut B, master: BusMaster) {
         match self.state {
             ExecState::Fetch => {
                 // Check for interrupts at instruction boundary (not during prefix chains)
@@ -371,6 +463,8 @@ impl Z80 {
                             if self.halted {
                                 self.halted = false;
                             }
+                            self.block_credit = 0;
+                            self.idle.disarm();
                             self.state = ExecState::Interrupt(InterruptType::Nmi, 0);
                             return;
                         }
@@ -380,6 +474,8 @@ impl Z80 {
                             if self.halted {
                                 self.halted = false;
                             }
+                            self.block_credit = 0;
+                            self.idle.disarm();
                             let int_type = if self.im == 2 {
                                 InterruptType::IrqIm2
                             } else {
@@ -391,6 +487,11 @@ impl Z80 {
                     }
                 }
 
+                if !self.prefix_pending && !self.halted && self.idle.boundary(bus, master, self.pc)
+                {
+                    self.idle.sample(self.pc, self.idle_regs(), self.r);
+                }
+
                 // HALT: re-fetch the HALT opcode for a proper 4T NOP cycle.
                 // PC already points past HALT; decrement so FetchRead re-reads
                 // it and increments PC back. This gives correct 4T timing with
@@ -499,6 +600,79 @@ impl Z80 {
         }
     }
 
+    /// Skip whole passes of a confirmed idle loop (see [`crate::cpu::idle`]),
+    /// at most `max_cycles` T-states, leaving the CPU exactly where stepping
+    /// them would (R included). Returns the T-states skipped, 0 if the CPU
+    /// must be stepped.
+    ///
+    /// The caller guarantees that no interrupt line changes within
+    /// `max_cycles` and charges the returned cycles to everything else.
+    pub fn skip_idle<B: Bus<Address = u16, Data = u8> + ?Sized>(
+        &mut self,
+        bus: &mut B,
+        master: BusMaster,
+        max_cycles: u64,
+    ) -> u64 {
+        if !matches!(self.state, ExecState::Fetch)
+            || self.prefix_pending
+            || self.halted
+            || self.ei_delay
+            || self.nmi_previous
+            || self.block_credit != 0
+        {
+            return 0;
+        }
+        let Some((cycles, refreshes)) = self.idle.skip(
+            self.pc,
+            || self.idle_regs(),
+            || bus.check_interrupts(master),
+            max_cycles,
+        ) else {
+            return 0;
+        };
+        self.r = (self.r & 0x80) | (self.r.wrapping_add(refreshes) & 0x7F);
+        cycles
+    }
+
+    /// Registers an idle-loop pass must leave unchanged (all but R, which
+    /// every M1 cycle advances).
+    fn idle_regs(&self) -> IdleRegs {
+        let mut regs = [0; 32];
+        regs[..16].copy_from_slice(&[
+            self.a,
+            self.f,
+            self.b,
+            self.c,
+            self.d,
+            self.e,
+            self.h,
+            self.l,
+            self.a_prime,
+            self.f_prime,
+            self.b_prime,
+            self.c_prime,
+            self.d_prime,
+            self.e_prime,
+            self.h_prime,
+            self.l_prime,
+        ]);
+        for (i, r) in [self.ix, self.iy, self.sp, self.memptr]
+            .into_iter()
+            .enumerate()
+        {
+            regs[16 + i * 2..18 + i * 2].copy_from_slice(&r.to_le_bytes());
+        }
+        regs[24..30].copy_from_slice(&[
+            self.i,
+            self.iff1 as u8,
+            self.iff2 as u8,
+            self.im,
+            self.p as u8,
+            self.q,
+        ]);
+        regs
+    }
+
     /// Interrupt response handler.
     /// The Fetch cycle that detected the interrupt counts as T1, so handler cycles
     /// are T2..Tn: NMI 10 cycles (11T), IRQ IM1 12 cycles (13T), IRQ IM2 18 cycles (19T).
@@ -936,4 +1110,8 @@ impl DebugCpu for Z80 {
     fn debug_disassemble(&self, addr: u16, bytes: &[u8]) -> DisassembledInstruction {
         <Self as crate::cpu::Disassemble>::disassemble(addr, bytes)
     }
+
+    fn set_idle_skip(&mut self, enabled: bool) {
+        self.idle.enabled = enabled;
+    }
 }
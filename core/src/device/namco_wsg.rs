@@ -7,13 +7,19 @@
 //!
 //! Clock: master_clock / 6 / 32 = 96 KHz for 18.432 MHz master.
 //! Register interface: 32 nibble-wide registers written at 0x5040–0x505F.
+//!
+//! Rendering is catch-up: `tick()` only counts CPU clocks, and the counted
+//! interval is synthesized in one batch just before a register write, an
+//! enable change, or an audio drain. A batch steps from one waveform
+//! position change to the next instead of clock by clock, and the output
+//! is identical to rendering every clock.
 
 use crate::audio::AudioResampler;
 use crate::prelude::Saveable;
 
 /// 3-voice Namco WSG wavetable synthesizer.
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct NamcoWsg {
     voices: [WsgVoice; 3],
     sound_regs: [u8; 32],
@@ -26,6 +32,9 @@ pub struct NamcoWsg {
     sound_enabled: bool,
 
     resampler: AudioResampler<i16>,
+
+    /// CPU clocks counted by `tick()` but not yet rendered.
+    pending: u32,
 }
 
 #[derive(Default, Saveable)]
@@ -49,6 +58,10 @@ struct WsgVoice {
 ///   Ours:  freq × 3072000 / 2^(20+5) = freq × 3072000 / 2^25 = freq × 192000 / 2^21
 const F_FRACBITS: u32 = 20;
 
+/// Render at least this often so output never lags a whole frame behind
+/// when nobody drains audio or writes registers.
+const MAX_PENDING: u32 = 1 << 16;
+
 impl NamcoWsg {
     /// Create a new WSG with the given CPU clock rate (e.g., 3_072_000).
     pub fn new(cpu_clock_hz: u64) -> Self {
@@ -62,17 +75,22 @@ impl NamcoWsg {
             waveform_rom: [0; 256],
             sound_enabled: false,
             resampler: AudioResampler::new(cpu_clock_hz, 44_100),
+            pending: 0,
         }
     }
 
     /// Load the waveform PROM data (256 bytes, only low 4 bits of each byte used).
     pub fn load_waveform_rom(&mut self, data: &[u8]) {
+        self.flush();
         let len = data.len().min(256);
         self.waveform_rom[..len].copy_from_slice(&data[..len]);
     }
 
     /// Enable or disable sound output.
     pub fn set_sound_enabled(&mut self, enabled: bool) {
+        if enabled != self.sound_enabled {
+            self.flush();
+        }
         self.sound_enabled = enabled;
     }
 
@@ -96,6 +114,7 @@ impl NamcoWsg {
         if self.sound_regs[offset] == data {
             return;
         }
+        self.flush();
         self.sound_regs[offset] = data;
 
         // Determine which channel this register affects
@@ -138,37 +157,86 @@ impl NamcoWsg {
     ///
     /// The WSG counter advances every 32 CPU clocks on real hardware.
     /// We accumulate at CPU rate — the fractional bits handle the division.
+    #[inline]
     pub fn tick(&mut self) {
-        if !self.sound_enabled {
-            self.resampler.tick(0);
+        self.pending += 1;
+        if self.pending >= MAX_PENDING {
+            self.flush();
+        }
+    }
+
+    /// Advance the WSG by `n` CPU clock cycles at once.
+    ///
+    /// Equivalent to calling [`tick`](Self::tick) `n` times; boards that run
+    /// the CPU ahead use this to catch the WSG up before a register write.
+    #[inline]
+    pub fn tick_n(&mut self, n: u32) {
+        self.pending += n;
+        if self.pending >= MAX_PENDING {
+            self.flush();
+        }
+    }
+
+    /// Render every clock counted since the last flush.
+    fn flush(&mut self) {
+        let n = std::mem::take(&mut self.pending);
+        self.render(n);
+    }
+
+    /// Synthesize `n` CPU clocks of output with the current registers.
+    fn render(&mut self, mut n: u32) {
+        if !self.sound_enabled || self.voices.iter().all(|v| v.volume == 0) {
+            self.resampler.tick_n(0, n as u64);
             return;
         }
 
-        // Sum contributions from all voices
-        let mut mixed: i32 = 0;
-        for voice in &mut self.voices {
-            if voice.volume == 0 {
-                continue;
-            }
+        const FRAC_MASK: u32 = (1 << F_FRACBITS) - 1;
+        while n > 0 {
+            // Advance each audible voice by one clock and mix. `run` is the
+            // number of clocks before any voice reaches its next waveform
+            // position, i.e. how long this mixed value holds.
+            let mut mixed: i32 = 0;
+            let mut run = n;
+            for voice in &mut self.voices {
+                if voice.volume == 0 {
+                    continue;
+                }
 
-            // Advance counter by frequency
-            voice.counter = voice.counter.wrapping_add(voice.frequency);
+                // Advance counter by frequency
+                voice.counter = voice.counter.wrapping_add(voice.frequency);
 
-            // Look up waveform sample (4-bit signed: 0-15 mapped to -8..+7)
-            let pos = ((voice.counter >> F_FRACBITS) & 0x1F) as usize;
-            let wave_offset = (voice.waveform_select as usize) * 32 + pos;
-            let sample = (self.waveform_rom[wave_offset] & 0x0F) as i32 - 8;
+                // Look up waveform sample (4-bit signed: 0-15 mapped to -8..+7)
+                let pos = ((voice.counter >> F_FRACBITS) & 0x1F) as usize;
+                let wave_offset = (voice.waveform_select as usize) * 32 + pos;
+                let sample = (self.waveform_rom[wave_offset] & 0x0F) as i32 - 8;
 
-            mixed += sample * voice.volume as i32;
-        }
+                mixed += sample * voice.volume as i32;
 
-        // Scale to i16 range. Each voice max: 7 * 15 = 105. Three voices: 315.
-        // Scale so max output uses ~75% of i16 range.
-        self.resampler.tick((mixed * 80) as i16);
+                if voice.frequency != 0 {
+                    let hold = (FRAC_MASK - (voice.counter & FRAC_MASK)) / voice.frequency;
+                    run = run.min(1 + hold);
+                }
+            }
+
+            // Move the counters over the rest of the run
+            for voice in &mut self.voices {
+                if voice.volume != 0 {
+                    voice.counter = voice
+                        .counter
+                        .wrapping_add(voice.frequency.wrapping_mul(run - 1));
+                }
+            }
+
+            // Scale to i16 range. Each voice max: 7 * 15 = 105. Three voices: 315.
+            // Scale so max output uses ~75% of i16 range.
+            self.resampler.tick_n((mixed * 80) as i16, run as u64);
+            n -= run;
+        }
     }
 
     /// Drain audio samples into the provided buffer. Returns number of samples written.
     pub fn fill_audio(&mut self, buffer: &mut [i16]) -> usize {
+        self.flush();
         self.resampler.fill_audio(buffer)
     }
 
@@ -183,6 +251,7 @@ impl NamcoWsg {
         self.sound_regs = [0; 32];
         self.sound_enabled = false;
         self.resampler.reset();
+        self.pending = 0;
     }
 }
 
@@ -259,3 +328,53 @@ impl Debuggable for NamcoWsg {
         ]
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn voiced_wsg() -> NamcoWsg {
+        let mut wsg = NamcoWsg::new(3_072_000);
+        let rom: Vec<u8> = (0..=255u8).map(|i| i.wrapping_mul(7) ^ (i >> 3)).collect();
+        wsg.load_waveform_rom(&rom);
+        wsg.set_sound_enabled(true);
+        // Ch 0: wave 2, mid frequency; ch 1: wave 5, high frequency
+        for (offset, data) in [(0x05, 2), (0x13, 0x3), (0x15, 0xF), (0x0A, 5), (0x18, 0xA)] {
+            wsg.write(offset, data);
+        }
+        wsg.write(0x1A, 0x9);
+        wsg
+    }
+
+    /// Batched rendering must match rendering every clock on its own,
+    /// across register writes and a silent stretch.
+    #[test]
+    fn batch_render_matches_per_clock() {
+        let mut batched = voiced_wsg();
+        let mut stepped = voiced_wsg();
+        let script = [
+            (12_345, 0x1B, 0x7),
+            (12_345, 0x1F, 0x4),
+            (30_000, 0x15, 0),
+            (41_000, 0x15, 0x3),
+        ];
+
+        for clock in 0..100_000u32 {
+            for &(_, offset, data) in script.iter().filter(|(at, ..)| *at == clock) {
+                batched.write(offset, data);
+                stepped.write(offset, data);
+            }
+            batched.tick();
+            stepped.tick();
+            stepped.flush();
+        }
+
+        let mut a = vec![0i16; 4096];
+        let mut b = vec![0i16; 4096];
+        let na = batched.fill_audio(&mut a);
+        let nb = stepped.fill_audio(&mut b);
+        assert_eq!(na, nb);
+        assert_eq!(a[..na], b[..nb]);
+        assert!(a[..na].iter().any(|&s| s != 0));
+    }
+}
@@ -44,6 +44,11 @@ pub struct Pia6820 {
 
     // Write notification (for inter-board communication)
     port_b_written: bool, // Set when CPU writes to Port B data register
+
+    // Output notification (for boards caching the interrupt lines). Not
+    // saved: set on load so the board re-reads both lines.
+    #[save_skip(default = true)]
+    irq_changed: bool, // Set when IRQA or IRQB changes level
 }
 
 impl Pia6820 {
@@ -71,6 +76,8 @@ impl Pia6820 {
             cb2: false,
 
             port_b_written: false,
+
+            irq_changed: true,
         }
     }
 
@@ -87,6 +94,13 @@ impl Pia6820 {
     ///
     /// Reading a data port clears both IRQ flags for that side.
     pub fn read(&mut self, offset: u16) -> u8 {
+        let before = self.irq_lines();
+        let data = self.read_register(offset);
+        self.note_irq_lines(before);
+        data
+    }
+
+    fn read_register(&mut self, offset: u16) -> u8 {
         match offset & 0x03 {
             0 => {
                 if (self.ctrl_a & 0x04) != 0 {
@@ -127,6 +141,12 @@ impl Pia6820 {
     /// Writing to a control register only affects bits 5:0 (bits 7:6 are
     /// read-only interrupt flags).
     pub fn write(&mut self, offset: u16, data: u8) {
+        let before = self.irq_lines();
+        self.write_register(offset, data);
+        self.note_irq_lines(before);
+    }
+
+    fn write_register(&mut self, offset: u16, data: u8) {
         match offset & 0x03 {
             0 => {
                 if (self.ctrl_a & 0x04) != 0 {
@@ -175,7 +195,9 @@ impl Pia6820 {
 
         let trigger_on_rising = (self.ctrl_a & 0x02) != 0;
         if (trigger_on_rising && rising) || (!trigger_on_rising && falling) {
+            let before = self.irq_lines();
             self.irq_a1 = true;
+            self.note_irq_lines(before);
         }
     }
 
@@ -191,7 +213,9 @@ impl Pia6820 {
 
         let trigger_on_rising = (self.ctrl_b & 0x02) != 0;
         if (trigger_on_rising && rising) || (!trigger_on_rising && falling) {
+            let before = self.irq_lines();
             self.irq_b1 = true;
+            self.note_irq_lines(before);
         }
     }
 
@@ -212,7 +236,9 @@ impl Pia6820 {
 
         let trigger_on_rising = (self.ctrl_a & 0x10) != 0;
         if (trigger_on_rising && rising) || (!trigger_on_rising && falling) {
+            let before = self.irq_lines();
             self.irq_a2 = true;
+            self.note_irq_lines(before);
         }
     }
 
@@ -233,7 +259,9 @@ impl Pia6820 {
 
         let trigger_on_rising = (self.ctrl_b & 0x10) != 0;
         if (trigger_on_rising && rising) || (!trigger_on_rising && falling) {
+            let before = self.irq_lines();
             self.irq_b2 = true;
+            self.note_irq_lines(before);
         }
     }
 
@@ -259,6 +287,29 @@ impl Pia6820 {
         b1_active || b2_active
     }
 
+    fn irq_lines(&self) -> (bool, bool) {
+        (self.irq_a(), self.irq_b())
+    }
+
+    fn note_irq_lines(&mut self, before: (bool, bool)) {
+        if self.irq_lines() != before {
+            self.irq_changed = true;
+        }
+    }
+
+    /// Check if IRQA or IRQB changed level since last check.
+    /// Clears the flag after reading (one-shot notification).
+    ///
+    /// Lets a board cache the CPU interrupt lines the PIA drives and
+    /// recompute them only when this returns true, instead of querying
+    /// `irq_a()`/`irq_b()` on every instruction fetch. Also true after
+    /// reset and state load.
+    pub fn take_irq_changed(&mut self) -> bool {
+        let changed = self.irq_changed;
+        self.irq_changed = false;
+        changed
+    }
+
     /// Read the current output value of Port A (ORA masked by DDRA).
     ///
     /// Returns only the bits the CPU is actively driving (DDR=1).
@@ -322,6 +373,7 @@ impl Pia6820 {
         self.cb1 = false;
         self.cb2 = false;
         self.port_b_written = false;
+        self.irq_changed = true;
     }
 }
 
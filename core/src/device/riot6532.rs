@@ -3,6 +3,11 @@
 //! 128 bytes of static RAM, two 8-bit bidirectional I/O ports with data
 //! direction registers, a programmable interval timer with 4 prescaler
 //! options, and PA7 edge detection with interrupt generation.
+//!
+//! The interval timer is counted lazily: `tick()` only counts clocks
+//! against the precomputed clock of the next underflow, and the timer and
+//! prescaler are brought up to date when that clock arrives or when the
+//! CPU touches the timer registers.
 
 use phosphor_macros::Saveable;
 
@@ -10,7 +15,7 @@ use phosphor_macros::Saveable;
 const PRESCALE_SHIFT: [u8; 4] = [0, 3, 6, 10];
 
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct Riot6532 {
     // 128 bytes of internal RAM
     ram: [u8; 128],
@@ -30,6 +35,8 @@ pub struct Riot6532 {
     prescale_shift: u8,
     prescale_counter: u16,
     timer_running: bool, // false after underflow (counts at ÷1)
+    elapsed: u32,        // clocks not yet applied to timer/prescale_counter
+    next_event: u32,     // value of `elapsed` at the next underflow (u32::MAX = none)
 
     // Interrupt state
     ie_timer: bool,
@@ -40,6 +47,11 @@ pub struct Riot6532 {
     // PA7 edge detection
     pa7_dir: bool,  // true = positive edge, false = negative edge
     pa7_prev: bool, // previous PA7 state
+
+    // Set when the IRQ output changes level; taken by the board. Not
+    // saved: set on load so the board re-reads the line.
+    #[save_skip(default = true)]
+    irq_changed: bool,
 }
 
 impl Default for Riot6532 {
@@ -62,12 +74,15 @@ impl Riot6532 {
             prescale_shift: 10, // ÷1024 default
             prescale_counter: 0,
             timer_running: false,
+            elapsed: 0,
+            next_event: u32::MAX,
             ie_timer: false,
             irq_timer: false,
             ie_edge: false,
             irq_edge: false,
             pa7_dir: false,
             pa7_prev: false,
+            irq_changed: true,
         }
     }
 
@@ -83,8 +98,13 @@ impl Riot6532 {
 
     /// Read from the RIOT I/O register space (offset 0x00-0x1F).
     pub fn read_io(&mut self, offset: u8) -> u8 {
-        let offset = offset & 0x1F;
+        let before = self.irq_active();
+        let data = self.read_register(offset & 0x1F);
+        self.note_irq(before);
+        data
+    }
 
+    fn read_register(&mut self, offset: u8) -> u8 {
         // Bit 2 (A2) distinguishes port registers from timer/IRQ
         if offset & 0x04 == 0 {
             // Port registers: A2=0
@@ -107,6 +127,7 @@ impl Riot6532 {
             if offset & 0x01 == 0 {
                 // Read timer (even offsets: 0x04, 0x06, 0x0C, 0x0E, 0x14, 0x16, 0x1C, 0x1E)
                 // Bit 3 (A3): 0=disable timer IRQ, 1=enable timer IRQ
+                self.sync();
                 self.ie_timer = offset & 0x08 != 0;
                 self.irq_timer = false;
                 self.timer
@@ -123,8 +144,12 @@ impl Riot6532 {
 
     /// Write to the RIOT I/O register space (offset 0x00-0x1F).
     pub fn write_io(&mut self, offset: u8, data: u8) {
-        let offset = offset & 0x1F;
+        let before = self.irq_active();
+        self.write_register(offset & 0x1F, data);
+        self.note_irq(before);
+    }
 
+    fn write_register(&mut self, offset: u8, data: u8) {
         // Bit 2 (A2) distinguishes port registers from timer/edge
         if offset & 0x04 == 0 {
             // Port registers: A2=0
@@ -157,29 +182,72 @@ impl Riot6532 {
             self.prescale_counter = 0;
             self.timer_running = true;
             self.irq_timer = false;
+            self.elapsed = 0;
+            self.schedule();
         }
     }
 
     /// Advance the timer by one clock tick. Call at the RIOT's clock rate.
+    #[inline]
     pub fn tick(&mut self) {
+        self.elapsed += 1;
+        if self.elapsed >= self.next_event {
+            self.sync();
+        }
+    }
+
+    /// Clocks from the last sync until the prescaled countdown underflows.
+    fn clocks_to_underflow(&self) -> u32 {
+        let period = 1u32 << self.prescale_shift;
+        (period - self.prescale_counter as u32) + self.timer as u32 * period
+    }
+
+    fn schedule(&mut self) {
+        self.next_event = if self.timer_running {
+            self.clocks_to_underflow()
+        } else {
+            u32::MAX
+        };
+    }
+
+    /// Timer value including clocks not yet applied.
+    fn current_timer(&self) -> u8 {
         if self.timer_running {
-            // Prescaled countdown
-            self.prescale_counter += 1;
-            if self.prescale_counter >= (1u16 << self.prescale_shift) {
-                self.prescale_counter = 0;
-                if self.timer == 0 {
-                    // Underflow: set IRQ, switch to ÷1 mode
-                    self.irq_timer = true;
-                    self.timer_running = false;
-                    self.timer = 0xFF;
-                } else {
-                    self.timer -= 1;
+            let steps = (self.prescale_counter as u32 + self.elapsed) >> self.prescale_shift;
+            self.timer - steps as u8
+        } else {
+            // After underflow: count down at ÷1 rate (spinning)
+            self.timer.wrapping_sub(self.elapsed as u8)
+        }
+    }
+
+    /// Apply the clocks counted since the last sync. Never runs past the
+    /// next underflow, which therefore lands on its exact clock.
+    fn sync(&mut self) {
+        let n = self.elapsed;
+        if n == 0 {
+            return;
+        }
+        self.elapsed = 0;
+        if self.timer_running {
+            let total = self.prescale_counter as u32 + n;
+            let steps = total >> self.prescale_shift;
+            self.prescale_counter = (total & ((1 << self.prescale_shift) - 1)) as u16;
+            if steps > self.timer as u32 {
+                // Underflow: set IRQ, switch to ÷1 mode
+                if self.ie_timer && !self.irq_timer {
+                    self.irq_changed = true;
                 }
+                self.irq_timer = true;
+                self.timer_running = false;
+                self.timer = 0xFF;
+            } else {
+                self.timer -= steps as u8;
             }
         } else {
-            // After underflow: count down at ÷1 rate (spinning)
-            self.timer = self.timer.wrapping_sub(1);
+            self.timer = self.timer.wrapping_sub(n as u8);
         }
+        self.schedule();
     }
 
     /// Set external input on Port A (bits driven by external hardware).
@@ -219,6 +287,22 @@ impl Riot6532 {
         (self.ie_timer && self.irq_timer) || (self.ie_edge && self.irq_edge)
     }
 
+    /// Check if the IRQ output changed level since the last call, and
+    /// clear the notification. Lets a board cache the CPU's IRQ line and
+    /// refresh it only when this returns true. Also true after reset and
+    /// state load.
+    pub fn take_irq_changed(&mut self) -> bool {
+        let changed = self.irq_changed;
+        self.irq_changed = false;
+        changed
+    }
+
+    fn note_irq(&mut self, before: bool) {
+        if self.irq_active() != before {
+            self.irq_changed = true;
+        }
+    }
+
     /// Update PA7 edge detection after any change to PA.
     fn update_pa7(&mut self) {
         let pa_data = (self.pa_out & self.pa_ddr) | (self.pa_in & !self.pa_ddr);
@@ -226,6 +310,9 @@ impl Riot6532 {
 
         // Detect edge: state changed AND matches configured direction
         if pa7 != self.pa7_prev && pa7 == self.pa7_dir {
+            if self.ie_edge && !self.irq_edge {
+                self.irq_changed = true;
+            }
             self.irq_edge = true;
         }
         self.pa7_prev = pa7;
@@ -240,12 +327,15 @@ impl Riot6532 {
         self.prescale_shift = 10;
         self.prescale_counter = 0;
         self.timer_running = false;
+        self.elapsed = 0;
+        self.next_event = u32::MAX;
         self.ie_timer = false;
         self.irq_timer = false;
         self.ie_edge = false;
         self.irq_edge = false;
         self.pa7_dir = false;
         self.pa7_prev = false;
+        self.irq_changed = true;
         // RAM is not cleared on reset
     }
 }
@@ -299,7 +389,7 @@ impl Debuggable for Riot6532 {
             },
             DebugRegister {
                 name: "TIMER",
-                value: self.timer as u64,
+                value: self.current_timer() as u64,
                 width: 8,
             },
             DebugRegister {
@@ -357,20 +447,20 @@ mod tests {
         let mut riot = Riot6532::new();
         // Write timer with ÷1 prescaler (offset 0x14, A0-A1=00)
         riot.write_io(0x14, 3); // Count down from 3
-        assert_eq!(riot.timer, 3);
+        assert_eq!(riot.current_timer(), 3);
         assert!(riot.timer_running);
 
         riot.tick(); // 3→2
-        assert_eq!(riot.timer, 2);
+        assert_eq!(riot.current_timer(), 2);
         riot.tick(); // 2→1
-        assert_eq!(riot.timer, 1);
+        assert_eq!(riot.current_timer(), 1);
         riot.tick(); // 1→0
-        assert_eq!(riot.timer, 0);
+        assert_eq!(riot.current_timer(), 0);
         assert!(!riot.irq_timer);
         riot.tick(); // 0→underflow
         assert!(riot.irq_timer);
         assert!(!riot.timer_running);
-        assert_eq!(riot.timer, 0xFF);
+        assert_eq!(riot.current_timer(), 0xFF);
     }
 
     #[test]
@@ -384,7 +474,7 @@ mod tests {
             assert!(!riot.irq_timer);
             riot.tick();
         }
-        assert_eq!(riot.timer, 0);
+        assert_eq!(riot.current_timer(), 0);
 
         // 8 more ticks for underflow (0→underflow)
         for _ in 0..8 {
@@ -466,6 +556,44 @@ mod tests {
         assert!(riot.irq_active());
     }
 
+    /// The change notification fires exactly when `irq_active()` flips,
+    /// whether by timer underflow, PA7 edge, or register access.
+    #[test]
+    fn irq_changed_follows_irq_output() {
+        let mut riot = Riot6532::new();
+        assert!(riot.take_irq_changed()); // Initial level reported once
+        let mut level = riot.irq_active();
+        fn check(riot: &mut Riot6532, level: &mut bool, step: &str) {
+            let now = riot.irq_active();
+            assert_eq!(riot.take_irq_changed(), now != *level, "{step}");
+            *level = now;
+        }
+
+        riot.write_io(0x1C, 2); // Timer ÷1, IRQ enabled
+        check(&mut riot, &mut level, "timer write");
+        for i in 0..5 {
+            riot.tick();
+            check(&mut riot, &mut level, &format!("tick {i}"));
+        }
+        assert!(level); // Underflowed
+        riot.read_io(0x05); // Flags read leaves the timer flag
+        check(&mut riot, &mut level, "flags read");
+        riot.read_io(0x04); // Timer read clears it and disables IE
+        check(&mut riot, &mut level, "timer read");
+        assert!(!level);
+
+        riot.write_io(0x07, 0); // PA7 positive edge, IRQ enabled
+        check(&mut riot, &mut level, "edge config");
+        riot.set_pa_input(0x00);
+        check(&mut riot, &mut level, "PA7 low");
+        riot.set_pa_input(0x80);
+        check(&mut riot, &mut level, "PA7 high");
+        assert!(level);
+        riot.read_io(0x05);
+        check(&mut riot, &mut level, "edge flag read");
+        assert!(!level);
+    }
+
     #[test]
     fn masked_pa_input() {
         let mut riot = Riot6532::new();
@@ -481,7 +609,7 @@ mod tests {
         riot.write_ram(0x10, 0x42);
         riot.reset();
         assert_eq!(riot.read_ram(0x10), 0x42); // RAM preserved
-        assert_eq!(riot.timer, 0xFF); // Timer reset
+        assert_eq!(riot.current_timer(), 0xFF); // Timer reset
         assert!(!riot.irq_timer);
     }
 
@@ -494,8 +622,54 @@ mod tests {
 
         // Spinning: counts down at ÷1 regardless of original prescaler
         riot.tick();
-        assert_eq!(riot.timer, 0xFE);
+        assert_eq!(riot.current_timer(), 0xFE);
         riot.tick();
-        assert_eq!(riot.timer, 0xFD);
+        assert_eq!(riot.current_timer(), 0xFD);
+    }
+
+    /// Lazy counting must match a clock-by-clock model across prescalers,
+    /// underflow, the ÷1 spin afterwards, and a timer read mid-count.
+    #[test]
+    fn lazy_timer_matches_per_clock_model() {
+        for (offset, start) in [(0x14, 5), (0x15, 3), (0x16, 2), (0x1F, 1)] {
+            let mut riot = Riot6532::new();
+            riot.write_io(offset, start);
+            let shift = PRESCALE_SHIFT[(offset & 0x03) as usize];
+            let (mut timer, mut psc, mut running) = (start, 0u32, true);
+            for clock in 0..3000 {
+                riot.tick();
+                if running {
+                    psc += 1;
+                    if psc >= 1 << shift {
+                        psc = 0;
+                        if timer == 0 {
+                            running = false;
+                            timer = 0xFF;
+                        } else {
+                            timer -= 1;
+                        }
+                    }
+                } else {
+                    timer = timer.wrapping_sub(1);
+                }
+                assert_eq!(riot.current_timer(), timer, "{offset:#x} clock {clock}");
+                assert_eq!(riot.irq_timer, !running, "{offset:#x} clock {clock}");
+            }
+            assert!(!running);
+        }
+
+        // A timer read syncs without disturbing the countdown
+        let mut riot = Riot6532::new();
+        riot.write_io(0x15, 4);
+        for _ in 0..13 {
+            riot.tick();
+        }
+        assert_eq!(riot.read_io(0x04), 3);
+        for _ in 0..26 {
+            riot.tick();
+        }
+        assert!(!riot.irq_timer);
+        riot.tick();
+        assert!(riot.irq_timer);
     }
 }
@@ -26,6 +26,14 @@
 //! | 2 | TC_FOLLOWS | Next write is the time constant |
 //! | 1 | RESET | Software reset (stops channel) |
 //! | 0 | CONTROL | Always 1 for control words |
+//!
+//! # Lazy timer counting
+//!
+//! Timer-mode channels are not stepped every clock. `tick()` only counts
+//! elapsed clocks against the precomputed tick of the next zero count; the
+//! channel counters are brought up to date arithmetically when that tick
+//! arrives or when a register access, trigger edge, or read needs them.
+//! Interrupts and ZC/TO pulses still land on the exact clock.
 
 // Control word bit masks
 const CONTROL_WORD: u8 = 0x01;
@@ -41,10 +49,20 @@ use crate::prelude::Saveable;
 
 /// Z80 CTC — 4-channel Counter/Timer Circuit.
 #[derive(Saveable)]
-#[save_version(1)]
+#[save_version(2)]
 pub struct Z80Ctc {
     vector_base: u8,
     channels: [CtcChannel; 4],
+    /// Clocks since the timer channels were last brought up to date.
+    elapsed: u32,
+    /// Value of `elapsed` at which the next timer channel reaches zero
+    /// (`u32::MAX` when no timer is running).
+    next_event: u32,
+    /// Set when the interrupt output (pending or not, and the vector it
+    /// presents) changes; taken by the board. Not saved: set on load so
+    /// the board re-reads the output.
+    #[save_skip(default = true)]
+    irq_changed: bool,
 }
 
 #[derive(Default, Saveable)]
@@ -61,33 +79,105 @@ struct CtcChannel {
     interrupt_pending: bool,
 }
 
+impl CtcChannel {
+    /// Clocks per down-counter decrement in timer mode.
+    fn prescale(&self) -> u32 {
+        if self.control & PRESCALER_256 != 0 {
+            256
+        } else {
+            16
+        }
+    }
+
+    /// True while the channel counts prescaled clocks.
+    fn is_timing(&self) -> bool {
+        self.control & COUNTER_MODE == 0 && self.running
+    }
+
+    /// Clocks until a timing channel next reaches zero count.
+    fn clocks_to_zero(&self) -> u32 {
+        self.prescaler_count as u32 + (self.down_counter as u32 - 1) * self.prescale()
+    }
+
+    /// Down counter value after `n` more clocks (`n` < `clocks_to_zero()`).
+    fn counter_after(&self, n: u32) -> u16 {
+        if n < self.prescaler_count as u32 {
+            return self.down_counter;
+        }
+        let steps = 1 + (n - self.prescaler_count as u32) / self.prescale();
+        self.down_counter - steps as u16
+    }
+
+    /// Apply `n` clocks (`n` <= `clocks_to_zero()`) to a timing channel.
+    /// Reaching zero reloads the counter, raises the interrupt if enabled,
+    /// and emits the ZC/TO pulse.
+    fn advance(&mut self, n: u32) {
+        if n < self.prescaler_count as u32 {
+            self.prescaler_count -= n as u16;
+            return;
+        }
+        let rest = n - self.prescaler_count as u32;
+        let p = self.prescale();
+        self.prescaler_count = (p - rest % p) as u16;
+        self.down_counter -= (1 + rest / p) as u16;
+        if self.down_counter == 0 {
+            self.down_counter = self.time_constant;
+            if self.control & INTERRUPT_EN != 0 {
+                self.interrupt_pending = true;
+            }
+            self.zc_pulse = true;
+        }
+    }
+}
+
 impl Z80Ctc {
     pub fn new() -> Self {
         Self {
             vector_base: 0,
             channels: Default::default(),
+            elapsed: 0,
+            next_event: u32::MAX,
+            irq_changed: true,
         }
     }
 
     /// Read the current down counter value for a channel.
     pub fn read(&self, channel: u8) -> u8 {
-        self.channels[channel as usize & 3].down_counter as u8
+        self.counter(channel as usize & 3) as u8
+    }
+
+    /// Current down counter of a channel, including clocks not yet applied.
+    fn counter(&self, ch_idx: usize) -> u16 {
+        let ch = &self.channels[ch_idx];
+        if ch.is_timing() {
+            ch.counter_after(self.elapsed)
+        } else {
+            ch.down_counter
+        }
     }
 
     /// Write to a CTC channel. Interprets the byte as a time constant,
     /// control word, or vector base depending on channel state.
     pub fn write(&mut self, channel: u8, data: u8) {
-        let ch_idx = channel as usize & 3;
+        let before = self.irq_output();
+        self.write_register(channel as usize & 3, data);
+        self.note_irq(before);
+    }
 
+    fn write_register(&mut self, ch_idx: usize, data: u8) {
         // If waiting for time constant, this byte is the TC value
         if self.channels[ch_idx].waiting_for_tc {
+            self.sync();
             self.load_time_constant(ch_idx, data);
+            self.schedule();
             return;
         }
 
         // Bit 0 = 1: control word
         if data & CONTROL_WORD != 0 {
+            self.sync();
             self.write_control(ch_idx, data);
+            self.schedule();
             return;
         }
 
@@ -101,36 +191,46 @@ impl Z80Ctc {
     ///
     /// After calling tick(), check `zc_output()` to detect zero-count pulses
     /// for cascading (e.g. channel 0 ZC → channel 1 trigger).
+    #[inline]
     pub fn tick(&mut self) {
         // Clear previous ZC pulses
         for ch in &mut self.channels {
             ch.zc_pulse = false;
         }
 
-        for ch in &mut self.channels {
-            // Only process timer-mode channels that are actively running
-            if ch.control & COUNTER_MODE != 0 || !ch.running {
-                continue;
-            }
+        self.elapsed += 1;
+        if self.elapsed >= self.next_event {
+            let before = self.irq_output();
+            self.sync();
+            self.note_irq(before);
+        }
+    }
 
-            ch.prescaler_count -= 1;
-            if ch.prescaler_count == 0 {
-                ch.prescaler_count = if ch.control & PRESCALER_256 != 0 {
-                    256
-                } else {
-                    16
-                };
-
-                ch.down_counter -= 1;
-                if ch.down_counter == 0 {
-                    ch.down_counter = ch.time_constant;
-                    if ch.control & INTERRUPT_EN != 0 {
-                        ch.interrupt_pending = true;
-                    }
-                    ch.zc_pulse = true;
-                }
+    /// Apply the clocks counted since the last sync to every timing channel.
+    fn sync(&mut self) {
+        let n = self.elapsed;
+        if n == 0 {
+            return;
+        }
+        self.elapsed = 0;
+        for ch in &mut self.channels {
+            if ch.is_timing() {
+                ch.advance(n);
             }
         }
+        self.schedule();
+    }
+
+    /// Recompute the clock of the next zero count after a sync or a
+    /// register change.
+    fn schedule(&mut self) {
+        self.next_event = self
+            .channels
+            .iter()
+            .filter(|ch| ch.is_timing())
+            .map(|ch| self.elapsed + ch.clocks_to_zero())
+            .min()
+            .unwrap_or(u32::MAX);
     }
 
     /// Apply an external trigger signal to a channel's CLK/TRG input.
@@ -138,7 +238,13 @@ impl Z80Ctc {
     /// In counter mode, detected edges decrement the counter.
     /// In timer mode (CLK/TRG trigger), the first detected edge starts the timer.
     pub fn trigger(&mut self, channel: u8, state: bool) {
-        let ch_idx = channel as usize & 3;
+        let before = self.irq_output();
+        self.trigger_channel(channel as usize & 3, state);
+        self.note_irq(before);
+    }
+
+    fn trigger_channel(&mut self, ch_idx: usize, state: bool) {
+        self.sync();
         let ch = &mut self.channels[ch_idx];
 
         let prev = ch.trigger_state;
@@ -177,6 +283,7 @@ impl Z80Ctc {
             } else {
                 16
             };
+            self.schedule();
         }
     }
 
@@ -200,11 +307,31 @@ impl Z80Ctc {
 
     /// Acknowledge the highest-priority pending interrupt (clears pending flag).
     pub fn acknowledge_interrupt(&mut self) {
-        for ch in &mut self.channels {
-            if ch.interrupt_pending {
-                ch.interrupt_pending = false;
-                return;
-            }
+        if let Some(ch) = self.channels.iter_mut().find(|ch| ch.interrupt_pending) {
+            ch.interrupt_pending = false;
+            self.irq_changed = true;
+        }
+    }
+
+    /// Check if the interrupt output changed since the last call, and
+    /// clear the notification. A change is a pending interrupt appearing
+    /// or clearing, or a different vector being presented. Lets a board
+    /// cache the CPU's interrupt line and refresh it only when this
+    /// returns true. Also true after reset and state load.
+    pub fn take_irq_changed(&mut self) -> bool {
+        let changed = self.irq_changed;
+        self.irq_changed = false;
+        changed
+    }
+
+    /// The vector presented on the interrupt line, if one is pending.
+    fn irq_output(&self) -> Option<u8> {
+        self.interrupt_pending().then(|| self.interrupt_vector())
+    }
+
+    fn note_irq(&mut self, before: Option<u8>) {
+        if self.irq_output() != before {
+            self.irq_changed = true;
         }
     }
 
@@ -222,6 +349,9 @@ impl Z80Ctc {
             *ch = CtcChannel::default();
         }
         self.vector_base = 0;
+        self.elapsed = 0;
+        self.next_event = u32::MAX;
+        self.irq_changed = true;
     }
 
     // -- Private methods -------------------------------------------------------
@@ -321,7 +451,7 @@ impl Debuggable for Z80Ctc {
             },
             DebugRegister {
                 name: "CTR0",
-                value: self.channels[0].down_counter as u64,
+                value: self.counter(0) as u64,
                 width: 16,
             },
             DebugRegister {
@@ -331,7 +461,7 @@ impl Debuggable for Z80Ctc {
             },
             DebugRegister {
                 name: "CTR1",
-                value: self.channels[1].down_counter as u64,
+                value: self.counter(1) as u64,
                 width: 16,
             },
             DebugRegister {
@@ -341,7 +471,7 @@ impl Debuggable for Z80Ctc {
             },
             DebugRegister {
                 name: "CTR2",
-                value: self.channels[2].down_counter as u64,
+                value: self.counter(2) as u64,
                 width: 16,
             },
             DebugRegister {
@@ -351,7 +481,7 @@ impl Debuggable for Z80Ctc {
             },
             DebugRegister {
                 name: "CTR3",
-                value: self.channels[3].down_counter as u64,
+                value: self.counter(3) as u64,
                 width: 16,
             },
             DebugRegister {
@@ -415,7 +545,7 @@ mod tests {
         for _ in 0..16 {
             ctc.tick();
         }
-        assert_eq!(ctc.channels[0].down_counter, 1);
+        assert_eq!(ctc.read(0), 1);
         assert!(!ctc.interrupt_pending());
 
         // After 16 more ticks, counter 1 → 0 → reload to 2, interrupt fires
@@ -522,6 +652,43 @@ mod tests {
         assert_eq!(ctc.interrupt_vector(), 0xE0 | 4); // 0xE4
     }
 
+    #[test]
+    fn irq_changed_follows_pending_and_vector() {
+        let mut ctc = Z80Ctc::new();
+        assert!(ctc.take_irq_changed()); // Initial state reported once
+        ctc.write(0, 0xE0);
+        assert!(!ctc.take_irq_changed()); // Vector base alone: nothing pending
+
+        // Channel 1 fires after 16 clocks; only the firing tick notifies
+        ctc.write(1, CONTROL_WORD | TC_FOLLOWS | INTERRUPT_EN);
+        ctc.write(1, 1);
+        for _ in 0..15 {
+            ctc.tick();
+            assert!(!ctc.take_irq_changed());
+        }
+        ctc.tick();
+        assert!(ctc.interrupt_pending());
+        assert!(ctc.take_irq_changed());
+
+        // Higher-priority channel 0 pending changes the vector
+        ctc.write(0, CONTROL_WORD | TC_FOLLOWS | COUNTER_MODE | INTERRUPT_EN);
+        ctc.write(0, 1);
+        assert!(!ctc.take_irq_changed());
+        ctc.trigger(0, true);
+        ctc.trigger(0, false);
+        assert_eq!(ctc.interrupt_vector(), 0xE0);
+        assert!(ctc.take_irq_changed());
+
+        // Each acknowledge changes the output
+        ctc.acknowledge_interrupt();
+        assert!(ctc.take_irq_changed());
+        ctc.write(1, CONTROL_WORD | RESET); // Disable: clears channel 1
+        assert!(!ctc.interrupt_pending());
+        assert!(ctc.take_irq_changed());
+        ctc.acknowledge_interrupt();
+        assert!(!ctc.take_irq_changed());
+    }
+
     #[test]
     fn timer_mode_wait_for_trigger() {
         let mut ctc = Z80Ctc::new();
@@ -695,7 +862,7 @@ mod tests {
         assert_eq!(ctc2.vector_base, ctc.vector_base);
         for i in 0..4 {
             assert_eq!(ctc2.channels[i].control, ctc.channels[i].control);
-            assert_eq!(ctc2.channels[i].down_counter, ctc.channels[i].down_counter);
+            assert_eq!(ctc2.read(i as u8), ctc.read(i as u8));
             assert_eq!(ctc2.channels[i].running, ctc.channels[i].running);
             assert_eq!(
                 ctc2.channels[i].prescaler_count,
@@ -703,4 +870,49 @@ mod tests {
             );
         }
     }
+
+    /// Lazy counting must match a clock-by-clock model of the prescaler and
+    /// down counter, including reads between events and a mid-run TC reload.
+    #[test]
+    fn lazy_timer_matches_per_clock_model() {
+        let mut ctc = Z80Ctc::new();
+        ctc.write(0, CONTROL_WORD | TC_FOLLOWS | INTERRUPT_EN);
+        ctc.write(0, 3);
+        ctc.write(1, CONTROL_WORD | TC_FOLLOWS | PRESCALER_256 | INTERRUPT_EN);
+        ctc.write(1, 2);
+
+        // (prescale, prescaler_count, down_counter, time_constant)
+        let mut model = [(16u32, 16u32, 3u32, 3u32), (256, 256, 2, 2)];
+        let mut fired = [0u32; 2];
+        for clock in 0..3000 {
+            if clock == 1234 {
+                ctc.write(0, CONTROL_WORD | TC_FOLLOWS | INTERRUPT_EN);
+                ctc.write(0, 5);
+                model[0] = (16, 16, 5, 5);
+            }
+            ctc.tick();
+            for (i, (p, pc, dc, tc)) in model.iter_mut().enumerate() {
+                *pc -= 1;
+                if *pc == 0 {
+                    *pc = *p;
+                    *dc -= 1;
+                    if *dc == 0 {
+                        *dc = *tc;
+                        fired[i] += 1;
+                    }
+                }
+                let zc = *pc == *p && *dc == *tc;
+                assert_eq!(ctc.zc_output(i as u8), zc, "ch{i} ZC at clock {clock}");
+                assert_eq!(
+                    ctc.read(i as u8) as u32,
+                    *dc,
+                    "ch{i} count at clock {clock}"
+                );
+            }
+            while ctc.interrupt_pending() {
+                ctc.acknowledge_interrupt();
+            }
+        }
+        assert!(fired[0] > 20 && fired[1] > 1);
+    }
 }
@@ -7,14 +7,26 @@
 //! format; the generic [`decode_gfx`] function reads bits at the positions
 //! specified by the layout and assembles pixel values. The scanline renderer
 //! then uses the resulting cache via a simple array lookup.
+//!
+//! Decoded pixels are immutable once built and shared between caches:
+//! cloning a [`GfxCache`] is a reference-count bump. Machines loading from a
+//! ROM set decode through its [`GfxDecodes`], which hands back the pixels of
+//! an identical earlier decode, so many instances created from one set
+//! decode their graphics ROMs once. A cache written at runtime (character
+//! RAM) gets its own copy on the first write.
+
+use std::collections::HashMap;
+use std::hash::{DefaultHasher, Hash, Hasher};
+use std::sync::{Arc, Mutex};
 
 /// Pre-decoded tile or sprite pixel cache.
 ///
 /// Pixels are stored as palette indices in a flat array indexed by
 /// `code * height * width + py * width + px`. Each element is an N-bit
 /// value (0-3 for 2bpp, 0-7 for 3bpp, etc.).
+#[derive(Clone)]
 pub struct GfxCache {
-    pixels: Vec<u8>,
+    pixels: Arc<[u8]>,
     width: usize,
     height: usize,
     count: usize,
@@ -26,7 +38,7 @@ impl GfxCache {
     pub fn new(count: usize, width: usize, height: usize) -> Self {
         let stride = width * height;
         Self {
-            pixels: vec![0; count * stride],
+            pixels: vec![0; count * stride].into(),
             width,
             height,
             count,
@@ -51,10 +63,22 @@ impl GfxCache {
         &self.pixels[start..start + self.width]
     }
 
-    /// Set a single pixel value (used during decode).
+    /// Set a single pixel value. Copies the pixels first if they are shared.
     #[inline]
     pub fn set_pixel(&mut self, code: usize, px: usize, py: usize, value: u8) {
-        self.pixels[code * self.stride + py * self.width + px] = value;
+        Arc::make_mut(&mut self.pixels)[code * self.stride + py * self.width + px] = value;
+    }
+
+    /// Mutable pixels of one element, `height` rows of `width`. Copies the
+    /// pixels first if they are shared.
+    fn element_mut(&mut self, code: usize) -> &mut [u8] {
+        let start = code * self.stride;
+        &mut Arc::make_mut(&mut self.pixels)[start..start + self.stride]
+    }
+
+    /// Whether this cache's pixels are shared with another cache.
+    pub fn is_shared(&self) -> bool {
+        Arc::strong_count(&self.pixels) > 1
     }
 
     pub fn count(&self) -> usize {
@@ -102,27 +126,18 @@ pub struct GfxLayout<'a> {
 pub fn decode_gfx(rom: &[u8], base: usize, count: usize, layout: &GfxLayout) -> GfxCache {
     let width = layout.x_offsets.len();
     let height = layout.y_offsets.len();
-    let mut cache = GfxCache::new(count, width, height);
-    let base_bits = base * 8;
-
-    for code in 0..count {
-        let code_bits = base_bits + code * layout.char_increment;
-        for (py, &y_off) in layout.y_offsets.iter().enumerate() {
-            for (px, &x_off) in layout.x_offsets.iter().enumerate() {
-                let mut pixel: u8 = 0;
-                let xy_bits = x_off + y_off;
-                for (p, &plane_off) in layout.plane_offsets.iter().enumerate() {
-                    let bit_pos = code_bits + plane_off + xy_bits;
-                    let byte_idx = bit_pos / 8;
-                    if byte_idx < rom.len() {
-                        pixel |= ((rom[byte_idx] >> (7 - (bit_pos & 7))) & 1) << p;
-                    }
-                }
-                cache.set_pixel(code, px, py, pixel);
-            }
-        }
+    let stride = width * height;
+    let mut pixels = vec![0u8; count * stride];
+    for (code, element) in pixels.chunks_exact_mut(stride.max(1)).enumerate() {
+        decode_element(rom, base, code, layout, element);
+    }
+    GfxCache {
+        pixels: pixels.into(),
+        width,
+        height,
+        count,
+        stride,
     }
-    cache
 }
 
 /// Re-decode a single element into an existing [`GfxCache`].
@@ -136,6 +151,12 @@ pub fn decode_gfx_element(
     layout: &GfxLayout,
     cache: &mut GfxCache,
 ) {
+    decode_element(rom, base, code, layout, cache.element_mut(code));
+}
+
+/// Decode element `code` into `out` (`height` rows of `width` pixels).
+fn decode_element(rom: &[u8], base: usize, code: usize, layout: &GfxLayout, out: &mut [u8]) {
+    let width = layout.x_offsets.len();
     let code_bits = base * 8 + code * layout.char_increment;
     for (py, &y_off) in layout.y_offsets.iter().enumerate() {
         for (px, &x_off) in layout.x_offsets.iter().enumerate() {
@@ -148,7 +169,69 @@ pub fn decode_gfx_element(
                     pixel |= ((rom[byte_idx] >> (7 - (bit_pos & 7))) & 1) << p;
                 }
             }
-            cache.set_pixel(code, px, py, pixel);
+            out[py * width + px] = pixel;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sharing identical decodes
+// ---------------------------------------------------------------------------
+
+/// Decodes made from one ROM set, kept so that repeating a decode shares
+/// the earlier pixels instead of decoding again.
+///
+/// Owned by whatever holds the ROM data (a loaded ROM set); the pixels are
+/// released with it. Entries are keyed by the decode parameters and a
+/// 64-bit hash of the ROM bytes, so the ROM itself is not copied.
+#[derive(Default)]
+pub struct GfxDecodes {
+    decoded: Mutex<HashMap<DecodeKey, GfxCache>>,
+}
+
+impl GfxDecodes {
+    /// [`decode_gfx`], sharing the pixels of an identical earlier decode
+    /// made through this set.
+    pub fn decode(&self, rom: &[u8], base: usize, count: usize, layout: &GfxLayout) -> GfxCache {
+        let key = DecodeKey::new(rom, base, count, layout);
+        if let Some(cache) = self.lock().get(&key) {
+            return cache.clone();
+        }
+        // Decode unlocked; if another thread got there first, keep its copy
+        let cache = decode_gfx(rom, base, count, layout);
+        self.lock().entry(key).or_insert(cache).clone()
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, HashMap<DecodeKey, GfxCache>> {
+        self.decoded.lock().unwrap_or_else(|e| e.into_inner())
+    }
+}
+
+#[derive(PartialEq, Eq, Hash)]
+struct DecodeKey {
+    rom_hash: u64,
+    rom_len: usize,
+    base: usize,
+    count: usize,
+    plane_offsets: Vec<usize>,
+    x_offsets: Vec<usize>,
+    y_offsets: Vec<usize>,
+    char_increment: usize,
+}
+
+impl DecodeKey {
+    fn new(rom: &[u8], base: usize, count: usize, layout: &GfxLayout) -> Self {
+        let mut hasher = DefaultHasher::new();
+        rom.hash(&mut hasher);
+        Self {
+            rom_hash: hasher.finish(),
+            rom_len: rom.len(),
+            base,
+            count,
+            plane_offsets: layout.plane_offsets.to_vec(),
+            x_offsets: layout.x_offsets.to_vec(),
+            y_offsets: layout.y_offsets.to_vec(),
+            char_increment: layout.char_increment,
         }
     }
 }
@@ -169,4 +252,29 @@ mod tests {
         assert_eq!(cache.pixel(0, 3, 5), 2);
         assert_eq!(cache.pixel(1, 3, 5), 0); // different code, still 0
     }
+
+    #[test]
+    fn identical_decodes_share_pixels() {
+        let layout = GfxLayout {
+            plane_offsets: &[0, 4],
+            x_offsets: &[0, 1, 2, 3],
+            y_offsets: &[0, 8],
+            char_increment: 16,
+        };
+        let rom = [0x5A, 0xC3, 0x0F, 0xF0];
+        let decodes = GfxDecodes::default();
+        let a = decodes.decode(&rom, 0, 2, &layout);
+        let mut b = decodes.decode(&rom, 0, 2, &layout);
+        assert!(Arc::ptr_eq(&a.pixels, &b.pixels));
+        let other = decodes.decode(&[0x5A, 0xC3, 0x0F, 0xF1], 0, 2, &layout);
+        assert!(!Arc::ptr_eq(&a.pixels, &other.pixels));
+        assert!(!decode_gfx(&rom, 0, 2, &layout).is_shared());
+
+        // A runtime write copies instead of touching the other cache
+        let before = a.pixel(1, 2, 1);
+        b.set_pixel(1, 2, 1, before ^ 3);
+        assert_eq!(a.pixel(1, 2, 1), before);
+        assert_eq!(b.pixel(1, 2, 1), before ^ 3);
+        assert!(!b.is_shared());
+    }
 }
@@ -5,6 +5,11 @@ pub struct TestBus {
     pub memory: [u8; 0x10000],
     pub nmi: bool,
     pub irq: bool,
+    /// Accept `Bus::block_copy` requests (counted in `block_copies`).
+    pub bulk: bool,
+    pub block_copies: u32,
+    /// Reported by `Bus::is_pure_read` for every address.
+    pub pure: bool,
 }
 
 impl TestBus {
@@ -13,6 +18,9 @@ impl TestBus {
             memory: [0; 0x10000],
             nmi: false,
             irq: false,
+            bulk: false,
+            block_copies: 0,
+            pure: false,
         }
     }
 
@@ -45,4 +53,31 @@ impl Bus for TestBus {
             irq_vector: 0xFF,
         }
     }
+
+    fn is_pure_read(&self, _master: BusMaster, _addr: u16) -> bool {
+        self.pure
+    }
+
+    fn block_copy(
+        &mut self,
+        _master: BusMaster,
+        src: u16,
+        dst: u16,
+        len: u32,
+        descending: bool,
+    ) -> bool {
+        if !self.bulk {
+            return false;
+        }
+        for i in 0..len as u16 {
+            let (s, d) = if descending {
+                (src.wrapping_sub(i), dst.wrapping_sub(i))
+            } else {
+                (src.wrapping_add(i), dst.wrapping_add(i))
+            };
+            self.memory[d as usize] = self.memory[s as usize];
+        }
+        self.block_copies += 1;
+        true
+    }
 }
@@ -0,0 +1,202 @@
+use phosphor_core::core::save_state::{Saveable, StateWriter};
+use phosphor_core::core::{BusMaster, BusMasterComponent};
+use phosphor_core::cpu::m6809::M6809;
+use phosphor_core::cpu::z80::Z80;
+mod common;
+use common::TestBus;
+
+const MASTER: BusMaster = BusMaster::Cpu(0);
+
+fn saved<S: Saveable>(cpu: &S) -> Vec<u8> {
+    let mut w = StateWriter::new();
+    cpu.save_state(&mut w);
+    w.into_vec()
+}
+
+/// Step `cpu` until `skip` accepts, at most `limit` cycles. Returns the
+/// cycles stepped and the cycles skipped (0 if it never accepted).
+fn step_until_skip<
+    C: BusMasterComponent<Bus = dyn phosphor_core::core::Bus<Address = u16, Data = u8>>,
+>(
+    cpu: &mut C,
+    bus: &mut TestBus,
+    limit: u64,
+    mut skip: impl FnMut(&mut C, &mut TestBus) -> u64,
+) -> (u64, u64) {
+    for stepped in 0..limit {
+        let skipped = skip(cpu, bus);
+        if skipped > 0 {
+            return (stepped, skipped);
+        }
+        cpu.tick_with_bus(bus, MASTER);
+    }
+    (limit, 0)
+}
+
+fn tick<C: BusMasterComponent<Bus = dyn phosphor_core::core::Bus<Address = u16, Data = u8>>>(
+    cpu: &mut C,
+    bus: &mut TestBus,
+    n: u64,
+) {
+    for _ in 0..n {
+        cpu.tick_with_bus(bus, MASTER);
+    }
+}
+
+// ============================================================
+// M6809
+// ============================================================
+
+/// `LDA $2000; BEQ *-3` at 0x1000, IRQ handler at 0x3000 sets the flag.
+fn m6809_poll_loop(pure: bool) -> (M6809, TestBus) {
+    let mut cpu = M6809::new();
+    let mut bus = TestBus::new();
+    bus.pure = pure;
+    bus.load(0x1000, &[0xB6, 0x20, 0x00, 0x27, 0xFB]);
+    bus.load(0x1005, &[0x12, 0x20, 0xFD]); // NOP; BRA *-1 (after the flag is seen)
+    bus.load(0x3000, &[0x86, 0x01, 0xB7, 0x20, 0x00, 0x3B]); // LDA #1; STA $2000; RTI
+    bus.load(0xFFF8, &[0x30, 0x00]);
+    cpu.pc = 0x1000;
+    cpu.s = 0x8000;
+    (cpu, bus)
+}
+
+#[test]
+fn m6809_poll_loop_skips_like_stepping() {
+    let (mut stepped, mut bus_a) = m6809_poll_loop(true);
+    let (mut skipping, mut bus_b) = m6809_poll_loop(true);
+
+    let (n, skipped) = step_until_skip(&mut skipping, &mut bus_b, 100, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 1000)
+    });
+    // LDA extended (5) + BEQ (3), as many whole passes as fit
+    assert_eq!(skipped, 1000 / 8 * 8);
+    tick(&mut stepped, &mut bus_a, n + skipped);
+    assert_eq!(saved(&stepped), saved(&skipping));
+
+    // Both take the IRQ on the same cycle and leave the loop together
+    bus_a.irq = true;
+    bus_b.irq = true;
+    for cycle in 0..100 {
+        if skipping.pc == 0x3000 {
+            bus_a.irq = false;
+            bus_b.irq = false;
+        }
+        tick(&mut stepped, &mut bus_a, 1);
+        tick(&mut skipping, &mut bus_b, 1);
+        assert_eq!(saved(&stepped), saved(&skipping), "cycle {cycle}");
+    }
+    assert!((0x1005..=0x1008).contains(&skipping.pc));
+}
+
+#[test]
+fn m6809_impure_reads_are_not_skipped() {
+    let (mut cpu, mut bus) = m6809_poll_loop(false);
+    let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 500, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 1000)
+    });
+    assert_eq!(skipped, 0);
+}
+
+#[test]
+fn m6809_loops_that_write_or_count_are_not_skipped() {
+    for program in [
+        &[0xB7, 0x20, 0x01, 0x20, 0xFB][..],   // STA $2001; BRA *-3
+        &[0x30, 0x1F, 0x26, 0xFC, 0x20, 0xFE], // LEAX -1,X; BNE *-2
+    ] {
+        let (mut cpu, mut bus) = m6809_poll_loop(true);
+        bus.load(0x1000, program);
+        cpu.x = 0x1000;
+        let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 2000, |cpu, bus| {
+            cpu.skip_idle(bus, MASTER, 1000)
+        });
+        assert_eq!(skipped, 0, "{program:02X?}");
+    }
+}
+
+#[test]
+fn m6809_asserted_irq_blocks_skip() {
+    let (mut cpu, mut bus) = m6809_poll_loop(true);
+    cpu.cc |= 0x10; // I: IRQ masked but asserted
+    bus.irq = true;
+    let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 500, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 1000)
+    });
+    assert_eq!(skipped, 0);
+
+    bus.irq = false;
+    let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 500, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 1000)
+    });
+    assert!(skipped > 0);
+}
+
+#[test]
+fn m6809_disabled_detector_never_skips() {
+    let (mut cpu, mut bus) = m6809_poll_loop(true);
+    cpu.idle.enabled = false;
+    let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 500, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 1000)
+    });
+    assert_eq!(skipped, 0);
+}
+
+// ============================================================
+// Z80
+// ============================================================
+
+/// `LD A,($2000); OR A; JR Z,$-4` at 0x0100, IM 1 handler sets the flag.
+fn z80_poll_loop() -> (Z80, TestBus) {
+    let mut cpu = Z80::new();
+    let mut bus = TestBus::new();
+    bus.pure = true;
+    bus.load(0x0100, &[0x3A, 0x00, 0x20, 0xB7, 0x28, 0xFA, 0x18, 0xFE]);
+    // LD A,1; LD ($2000),A; EI; RET
+    bus.load(0x0038, &[0x3E, 0x01, 0x32, 0x00, 0x20, 0xFB, 0xC9]);
+    cpu.pc = 0x0100;
+    cpu.sp = 0x8000;
+    cpu.im = 1;
+    cpu.iff1 = true;
+    cpu.iff2 = true;
+    cpu.r = 0x85;
+    (cpu, bus)
+}
+
+#[test]
+fn z80_poll_loop_skips_like_stepping() {
+    let (mut stepped, mut bus_a) = z80_poll_loop();
+    let (mut skipping, mut bus_b) = z80_poll_loop();
+
+    let (n, skipped) = step_until_skip(&mut skipping, &mut bus_b, 100, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 5000)
+    });
+    // LD A,(nn) (13) + OR A (4) + JR taken (12)
+    assert_eq!(skipped, 5000 / 29 * 29);
+    tick(&mut stepped, &mut bus_a, n + skipped);
+    // R advanced by three refreshes per pass, bit 7 kept
+    assert_eq!(skipping.r, stepped.r);
+    assert_eq!(saved(&stepped), saved(&skipping));
+
+    bus_a.irq = true;
+    bus_b.irq = true;
+    for cycle in 0..150 {
+        if skipping.pc == 0x0038 {
+            bus_a.irq = false;
+            bus_b.irq = false;
+        }
+        tick(&mut stepped, &mut bus_a, 1);
+        tick(&mut skipping, &mut bus_b, 1);
+        assert_eq!(saved(&stepped), saved(&skipping), "cycle {cycle}");
+    }
+    assert!((0x0106..=0x0108).contains(&skipping.pc));
+}
+
+#[test]
+fn z80_io_reads_are_not_skipped() {
+    let (mut cpu, mut bus) = z80_poll_loop();
+    bus.load(0x0100, &[0xDB, 0x10, 0xB7, 0x28, 0xFB]); // IN A,($10); OR A; JR Z
+    let (_, skipped) = step_until_skip(&mut cpu, &mut bus, 500, |cpu, bus| {
+        cpu.skip_idle(bus, MASTER, 5000)
+    });
+    assert_eq!(skipped, 0);
+}
@@ -466,3 +466,46 @@ fn test_port_b_written_set_on_same_value() {
     pia.write(2, 0x42); // Same value again
     assert!(pia.take_port_b_written()); // Should still be set
 }
+
+// ==========================================================================
+// IRQ change notification
+// ==========================================================================
+
+#[test]
+fn test_irq_changed_follows_output_level() {
+    let mut pia = Pia6820::new();
+    assert!(pia.take_irq_changed()); // Initial level reported once
+    assert!(!pia.take_irq_changed());
+
+    // Flag set while disabled: IRQA stays low, no notification
+    pia.set_ca1(true);
+    pia.set_ca1(false); // Falling edge (CRA.1 = 0)
+    assert!(!pia.irq_a());
+    assert!(!pia.take_irq_changed());
+
+    // Enabling CA1 interrupts raises IRQA
+    pia.write(1, 0x05); // CRA: data select + CA1 enable
+    assert!(pia.irq_a());
+    assert!(pia.take_irq_changed());
+
+    // A second edge while already asserted is not a change
+    pia.set_ca1(true);
+    pia.set_ca1(false);
+    assert!(!pia.take_irq_changed());
+
+    // Reading the data port clears the flag and drops IRQA
+    pia.read(0);
+    assert!(!pia.irq_a());
+    assert!(pia.take_irq_changed());
+
+    // CB1 edge with interrupts enabled raises IRQB
+    pia.write(3, 0x01); // CRB: CB1 enable, falling edge
+    assert!(!pia.take_irq_changed());
+    pia.set_cb1(true);
+    pia.set_cb1(false);
+    assert!(pia.irq_b());
+    assert!(pia.take_irq_changed());
+
+    pia.reset();
+    assert!(pia.take_irq_changed());
+}
@@ -246,3 +246,106 @@ fn test_dec_sp() {
     run_instruction(&mut cpu, &mut bus);
     assert_eq!(cpu.sp, 0x0FFF);
 }
+
+// --- 8-bit ALU flags (exhaustive) ---
+
+/// Reference S/Z/X/Y/H/PV/N/C for an 8-bit add or subtract, computed flag
+/// by flag. `xy` is the byte the undocumented X/Y bits are copied from.
+fn reference_flags(a: u8, val: u8, carry: u8, subtract: bool, xy: u8) -> (u8, u8) {
+    let (wide, half, overflow) = if subtract {
+        let wide = (a as u16)
+            .wrapping_sub(val as u16)
+            .wrapping_sub(carry as u16);
+        let r = wide as u8;
+        (
+            wide,
+            (a & 0xF) < (val & 0xF) + carry,
+            (a ^ val) & (a ^ r) & 0x80 != 0,
+        )
+    } else {
+        let wide = a as u16 + val as u16 + carry as u16;
+        let r = wide as u8;
+        (
+            wide,
+            (a & 0xF) + (val & 0xF) + carry > 0xF,
+            (a ^ r) & (val ^ r) & 0x80 != 0,
+        )
+    };
+    let result = wide as u8;
+    let mut f = (result & 0x80) | (xy & 0x28);
+    if result == 0 {
+        f |= 0x40;
+    }
+    if half {
+        f |= 0x10;
+    }
+    if overflow {
+        f |= 0x04;
+    }
+    if subtract {
+        f |= 0x02;
+    }
+    if wide > 0xFF {
+        f |= 0x01;
+    }
+    (result, f)
+}
+
+#[test]
+fn test_alu_n_flags_exhaustive() {
+    let mut bus = TestBus::new();
+    // (opcode, subtract, uses carry, is CP)
+    for (opcode, subtract, with_carry, compare) in [
+        (0xC6u8, false, false, false), // ADD A,n
+        (0xCE, false, true, false),    // ADC A,n
+        (0xD6, true, false, false),    // SUB n
+        (0xDE, true, true, false),     // SBC A,n
+        (0xFE, true, false, true),     // CP n
+    ] {
+        for a in 0..=0xFFu8 {
+            for val in 0..=0xFFu8 {
+                for carry in [0u8, 1] {
+                    let mut cpu = Z80::new();
+                    cpu.a = a;
+                    cpu.f = carry;
+                    bus.load(0, &[opcode, val]);
+                    run_instruction(&mut cpu, &mut bus);
+
+                    let cin = if with_carry { carry } else { 0 };
+                    let (result, _) = reference_flags(a, val, cin, subtract, 0);
+                    let xy = if compare { val } else { result };
+                    let (_, f) = reference_flags(a, val, cin, subtract, xy);
+                    let expected_a = if compare { a } else { result };
+                    assert_eq!(cpu.a, expected_a, "op={opcode:02X} a={a:02X} n={val:02X}");
+                    assert_eq!(cpu.f, f, "op={opcode:02X} a={a:02X} n={val:02X} c={carry}");
+                }
+            }
+        }
+    }
+}
+
+#[test]
+fn test_inc_dec_a_flags_exhaustive() {
+    let mut bus = TestBus::new();
+    for a in 0..=0xFFu8 {
+        for carry in [0u8, 1] {
+            for (opcode, subtract) in [(0x3Cu8, false), (0x3D, true)] {
+                let mut cpu = Z80::new();
+                cpu.a = a;
+                cpu.f = carry;
+                bus.load(0, &[opcode]);
+                run_instruction(&mut cpu, &mut bus);
+
+                let result = if subtract {
+                    a.wrapping_sub(1)
+                } else {
+                    a.wrapping_add(1)
+                };
+                let (_, f) = reference_flags(a, 1, 0, subtract, result);
+                let f = (f & !0x01) | carry; // C preserved
+                assert_eq!(cpu.a, result, "op={opcode:02X} a={a:02X}");
+                assert_eq!(cpu.f, f, "op={opcode:02X} a={a:02X} c={carry}");
+            }
+        }
+    }
+}
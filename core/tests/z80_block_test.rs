@@ -1,3 +1,4 @@
+use phosphor_core::core::save_state::{Saveable, StateReader, StateWriter};
 use phosphor_core::core::{BusMaster, BusMasterComponent};
 use phosphor_core::cpu::z80::Z80;
 mod common;
@@ -124,6 +125,152 @@ fn test_ldir() {
     assert_eq!(cpu.f & 0x04, 0, "PV should be clear after LDIR completes");
 }
 
+/// Mid-run event for [`ldir_bulk_vs_per_byte`].
+#[derive(Clone, Copy, PartialEq)]
+enum Interrupt {
+    None,
+    /// Raise IRQ after this many T-states.
+    Irq(u32),
+    /// Raise NMI after this many T-states. The handler only returns: a
+    /// board whose NMI could read the destination declines bulk copies.
+    Nmi(u32),
+    /// Save and reload the CPU at the first instruction boundary after this
+    /// many T-states.
+    SaveLoad(u32),
+}
+
+/// Run LDIR/LDDR to completion with and without the bus accepting
+/// `block_copy`, with an optional interruption mid-run. Memory, registers
+/// (including what the interrupt handler read at DE) and total T-states
+/// must match. Returns whether the bulk path was taken.
+fn ldir_bulk_vs_per_byte(opcode: u8, hl: u16, de: u16, bc: u16, event: Interrupt) -> bool {
+    let mut runs = Vec::new();
+    let mut used_bulk = false;
+    for bulk in [false, true] {
+        let mut cpu = Z80::new();
+        let mut bus = TestBus::new();
+        bus.bulk = bulk;
+        for i in 0x1000..0x3000 {
+            bus.memory[i] = (i ^ (i >> 8)) as u8;
+        }
+        bus.load(0, &[0xED, opcode]);
+        bus.load(0x0038, &[0x1A, 0xC9]); // RST 38h handler: LD A,(DE); RET
+        bus.load(0x0066, &[0xED, 0x45]); // NMI handler: RETN
+        cpu.set_hl(hl);
+        cpu.set_de(de);
+        cpu.set_bc(bc);
+        cpu.sp = 0xF000;
+        cpu.im = 1;
+        cpu.iff1 = matches!(event, Interrupt::Irq(_));
+        let mut cycles = 0u32;
+        let mut reloaded = false;
+        while cpu.get_bc() != 0 || cpu.pc != 2 {
+            if event == Interrupt::Irq(cycles) {
+                bus.irq = true;
+            }
+            if event == Interrupt::Nmi(cycles) {
+                bus.nmi = true;
+            }
+            if cpu.pc == 0x0038 {
+                bus.irq = false;
+            }
+            let done = cpu.tick_with_bus(&mut bus, BusMaster::Cpu(0));
+            cycles += 1;
+            if let Interrupt::SaveLoad(at) = event
+                && done
+                && cycles >= at
+                && !reloaded
+            {
+                let mut w = StateWriter::new();
+                cpu.save_state(&mut w);
+                let data = w.into_vec();
+                cpu = Z80::new();
+                cpu.load_state(&mut StateReader::new(&data)).unwrap();
+                reloaded = true;
+            }
+        }
+        if !bulk {
+            assert_eq!(bus.block_copies, 0);
+        }
+        used_bulk |= bus.block_copies > 0;
+        runs.push((
+            bus.memory.to_vec(),
+            cpu.a,
+            cpu.get_hl(),
+            cpu.get_de(),
+            cpu.f,
+            cpu.r,
+            cycles,
+        ));
+    }
+    assert!(
+        runs[0] == runs[1],
+        "opcode {opcode:#04X} hl={hl:#06X} de={de:#06X} bc={bc}"
+    );
+    used_bulk
+}
+
+#[test]
+fn test_ldir_bulk_matches_per_byte() {
+    use Interrupt::*;
+    assert!(ldir_bulk_vs_per_byte(0xB0, 0x1000, 0x2000, 0x200, None));
+    assert!(ldir_bulk_vs_per_byte(0xB0, 0x1000, 0x1001, 0x200, None)); // fill idiom
+    assert!(ldir_bulk_vs_per_byte(0xB8, 0x1FFF, 0x2FFF, 0x200, None));
+    // With interrupts enabled the handler could read bytes copied ahead of
+    // time, so the run stays per-byte until it returns with IFF1 clear
+    ldir_bulk_vs_per_byte(0xB0, 0x1000, 0x2000, 0x200, Irq(1000));
+    assert!(ldir_bulk_vs_per_byte(
+        0xB0,
+        0x1000,
+        0x2000,
+        0x200,
+        SaveLoad(1000)
+    ));
+    ldir_bulk_vs_per_byte(0xB0, 0x1000, 0x1001, 0x200, Irq(1000));
+    // An NMI drops the credit; the resumed loop rewrites the rest
+    assert!(ldir_bulk_vs_per_byte(
+        0xB0,
+        0x1000,
+        0x2000,
+        0x200,
+        Nmi(1000)
+    ));
+    assert!(ldir_bulk_vs_per_byte(
+        0xB0,
+        0x1000,
+        0x1001,
+        0x200,
+        Nmi(1000)
+    ));
+    assert!(ldir_bulk_vs_per_byte(
+        0xB0,
+        0x1000,
+        0x1001,
+        0x200,
+        SaveLoad(1000)
+    ));
+}
+
+#[test]
+fn test_ldir_bulk_skips_overlap_that_reads_ahead() {
+    use Interrupt::*;
+    // Shifting a block down by one (LDIR, HL = DE + 1) or up by one (LDDR,
+    // DE = HL + 1) would overwrite bytes still to be read, so these runs
+    // must match per-byte execution through an NMI or a reload.
+    for event in [None, Nmi(1000), SaveLoad(1000)] {
+        ldir_bulk_vs_per_byte(0xB0, 0x1001, 0x1000, 0x200, event);
+        ldir_bulk_vs_per_byte(0xB8, 0x1FFF, 0x2000, 0x200, event);
+    }
+    // Far enough apart that the runs do not overlap: bulk again
+    assert!(ldir_bulk_vs_per_byte(
+        0xB0,
+        0x1200,
+        0x1000,
+        0x200,
+        Nmi(1000)
+    ));
+}
+
 // ============================================================
 // LDDR
 // ============================================================
@@ -0,0 +1,253 @@
+//! Headless batch runner: emulate a machine as fast as possible with no
+//! window or audio device, for throughput benchmarks and regression runs.
+//!
+//! Runs one or more independent instances of a registered machine (one
+//! thread each), optionally driven by an input movie recorded with
+//! `phosphor --record`, and reports speed plus state, video and audio
+//! hashes. Instances given the same input must finish with the same
+//! hashes; the runner exits non-zero if they disagree.
+
+use std::time::{Duration, Instant};
+
+use clap::Parser;
+use phosphor_core::core::MoviePlayer;
+use phosphor_core::core::machine::Accuracy;
+use phosphor_core::core::movie::Movie;
+use phosphor_core::core::state_hash::hash_bytes;
+use phosphor_machines::registry::{self, MachineEntry};
+use phosphor_machines::rom_loader::RomSet;
+
+#[path = "../rom_path.rs"]
+mod rom_path;
+
+#[derive(Parser)]
+#[command(
+    name = "phosphor-run",
+    about = "Run an arcade machine headless and report speed and hashes"
+)]
+struct Cli {
+    /// Machine to emulate (e.g., joust, pacman, robotron)
+    machine: String,
+
+    /// Path to ROM file or directory
+    rom_path: String,
+
+    /// Frames to run per instance (default: the movie's length, or 600)
+    #[arg(long, short)]
+    frames: Option<u64>,
+
+    /// Independent instances to run in parallel, one thread each
+    #[arg(long, short, default_value_t = 1)]
+    instances: usize,
+
+    /// Drive input from a movie recorded with `phosphor --record`
+    #[arg(long, value_name = "FILE")]
+    movie: Option<String>,
+
+    /// Render and hash every frame instead of only the last
+    #[arg(long)]
+    render_all: bool,
+
+    /// Step every CPU and device one cycle at a time
+    #[arg(long)]
+    cycle_accurate: bool,
+}
+
+struct RunResult {
+    elapsed: Duration,
+    state_hash: Option<u64>,
+    video_hash: u64,
+    audio_hash: u64,
+    audio_samples: u64,
+}
+
+/// Fold a chunk hash into a running hash, order-sensitively.
+fn chain(acc: u64, chunk: &[u8]) -> u64 {
+    let mut pair = [0u8; 16];
+    pair[..8].copy_from_slice(&acc.to_le_bytes());
+    pair[8..].copy_from_slice(&hash_bytes(chunk).to_le_bytes());
+    hash_bytes(&pair)
+}
+
+fn run_instance(
+    entry: &MachineEntry,
+    rom_set: &RomSet,
+    movie: Option<&[u8]>,
+    frames: u64,
+    cli: &Cli,
+) -> Result<RunResult, String> {
+    let mut machine = (entry.create)(rom_set).map_err(|e| e.to_string())?;
+    machine.set_accuracy(if cli.cycle_accurate {
+        Accuracy::Cycle
+    } else {
+        entry.accuracy
+    });
+    machine.reset();
+
+    let mut player = match movie {
+        Some(data) => {
+            let movie = Movie::from_bytes(data).map_err(|e| e.to_string())?;
+            Some(MoviePlayer::new(movie, machine.as_mut()).map_err(|e| e.to_string())?)
+        }
+        None => None,
+    };
+
+    let (w, h) = machine.display_size();
+    let mut framebuffer = vec![0u8; (w * h * 3) as usize];
+    let mut audio = vec![0i16; 4096];
+    let mut audio_bytes = Vec::with_capacity(audio.len() * 2);
+    let mut video_hash = 0;
+    let mut audio_hash = 0;
+    let mut audio_samples = 0;
+
+    let start = Instant::now();
+    for frame in 0..frames {
+        let stepped = match player.as_mut() {
+            Some(p) => p.step(machine.as_mut()),
+            None => false,
+        };
+        if !stepped {
+            machine.run_frame();
+        }
+
+        // Drain audio every frame, as the frontend does; undrained samples
+        // would pile up in the machine's buffers.
+        loop {
+            let n = machine.fill_audio(&mut audio);
+            if n == 0 {
+                break;
+            }
+            audio_bytes.clear();
+            audio_bytes.extend(audio[..n].iter().flat_map(|s| s.to_le_bytes()));
+            audio_hash = chain(audio_hash, &audio_bytes);
+            audio_samples += n as u64;
+            if n < audio.len() {
+                break;
+            }
+        }
+
+        if cli.render_all || frame + 1 == frames {
+            machine.render_frame(&mut framebuffer);
+            video_hash = chain(video_hash, &framebuffer);
+        }
+    }
+    let elapsed = start.elapsed();
+
+    Ok(RunResult {
+        elapsed,
+        state_hash: machine.state_hash(),
+        video_hash,
+        audio_hash,
+        audio_samples,
+    })
+}
+
+fn main() {
+    let cli = Cli::parse();
+
+    let entry = registry::find(&cli.machine).unwrap_or_else(|| {
+        let names: Vec<_> = registry::all().iter().map(|e| e.name).collect();
+        eprintln!("Unknown machine: {}", cli.machine);
+        eprintln!("Available: {}", names.join(", "));
+        std::process::exit(1);
+    });
+
+    let rom_set = entry
+        .rom_names
+        .iter()
+        .find_map(|name| rom_path::load_rom_set(name, &cli.rom_path).ok())
+        .unwrap_or_else(|| {
+            eprintln!("Failed to load ROMs from {}", cli.rom_path);
+            eprintln!("Tried: {}", entry.rom_names.join(", "));
+            std::process::exit(1);
+        });
+
+    let movie = cli.movie.as_ref().map(|path| {
+        std::fs::read(path).unwrap_or_else(|e| {
+            eprintln!("Failed to read movie {path}: {e}");
+            std::process::exit(1);
+        })
+    });
+    let frames = cli.frames.unwrap_or_else(|| {
+        movie
+            .as_deref()
+            .and_then(|data| Movie::from_bytes(data).ok())
+            .map_or(600, |m| m.frames())
+    });
+    let instances = cli.instances.max(1);
+
+    let wall = Instant::now();
+    let results: Vec<Result<RunResult, String>> = std::thread::scope(|s| {
+        let handles: Vec<_> = (0..instances)
+            .map(|_| s.spawn(|| run_instance(entry, &rom_set, movie.as_deref(), frames, &cli)))
+            .collect();
+        handles
+            .into_iter()
+            .map(|h| h.join().unwrap_or_else(|_| Err("instance panicked".into())))
+            .collect()
+    });
+    let wall = wall.elapsed().as_secs_f64();
+
+    let mut ok = Vec::new();
+    for (i, r) in results.into_iter().enumerate() {
+        match r {
+            Ok(r) => ok.push(r),
+            Err(e) => {
+                eprintln!("instance {i}: {e}");
+                std::process::exit(1);
+            }
+        }
+    }
+
+    // Speed, from a probe instance for the machine's clocks
+    let probe = (entry.create)(&rom_set).expect("machine created above");
+    let frame_rate = probe.frame_rate_hz();
+    let mean_secs = ok.iter().map(|r| r.elapsed.as_secs_f64()).sum::<f64>() / ok.len() as f64;
+    let fps = frames as f64 / mean_secs;
+    println!(
+        "{}: {instances} x {frames} frames in {wall:.2} s",
+        cli.machine
+    );
+    println!(
+        "  {fps:.1} frames/s per instance ({:.1}x real time), {:.1} frames/s total",
+        fps / frame_rate,
+        (frames * instances as u64) as f64 / wall
+    );
+    if let Some(hz) = probe.cpu_clock_hz() {
+        println!(
+            "  main CPU: {:.2} MHz emulated ({:.3} MHz clock)",
+            hz as f64 * fps / frame_rate / 1e6,
+            hz as f64 / 1e6
+        );
+    }
+    if let Some(bus) = probe.debug_bus() {
+        let names: Vec<_> = bus.cpus().iter().map(|(name, _)| *name).collect();
+        println!(
+            "  CPUs: {} (each at {:.1}x its clock)",
+            names.join(", "),
+            fps / frame_rate
+        );
+    }
+
+    // Hashes: identical input must give identical results
+    let show = |r: &RunResult| match r.state_hash {
+        Some(s) => format!(
+            "state {s:016x}  video {:016x}  audio {:016x} ({} samples)",
+            r.video_hash, r.audio_hash, r.audio_samples
+        ),
+        None => format!(
+            "state n/a  video {:016x}  audio {:016x} ({} samples)",
+            r.video_hash, r.audio_hash, r.audio_samples
+        ),
+    };
+    let first = show(&ok[0]);
+    if ok.iter().all(|r| show(r) == first) {
+        println!("  {first}");
+    } else {
+        for (i, r) in ok.iter().enumerate() {
+            println!("  instance {i}: {}", show(r));
+        }
+        eprintln!("Instances diverged");
+        std::process::exit(1);
+    }
+}
@@ -5,6 +5,8 @@
 //! - `nvram_path` — directory for battery-backed NVRAM files
 //! - `save_path` — directory for save state files
 //! - `scale` — default window scale factor
+//! - `rewind_mb` — memory budget for the rewind history (0 disables rewind)
+//! - `run_ahead` — frames to run ahead of the displayed frame (0 disables run-ahead)
 
 use serde::Deserialize;
 use std::path::PathBuf;
@@ -15,6 +17,8 @@ pub struct Config {
     pub nvram_path: Option<String>,
     pub save_path: Option<String>,
     pub scale: Option<u32>,
+    pub rewind_mb: Option<u32>,
+    pub run_ahead: Option<u32>,
 }
 
 /// Return the platform config directory: `~/.config/phosphor` (macOS/Linux).
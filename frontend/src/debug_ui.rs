@@ -69,6 +69,12 @@ pub struct DebugState {
     /// True when the UI has modified watchpoints and they need to be synced to the machine.
     pub watchpoints_dirty: bool,
 
+    // Idle-loop skip
+    /// Let CPUs skip confirmed polling loops instead of stepping every pass.
+    pub idle_skip: bool,
+    /// True when the UI toggled idle skip and it needs to be synced to the machine.
+    pub idle_skip_dirty: bool,
+
     // Per-CPU column state
     /// Which tab (Disassembly/Memory) is selected per CPU column.
     pub bottom_tabs: Vec<BottomTab>,
@@ -102,6 +108,8 @@ impl DebugState {
             watchpoint_write: true,
             last_watchpoint_hit: None,
             watchpoints_dirty: false,
+            idle_skip: true,
+            idle_skip_dirty: false,
             bottom_tabs: Vec::new(),
             memory_addr_inputs: Vec::new(),
             memory_scroll_to: Vec::new(),
@@ -183,6 +191,11 @@ pub fn execute_frame(machine: &mut dyn Machine, state: &mut DebugState) -> bool
         }
     }
 
+    if state.idle_skip_dirty {
+        state.idle_skip_dirty = false;
+        machine.set_idle_skip(state.idle_skip);
+    }
+
     match state.run_mode {
         RunMode::Running => {
             let cpf = machine.cycles_per_frame();
@@ -419,6 +432,14 @@ fn draw_controls_column(ui: &mut egui::Ui, state: &mut DebugState, min_top_heigh
         }
     }
 
+    if ui
+        .checkbox(&mut state.idle_skip, "Skip idle loops")
+        .on_hover_text("Skip polling loops that only read memory, up to the next scanline")
+        .changed()
+    {
+        state.idle_skip_dirty = true;
+    }
+
     // Breakpoints & Watchpoints
     draw_breakpoints_panel(ui, state);
     draw_watchpoints_panel(ui, state);
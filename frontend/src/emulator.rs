@@ -2,12 +2,61 @@ use std::path::Path;
 use std::time::{Duration, Instant};
 
 use phosphor_core::core::machine::Machine;
+use phosphor_core::core::save_state;
+use phosphor_core::core::{MoviePlayer, MovieRecorder, RewindBuffer};
 use sdl2::event::Event;
 use sdl2::keyboard::Scancode;
 
 use crate::debug_ui::{self, DebugState, RunMode};
 use crate::input::{self, ControllerMap, KeyMap};
 use crate::video::Video;
+use crate::writer::BackgroundWriter;
+
+/// Input movie attached to the session (`--record` / `--play`).
+pub enum MovieSession {
+    Off,
+    /// Every input delivered to the machine is logged.
+    Record(MovieRecorder),
+    /// Frames come from the movie; live input is ignored until it ends.
+    Play(MoviePlayer),
+}
+
+impl MovieSession {
+    fn is_off(&self) -> bool {
+        matches!(self, MovieSession::Off)
+    }
+
+    fn is_playing(&self) -> bool {
+        matches!(self, MovieSession::Play(player) if !player.is_finished())
+    }
+
+    fn set_input(&mut self, machine: &mut dyn Machine, id: u8, pressed: bool) {
+        match self {
+            MovieSession::Record(rec) => rec.button(machine, id, pressed),
+            _ if self.is_playing() => {}
+            _ => machine.set_input(id, pressed),
+        }
+    }
+
+    fn set_analog(&mut self, machine: &mut dyn Machine, axis: u8, delta: i32) {
+        match self {
+            MovieSession::Record(rec) => rec.analog(machine, axis, delta),
+            _ if self.is_playing() => {}
+            _ => machine.set_analog(axis, delta),
+        }
+    }
+
+    /// Run the next movie frame.
+    fn play_frame(&mut self, machine: &mut dyn Machine) -> bool {
+        let MovieSession::Play(player) = self else {
+            return false;
+        };
+        if player.step(machine) && player.is_finished() {
+            eprintln!("Movie finished");
+        }
+        true
+    }
+}
 
 #[allow(clippy::too_many_arguments)]
 pub fn run(
@@ -21,6 +70,12 @@ pub fn run(
     start_in_debug: bool,
     start_in_profile: bool,
     no_mouse_grab: bool,
+    rewind_budget: usize,
+    run_ahead: u32,
+    rom_dict: &[u8],
+    writer: &BackgroundWriter,
+    nvram_path: &Path,
+    movie: &mut MovieSession,
 ) {
     // Enable controller backends before SDL init — needed for Xbox on macOS
     sdl2::hint::set("SDL_JOYSTICK_HIDAPI", "1");
@@ -129,6 +184,33 @@ pub fn run(
         mouse_grabbed = true;
     }
 
+    // Rewind history (hold Backspace). Disabled when the budget is zero,
+    // the machine has no save states, or a movie is recording or playing.
+    let mut rewind = (rewind_budget > 0 && movie.is_off() && machine.save_state().is_some())
+        .then(|| RewindBuffer::new(rewind_budget));
+    let mut rewinding = false;
+    let mut rewind_state = Vec::new();
+    let mut snapshot = Vec::new();
+
+    // Run-ahead: after each real frame, save, emulate `run_ahead` hidden
+    // frames with the current input, present the last one, then restore.
+    // Games that take a frame or two to react to input then show the
+    // reaction immediately. Needs save states; disabled without them.
+    // Snapshots carry mid-instruction CPU state, so the restore leaves the
+    // real timeline bit-identical and movies record and play back as usual.
+    let run_ahead = if machine.save_state().is_some() {
+        run_ahead
+    } else {
+        0
+    };
+    let mut run_ahead_state = Vec::new();
+
+    // NVRAM is flushed through the writer whenever it changes, checked
+    // about once a second, so a crash loses at most a second of high scores.
+    let nvram_check_interval = machine.frame_rate_hz().round().max(1.0) as u32;
+    let mut nvram_countdown = nvram_check_interval;
+    let mut last_nvram = machine.save_nvram().map(<[u8]>::to_vec);
+
     // Debug state
     let has_debug = machine.debug_bus().is_some();
     let mut debug_state = DebugState::new();
@@ -251,10 +333,7 @@ pub fn run(
                     ..
                 } => {
                     if let Some(data) = machine.save_state() {
-                        match std::fs::write(save_path, &data) {
-                            Ok(()) => eprintln!("Save state written ({} bytes)", data.len()),
-                            Err(e) => eprintln!("Save state failed: {e}"),
-                        }
+                        writer.save_state(data, save_path.to_path_buf());
                     } else {
                         eprintln!("Save states not supported for this machine");
                     }
@@ -265,13 +344,23 @@ pub fn run(
                     scancode: Some(Scancode::F7),
                     repeat: false,
                     ..
-                } => match std::fs::read(save_path) {
-                    Ok(data) => match machine.load_state(&data) {
-                        Ok(()) => eprintln!("Save state loaded"),
-                        Err(e) => eprintln!("Load state failed: {e}"),
-                    },
-                    Err(e) => eprintln!("No save file found: {e}"),
-                },
+                } => {
+                    if !movie.is_off() {
+                        eprintln!("Quick load is disabled while a movie is active");
+                        continue;
+                    }
+                    // A quick-save may still be in flight on the writer
+                    writer.wait_idle();
+                    match std::fs::read(save_path) {
+                        Ok(data) => match save_state::unpack_state(&data, rom_dict)
+                            .and_then(|raw| machine.load_state(&raw))
+                        {
+                            Ok(()) => eprintln!("Save state loaded"),
+                            Err(e) => eprintln!("Load state failed: {e}"),
+                        },
+                        Err(e) => eprintln!("No save file found: {e}"),
+                    }
+                }
 
                 // F8: Toggle profiler
                 Event::KeyDown {
@@ -336,18 +425,27 @@ pub fn run(
                     ..
                 } => {
                     machine.render_frame(&mut framebuffer);
-                    match crate::screenshot::save_screenshot(
-                        &framebuffer,
+                    writer.screenshot(
+                        framebuffer.clone(),
                         width,
                         height,
-                        screenshot_dir,
+                        screenshot_dir.to_path_buf(),
                         machine_name,
-                    ) {
-                        Ok(path) => eprintln!("Screenshot saved: {}", path.display()),
-                        Err(e) => eprintln!("Screenshot failed: {e}"),
-                    }
+                    );
                 }
 
+                // Rewind (hold Backspace)
+                Event::KeyDown {
+                    scancode: Some(Scancode::Backspace),
+                    repeat: false,
+                    ..
+                } => rewinding = rewind.is_some(),
+
+                Event::KeyUp {
+                    scancode: Some(Scancode::Backspace),
+                    ..
+                } => rewinding = false,
+
                 // Keyboard input — only pass to game if egui doesn't want it
                 Event::KeyDown {
                     scancode: Some(sc),
@@ -357,7 +455,7 @@ pub fn run(
                     if !video.wants_keyboard()
                         && let Some(button_id) = key_map.get(sc)
                     {
-                        machine.set_input(button_id, true);
+                        movie.set_input(machine, button_id, true);
                     }
                 }
 
@@ -367,27 +465,27 @@ pub fn run(
                     if !video.wants_keyboard()
                         && let Some(button_id) = key_map.get(sc)
                     {
-                        machine.set_input(button_id, false);
+                        movie.set_input(machine, button_id, false);
                     }
                 }
 
                 // Game controller button press/release (egui never intercepts these)
                 Event::ControllerButtonDown { button, .. } => {
                     if let Some(button_id) = controller_map.get_button(button) {
-                        machine.set_input(button_id, true);
+                        movie.set_input(machine, button_id, true);
                     }
                 }
 
                 Event::ControllerButtonUp { button, .. } => {
                     if let Some(button_id) = controller_map.get_button(button) {
-                        machine.set_input(button_id, false);
+                        movie.set_input(machine, button_id, false);
                     }
                 }
 
                 // Game controller analog stick → digital directions
                 Event::ControllerAxisMotion { axis, value, .. } => {
                     for (button_id, pressed) in controller_map.axis_to_digital(axis, value) {
-                        machine.set_input(button_id, pressed);
+                        movie.set_input(machine, button_id, pressed);
                     }
                 }
 
@@ -408,10 +506,10 @@ pub fn run(
                 Event::MouseMotion { xrel, yrel, .. } => {
                     if !video.wants_pointer() && mouse_grabbed {
                         if let Some(&ax) = analog_axes.first() {
-                            machine.set_analog(ax, xrel);
+                            movie.set_analog(machine, ax, xrel);
                         }
                         if let Some(&ay) = analog_axes.get(1) {
-                            machine.set_analog(ay, yrel);
+                            movie.set_analog(machine, ay, yrel);
                         }
                     }
                 }
@@ -423,7 +521,7 @@ pub fn run(
                         && let Some(id) =
                             input::mouse_button_to_input(machine.input_map(), mouse_btn)
                     {
-                        machine.set_input(id, true);
+                        movie.set_input(machine, id, true);
                     }
                 }
 
@@ -433,7 +531,7 @@ pub fn run(
                         && let Some(id) =
                             input::mouse_button_to_input(machine.input_map(), mouse_btn)
                     {
-                        machine.set_input(id, false);
+                        movie.set_input(machine, id, false);
                     }
                 }
 
@@ -443,8 +541,27 @@ pub fn run(
 
         let t1 = Instant::now();
 
-        // Execute based on debug state
-        let frame_executed = debug_ui::execute_frame(machine, &mut debug_state);
+        // Execute based on debug state. A playing movie supplies frames
+        // until it ends. While rewinding, restore the previous frame's
+        // starting state and replay that frame to redraw it; its audio is
+        // dropped rather than played forward.
+        let frame_executed = match rewind.as_mut() {
+            _ if movie.is_playing() && !debug_state.active => movie.play_frame(machine),
+            Some(history) if !debug_state.active && rewinding => {
+                if history.pop(&mut rewind_state) && machine.load_state(&rewind_state).is_ok() {
+                    machine.run_frame();
+                    machine.fill_audio(&mut audio_scratch);
+                }
+                false
+            }
+            Some(history) if !debug_state.active => {
+                if machine.save_state_into(&mut snapshot) {
+                    history.push(&snapshot);
+                }
+                debug_ui::execute_frame(machine, &mut debug_state)
+            }
+            _ => debug_ui::execute_frame(machine, &mut debug_state),
+        };
         let t2 = Instant::now();
 
         // Drain audio samples only when a full frame was executed
@@ -466,6 +583,10 @@ pub fn run(
                 }
             }
         }
+        // Keyframes are taken after the frame's audio is drained
+        if frame_executed && let MovieSession::Record(rec) = movie {
+            rec.end_frame(machine);
+        }
         let t3 = Instant::now();
 
         // Render: always render when paused (to show debug UI), otherwise respect throttle
@@ -473,6 +594,27 @@ pub fn run(
             || debug_state.run_mode == RunMode::Paused
             || last_render_time.elapsed() >= frame_duration;
 
+        // Run ahead from the frame just executed. Its audio has been
+        // drained, so the hidden frames' audio can simply be discarded.
+        // The hidden frames only feed the display, so skip them when this
+        // frame will not be presented.
+        let ran_ahead = if run_ahead > 0
+            && frame_executed
+            && should_render
+            && !debug_state.active
+            && !rewinding
+            && machine.save_state_into(&mut run_ahead_state)
+        {
+            for _ in 0..run_ahead {
+                machine.run_frame();
+                machine.fill_audio(&mut audio_scratch);
+            }
+            true
+        } else {
+            false
+        };
+        let t3a = Instant::now();
+
         if should_render {
             // Vector machines: render GL lines directly (no CPU framebuffer).
             // Falls back to CPU rasterization in debug or profiler mode
@@ -566,6 +708,12 @@ pub fn run(
         }
         let t4 = Instant::now();
 
+        // Drop the hidden frames and resume from the real one
+        if ran_ahead && let Err(e) = machine.load_state(&run_ahead_state) {
+            eprintln!("Run-ahead restore failed: {e}");
+        }
+        let t4a = Instant::now();
+
         // FPS: exponential moving average (α = 0.05) for a stable readout
         if show_fps {
             let now = Instant::now();
@@ -596,11 +744,30 @@ pub fn run(
             }
         }
 
+        nvram_countdown -= 1;
+        if nvram_countdown == 0 {
+            nvram_countdown = nvram_check_interval;
+            if let Some(data) = machine.save_nvram()
+                && last_nvram.as_deref() != Some(data)
+            {
+                last_nvram = Some(data.to_vec());
+                writer.nvram(data.to_vec(), nvram_path.to_path_buf());
+            }
+        }
+
         // Record profiling data for this frame
         if profile_state.active {
             let t5 = Instant::now();
             let sub_spans = machine.frame_profile_spans();
-            profile_state.record_frame(t1 - t0, t2 - t1, t3 - t2, t4 - t3, t5 - t4, sub_spans);
+            profile_state.record_frame(
+                t1 - t0,
+                t2 - t1,
+                t3 - t2,
+                (t3a - t3) + (t4a - t4),
+                t4 - t3a,
+                t5 - t4a,
+                sub_spans,
+            );
         }
     }
 
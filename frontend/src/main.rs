@@ -1,4 +1,5 @@
 use clap::Parser;
+use phosphor_core::core::machine::Accuracy;
 use phosphor_machines::registry;
 
 mod audio;
@@ -12,6 +13,7 @@ mod rom_path;
 mod screenshot;
 mod vector_gl;
 mod video;
+mod writer;
 
 #[derive(Parser)]
 #[command(name = "phosphor", about = "Cycle-accurate arcade machine emulator")]
@@ -38,6 +40,35 @@ struct Cli {
     #[arg(long)]
     no_mouse_grab: bool,
 
+    /// Run independent subsystems (e.g. Williams sound) on worker threads
+    #[arg(long)]
+    threads: bool,
+
+    /// Step every CPU and device one cycle at a time, even on machines
+    /// registered as scanline-safe
+    #[arg(long)]
+    cycle_accurate: bool,
+
+    /// Rewind history budget in MB; hold Backspace to step back (0 = off)
+    #[arg(long)]
+    rewind_mb: Option<u32>,
+
+    /// Frames to run ahead of the displayed frame to hide input lag (0 = off)
+    #[arg(long)]
+    run_ahead: Option<u32>,
+
+    /// Record every input to a movie file, written on exit
+    #[arg(long, value_name = "FILE", conflicts_with = "play")]
+    record: Option<String>,
+
+    /// Play back a movie file recorded with --record
+    #[arg(long, value_name = "FILE")]
+    play: Option<String>,
+
+    /// Seek the movie to this frame before starting playback
+    #[arg(long, value_name = "FRAME", requires = "play")]
+    play_from: Option<u64>,
+
     /// List available machines and exit
     #[arg(long, short)]
     list: bool,
@@ -77,6 +108,8 @@ fn main() {
 
     let rom_set = load_first_rom_set(entry.rom_names, &rom_path);
     let mut machine = (entry.create)(&rom_set).expect("Failed to initialize machine");
+    let rom_dict: std::sync::Arc<[u8]> = rom_set.dictionary().into();
+    let mut writer = writer::BackgroundWriter::new(rom_dict.clone());
 
     // Load battery-backed NVRAM from disk (if available)
     let nvram_path = nvram_path_for(&config, &machine_name);
@@ -89,12 +122,21 @@ fn main() {
         .scale
         .or(config.scale)
         .unwrap_or_else(|| auto_scale(native_w, native_h));
+    let rewind_mb = cli.rewind_mb.or(config.rewind_mb).unwrap_or(0);
+    let run_ahead = cli.run_ahead.or(config.run_ahead).unwrap_or(0);
 
     let save_path = save_path_for(&config, &machine_name);
     let screenshot_dir = screenshot_dir();
     let key_map = input::default_key_map(machine.input_map());
     let controller_map = input::default_controller_map(machine.input_map());
+    machine.set_threaded(cli.threads);
+    machine.set_accuracy(if cli.cycle_accurate {
+        Accuracy::Cycle
+    } else {
+        entry.accuracy
+    });
     machine.reset();
+    let mut movie = start_movie(machine.as_mut(), &cli.record, &cli.play, cli.play_from);
     emulator::run(
         machine.as_mut(),
         &key_map,
@@ -106,13 +148,65 @@ fn main() {
         cli.debug,
         cli.profile,
         cli.no_mouse_grab,
+        rewind_mb as usize * 1024 * 1024,
+        run_ahead,
+        &rom_dict,
+        &writer,
+        &nvram_path,
+        &mut movie,
     );
 
-    // Save battery-backed NVRAM to disk on exit
-    if let Some(data) = machine.save_nvram()
-        && let Err(e) = std::fs::write(&nvram_path, data)
-    {
-        eprintln!("Warning: failed to save NVRAM: {e}");
+    if let (emulator::MovieSession::Record(rec), Some(path)) = (movie, &cli.record) {
+        let movie = rec.finish();
+        match std::fs::write(path, movie.to_bytes()) {
+            Ok(()) => eprintln!("Movie written ({} frames)", movie.frames()),
+            Err(e) => eprintln!("Failed to write movie: {e}"),
+        }
+    }
+
+    // Save battery-backed NVRAM to disk on exit, then let queued writes land
+    if let Some(data) = machine.save_nvram() {
+        writer.nvram(data.to_vec(), nvram_path);
+    }
+    writer.finish();
+}
+
+/// Set up `--record` / `--play` from the freshly reset machine.
+fn start_movie(
+    machine: &mut dyn phosphor_core::core::machine::Machine,
+    record: &Option<String>,
+    play: &Option<String>,
+    play_from: Option<u64>,
+) -> emulator::MovieSession {
+    use phosphor_core::core::movie::{DEFAULT_KEYFRAME_INTERVAL, Movie};
+    use phosphor_core::core::{MoviePlayer, MovieRecorder};
+
+    if record.is_some() {
+        let Some(rec) = MovieRecorder::new(machine, DEFAULT_KEYFRAME_INTERVAL) else {
+            eprintln!("Movies need save state support, which this machine lacks");
+            std::process::exit(1);
+        };
+        return emulator::MovieSession::Record(rec);
+    }
+    let Some(path) = play else {
+        return emulator::MovieSession::Off;
+    };
+    let player = std::fs::read(path)
+        .map_err(|e| e.to_string())
+        .and_then(|data| Movie::from_bytes(&data).map_err(|e| e.to_string()))
+        .and_then(|movie| MoviePlayer::new(movie, machine).map_err(|e| e.to_string()))
+        .and_then(|mut player| {
+            player
+                .seek(machine, play_from.unwrap_or(0))
+                .map_err(|e| e.to_string())?;
+            Ok(player)
+        });
+    match player {
+        Ok(player) => emulator::MovieSession::Play(player),
+        Err(e) => {
+            eprintln!("Failed to load movie {path}: {e}");
+            std::process::exit(1);
+        }
     }
 }
 
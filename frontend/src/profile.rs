@@ -13,6 +13,8 @@ struct FrameTiming {
     input: Duration,
     emulation: Duration,
     audio: Duration,
+    /// Save, hidden frames and restore for run-ahead (zero when off).
+    run_ahead: Duration,
     render: Duration,
     idle: Duration,
 }
@@ -209,6 +211,7 @@ impl ProfileState {
         input: Duration,
         emulation: Duration,
         audio: Duration,
+        run_ahead: Duration,
         render: Duration,
         idle: Duration,
         machine_spans: &[ProfileSpan],
@@ -218,7 +221,7 @@ impl ProfileState {
         let frame_num = self.recorder.frame_count;
 
         // Active time excluding idle (for the frame span duration)
-        let active = input + emulation + audio + render;
+        let active = input + emulation + audio + run_ahead + render;
 
         // Frame-level span on the Frame track (shows active time only)
         self.recorder.record(
@@ -236,8 +239,12 @@ impl ProfileState {
             ("input", input),
             ("emulation", emulation),
             ("audio", audio),
+            ("run-ahead", run_ahead),
             ("render", render),
         ] {
+            if name == "run-ahead" && dur.is_zero() {
+                continue;
+            }
             self.recorder
                 .record(name.to_string(), "phase", TID_PHASE, offset + elapsed, dur);
             elapsed += dur;
@@ -261,6 +268,7 @@ impl ProfileState {
             input,
             emulation,
             audio,
+            run_ahead,
             render,
             idle,
         });
@@ -279,6 +287,7 @@ const COLOR_EMULATION: egui::Color32 = egui::Color32::from_rgb(80, 140, 255); //
 const COLOR_RENDER: egui::Color32 = egui::Color32::from_rgb(80, 200, 120); // green
 const COLOR_AUDIO: egui::Color32 = egui::Color32::from_rgb(255, 180, 60); // orange
 const COLOR_INPUT: egui::Color32 = egui::Color32::from_rgb(60, 200, 220); // cyan
+const COLOR_RUN_AHEAD: egui::Color32 = egui::Color32::from_rgb(170, 110, 230); // purple
 const COLOR_IDLE: egui::Color32 = egui::Color32::from_rgb(80, 80, 80); // dark gray
 
 /// Draw the profiling panel as a right-side panel (like the debugger).
@@ -322,6 +331,7 @@ pub fn draw_profile_panel(ctx: &egui::Context, state: &ProfileState, frame_budge
                         (frame.input, COLOR_INPUT),
                         (frame.audio, COLOR_AUDIO),
                         (frame.render, COLOR_RENDER),
+                        (frame.run_ahead, COLOR_RUN_AHEAD),
                         (frame.emulation, COLOR_EMULATION),
                     ] {
                         let h = (dur.as_secs_f64() * 1000.0 / max_ms) as f32 * chart_height;
@@ -382,33 +392,25 @@ pub fn draw_profile_panel(ctx: &egui::Context, state: &ProfileState, frame_budge
 /// Draw the color-coded legend with averaged timing values.
 fn draw_legend(ui: &mut egui::Ui, history: &ProfileHistory) {
     let n = history.frames.len();
-    let (avg_emu, avg_rnd, avg_aud, avg_inp, avg_idl) = if n > 0 {
-        let mut emu = 0.0_f64;
-        let mut rnd = 0.0_f64;
-        let mut aud = 0.0_f64;
-        let mut inp = 0.0_f64;
-        let mut idl = 0.0_f64;
+    let mut avg = [0.0_f64; 6];
+    if n > 0 {
         for f in &history.frames {
-            emu += f.emulation.as_secs_f64();
-            rnd += f.render.as_secs_f64();
-            aud += f.audio.as_secs_f64();
-            inp += f.input.as_secs_f64();
-            idl += f.idle.as_secs_f64();
+            for (sum, dur) in
+                avg.iter_mut()
+                    .zip([f.emulation, f.run_ahead, f.render, f.audio, f.input, f.idle])
+            {
+                *sum += dur.as_secs_f64();
+            }
         }
-        let d = n as f64;
-        (
-            emu / d * 1000.0,
-            rnd / d * 1000.0,
-            aud / d * 1000.0,
-            inp / d * 1000.0,
-            idl / d * 1000.0,
-        )
-    } else {
-        (0.0, 0.0, 0.0, 0.0, 0.0)
-    };
+        for v in &mut avg {
+            *v = *v / n as f64 * 1000.0;
+        }
+    }
+    let [avg_emu, avg_rah, avg_rnd, avg_aud, avg_inp, avg_idl] = avg;
 
     for &(color, label, value) in &[
         (COLOR_EMULATION, "emu", avg_emu),
+        (COLOR_RUN_AHEAD, "rah", avg_rah),
         (COLOR_RENDER, "rnd", avg_rnd),
         (COLOR_AUDIO, "aud", avg_aud),
         (COLOR_INPUT, "inp", avg_inp),
@@ -0,0 +1,165 @@
+//! Background file writer.
+//!
+//! Quick-saves, NVRAM flushes and screenshots are captured on the emulation
+//! thread as plain byte copies and handed to a worker thread, which does the
+//! compression, PNG encoding and disk I/O. The main loop never waits on the
+//! filesystem, so saving does not hitch frame pacing.
+//!
+//! Save states and NVRAM are written to a sibling temporary file and renamed
+//! over the target, so a crash or full disk mid-write leaves the previous
+//! file intact instead of a truncated one.
+
+use std::io::Write;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::sync::mpsc::{self, Sender};
+use std::thread::JoinHandle;
+
+use phosphor_core::core::save_state;
+
+enum Job {
+    /// Raw `save_state()` bytes, packed on the worker.
+    SaveState {
+        raw: Vec<u8>,
+        path: PathBuf,
+    },
+    Nvram {
+        data: Vec<u8>,
+        path: PathBuf,
+    },
+    Screenshot {
+        rgb24: Vec<u8>,
+        width: u32,
+        height: u32,
+        dir: PathBuf,
+        prefix: String,
+    },
+    /// Reply once every earlier job is done.
+    Sync(Sender<()>),
+}
+
+pub struct BackgroundWriter {
+    tx: Option<Sender<Job>>,
+    thread: Option<JoinHandle<()>>,
+}
+
+impl BackgroundWriter {
+    /// Start the worker. `rom_dict` is the dictionary save states are packed
+    /// against (see `RomSet::dictionary`).
+    pub fn new(rom_dict: Arc<[u8]>) -> Self {
+        let (tx, rx) = mpsc::channel::<Job>();
+        let thread = std::thread::Builder::new()
+            .name("phosphor-writer".into())
+            .spawn(move || {
+                for job in rx {
+                    run_job(job, &rom_dict);
+                }
+            })
+            .expect("failed to spawn writer thread");
+        Self {
+            tx: Some(tx),
+            thread: Some(thread),
+        }
+    }
+
+    fn submit(&self, job: Job) {
+        if let Some(tx) = &self.tx {
+            // The worker only exits once the sender is dropped
+            let _ = tx.send(job);
+        }
+    }
+
+    pub fn save_state(&self, raw: Vec<u8>, path: PathBuf) {
+        self.submit(Job::SaveState { raw, path });
+    }
+
+    pub fn nvram(&self, data: Vec<u8>, path: PathBuf) {
+        self.submit(Job::Nvram { data, path });
+    }
+
+    pub fn screenshot(&self, rgb24: Vec<u8>, width: u32, height: u32, dir: PathBuf, prefix: &str) {
+        self.submit(Job::Screenshot {
+            rgb24,
+            width,
+            height,
+            dir,
+            prefix: prefix.to_string(),
+        });
+    }
+
+    /// Block until every job queued so far has been written, e.g. before
+    /// reading back a save file that may still be in flight.
+    pub fn wait_idle(&self) {
+        let (done_tx, done_rx) = mpsc::channel();
+        self.submit(Job::Sync(done_tx));
+        let _ = done_rx.recv();
+    }
+
+    /// Wait for every queued job to finish and stop the worker. Called
+    /// before exit.
+    pub fn finish(&mut self) {
+        self.tx.take();
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+impl Drop for BackgroundWriter {
+    fn drop(&mut self) {
+        self.finish();
+    }
+}
+
+fn run_job(job: Job, rom_dict: &[u8]) {
+    match job {
+        Job::SaveState { raw, path } => {
+            let packed = save_state::pack_state(&raw, rom_dict);
+            match write_atomic(&path, &packed) {
+                Ok(()) => eprintln!(
+                    "Save state written ({} bytes, {} raw)",
+                    packed.len(),
+                    raw.len()
+                ),
+                Err(e) => eprintln!("Save state failed: {e}"),
+            }
+        }
+        Job::Nvram { data, path } => {
+            if let Err(e) = write_atomic(&path, &data) {
+                eprintln!("Warning: failed to save NVRAM: {e}");
+            }
+        }
+        Job::Screenshot {
+            rgb24,
+            width,
+            height,
+            dir,
+            prefix,
+        } => match crate::screenshot::save_screenshot(&rgb24, width, height, &dir, &prefix) {
+            Ok(path) => eprintln!("Screenshot saved: {}", path.display()),
+            Err(e) => eprintln!("Screenshot failed: {e}"),
+        },
+        Job::Sync(done) => {
+            let _ = done.send(());
+        }
+    }
+}
+
+/// Write `data` to `path` by way of `<path>.tmp`: the bytes are synced to
+/// disk before the rename replaces the target, so readers see either the
+/// old file or the complete new one.
+fn write_atomic(path: &Path, data: &[u8]) -> std::io::Result<()> {
+    let mut tmp = path.as_os_str().to_owned();
+    tmp.push(".tmp");
+    let tmp = PathBuf::from(tmp);
+    let result = std::fs::File::create(&tmp)
+        .and_then(|mut file| {
+            file.write_all(data)?;
+            file.sync_all()
+        })
+        .and_then(|()| std::fs::rename(&tmp, path));
+    if result.is_err() {
+        let _ = std::fs::remove_file(&tmp);
+    }
+    result
+}
@@ -0,0 +1,254 @@
+//! Whole-machine frame throughput.
+//!
+//! The `norom` machines run from their power-on state without ROMs (the
+//! CPUs execute whatever the empty ROM space decodes to), which still
+//! exercises the scheduler, bus decoding, video timing and sound devices
+//! every frame.
+//!
+//! Every registered machine is also benched on a synthetic ROM set: every
+//! file is noise (so graphics decode to busy tiles) with a short program in
+//! each 256-byte page that stores to every address in turn, driving the
+//! machine's RAM, video and sound hardware. Machines the registry runs at
+//! scanline accuracy are benched at cycle accuracy as well, and the Namco
+//! Galaga boards, whose scanline level is opt-in, at both.
+//!
+//! Set `PHOSPHOR_BENCH_ROMS=<dir>` to also bench every registered machine
+//! whose ROM set is unpacked under `<dir>/<rom set name>/`, running real
+//! game code.
+
+#[path = "../../core/benches/harness/mod.rs"]
+mod harness;
+
+use harness::Bench;
+use phosphor_core::core::machine::{Accuracy, Machine};
+use phosphor_machines::registry::{self, MachineEntry};
+use phosphor_machines::rom_loader::{RomLoadError, RomSet};
+use phosphor_machines::*;
+
+/// Emulated frames per timed iteration.
+const FRAMES: u64 = 10;
+
+type Factory = fn() -> Box<dyn Machine>;
+
+/// CPU family whose code the synthetic ROMs carry.
+#[derive(Clone, Copy)]
+enum Cpu {
+    Z80,
+    /// Also runs the Williams 6800 sound CPU: the loop decodes the same way.
+    M6809,
+    M6502,
+    I8088,
+}
+
+impl Cpu {
+    /// Code and vectors patched in at these offsets of every 256-byte page,
+    /// so they are in place wherever a ROM is mapped. Families that share a
+    /// board (the 8088 and 6502 on Gottlieb) use disjoint offsets.
+    fn page_code(self) -> &'static [(usize, &'static [u8])] {
+        match self {
+            Cpu::Z80 => &[
+                // DI; LD HL,0; loop: LD (HL),A; INC HL; ADD A,L; JR loop
+                (
+                    0x00,
+                    &[0xF3, 0x21, 0x00, 0x00, 0x77, 0x23, 0x85, 0x18, 0xFB],
+                ),
+                // NMI: JR loop (SP may point anywhere, so never return)
+                (0x66, &[0x18, 0x9C]),
+            ],
+            Cpu::M6809 => &[
+                // ORCC #$50; LDX #0; loop: STA ,X+; ADDA #$3B; BRA loop
+                (
+                    0x00,
+                    &[
+                        0x1A, 0x50, 0x8E, 0x00, 0x00, 0xA7, 0x80, 0x8B, 0x3B, 0x20, 0xFA,
+                    ],
+                ),
+                // Every vector (6809 FIRQ..RESET, 6800 IRQ..RESET) -> $FF00
+                (
+                    0xF0,
+                    &[
+                        0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+                        0xFF, 0x00, 0xFF, 0x00,
+                    ],
+                ),
+            ],
+            Cpu::M6502 => &[
+                // SEI; CLD; LDX #$FF; TXS; LDY #0; STY $00
+                // start: LDA #2; STA $01
+                // loop: STA ($00),Y; ADC #$3B; INY; BNE loop
+                //       INC $01; BNE loop; BEQ start
+                (
+                    0x10,
+                    &[
+                        0x78, 0xD8, 0xA2, 0xFF, 0x9A, 0xA0, 0x00, 0x84, 0x00, 0xA9, 0x02, 0x85,
+                        0x01, 0x91, 0x00, 0x69, 0x3B, 0xC8, 0xD0, 0xF9, 0xE6, 0x01, 0xD0, 0xF5,
+                        0xF0, 0xEF,
+                    ],
+                ),
+                // NMI, RESET, IRQ -> $FF10
+                (0xFA, &[0x10, 0xFF, 0x10, 0xFF, 0x10, 0xFF]),
+            ],
+            Cpu::I8088 => &[
+                // CLI; CLD; XOR DI,DI; MOV ES,DI; MOV DS,DI
+                // MOV WORD [0008h],0FF40h; MOV WORD [000Ah],0F000h (NMI)
+                // start: MOV DI,0400h
+                // loop: STOSB; ADD AL,3Bh; OR DI,DI; JNZ loop; JMP start
+                (
+                    0x40,
+                    &[
+                        0xFA, 0xFC, 0x31, 0xFF, 0x8E, 0xC7, 0x8E, 0xDF, 0xC7, 0x06, 0x08, 0x00,
+                        0x40, 0xFF, 0xC7, 0x06, 0x0A, 0x00, 0x00, 0xF0, 0xBF, 0x00, 0x04, 0xAA,
+                        0x04, 0x3B, 0x09, 0xFF, 0x75, 0xF9, 0xEB, 0xF4,
+                    ],
+                ),
+                // Reset entry (FFFF:0000): JMP F000:FF40
+                (0xF0, &[0xEA, 0x40, 0xFF, 0x00, 0xF0]),
+            ],
+        }
+    }
+}
+
+/// CPU families of a registered machine's boards, by registry name.
+fn machine_cpus(name: &str) -> Option<&'static [Cpu]> {
+    Some(match name {
+        "joust" | "robotron" | "gridlee" => &[Cpu::M6809],
+        "asteroid" | "astdelux" | "llander" | "missile" | "tempest" | "ccastles" => &[Cpu::M6502],
+        "pacman" | "mspacman" | "dkong" | "dkongjr" | "galaga" | "digdug" | "shollow" => {
+            &[Cpu::Z80]
+        }
+        "qbert" => &[Cpu::I8088, Cpu::M6502],
+        _ => return None,
+    })
+}
+
+fn synthetic_rom(cpus: &[Cpu], len: usize, mut seed: u32) -> Vec<u8> {
+    let mut data: Vec<u8> = (0..len)
+        .map(|_| {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            seed as u8
+        })
+        .collect();
+    for page in data.chunks_mut(0x100) {
+        for &(offset, code) in cpus.iter().flat_map(|cpu| cpu.page_code()) {
+            if let Some(dst) = page.get_mut(offset..offset + code.len()) {
+                dst.copy_from_slice(code);
+            }
+        }
+    }
+    data
+}
+
+/// Create a machine from a synthetic ROM set, adding each file its loader
+/// reports missing and sizing it from the mismatch it reports next.
+fn synthetic_machine(entry: &MachineEntry, cpus: &[Cpu]) -> Result<Box<dyn Machine>, RomLoadError> {
+    let mut files: Vec<(String, Vec<u8>)> = Vec::new();
+    loop {
+        let rom_set = RomSet::from_entries(files.clone()).skip_checksums();
+        match (entry.create)(&rom_set) {
+            Err(RomLoadError::MissingFile(name)) => files.push((name, Vec::new())),
+            Err(RomLoadError::SizeMismatch { file, expected, .. }) => {
+                let seed = files.len() as u32;
+                let (_, data) = files.iter_mut().find(|(name, _)| *name == file).unwrap();
+                assert!(data.is_empty(), "{file} is loaded at two sizes");
+                *data = synthetic_rom(cpus, expected, seed);
+            }
+            result => return result,
+        }
+    }
+}
+
+fn bench_machine(bench: &Bench, name: &str, mut machine: Box<dyn Machine>) {
+    machine.reset();
+    let (w, h) = machine.display_size();
+    let mut framebuffer = vec![0u8; (w * h * 3) as usize];
+    let mut audio = vec![0i16; 4096];
+
+    bench.run(&format!("{name}/run_frame"), FRAMES, "frames", || {
+        for _ in 0..FRAMES {
+            machine.run_frame();
+            while machine.fill_audio(&mut audio) == audio.len() {}
+        }
+    });
+    bench.run(&format!("{name}/render_frame"), 1, "frames", || {
+        machine.render_frame(&mut framebuffer);
+    });
+}
+
+fn main() {
+    let bench = Bench::from_args();
+
+    let rom_free: [(&str, Factory); 10] = [
+        ("joust", || Box::new(JoustSystem::new())),
+        ("robotron", || Box::new(RobotronSystem::new())),
+        ("pacman", || Box::new(PacmanSystem::new())),
+        ("mspacman", || Box::new(MsPacmanSystem::new())),
+        ("asteroid", || Box::new(AsteroidsSystem::new())),
+        ("astdelux", || Box::new(AsteroidsDeluxeSystem::new())),
+        ("llander", || Box::new(LunarLanderSystem::new())),
+        ("missile", || Box::new(MissileCommandSystem::new())),
+        ("gridlee", || Box::new(GridleeSystem::new())),
+        ("tempest", || Box::new(TempestSystem::new())),
+    ];
+    for (name, create) in rom_free {
+        let mut machine = create();
+        if let Some(entry) = registry::find(name) {
+            machine.set_accuracy(entry.accuracy);
+        }
+        bench_machine(&bench, &format!("norom/{name}"), machine);
+    }
+
+    for entry in registry::all() {
+        let Some(cpus) = machine_cpus(entry.name) else {
+            eprintln!(
+                "synthetic/{}: no synthetic program for its CPUs",
+                entry.name
+            );
+            continue;
+        };
+        let mut levels = vec![entry.accuracy];
+        if entry.accuracy != Accuracy::Cycle {
+            levels.push(Accuracy::Cycle);
+        } else if matches!(entry.name, "galaga" | "digdug") {
+            levels.push(Accuracy::Scanline);
+        }
+        for accuracy in levels {
+            let mut machine = match synthetic_machine(entry, cpus) {
+                Ok(machine) => machine,
+                Err(e) => {
+                    eprintln!("synthetic/{}: {e}", entry.name);
+                    break;
+                }
+            };
+            machine.set_accuracy(accuracy);
+            let level = match accuracy {
+                Accuracy::Cycle => "cycle",
+                Accuracy::Scanline => "scanline",
+            };
+            bench_machine(
+                &bench,
+                &format!("synthetic/{}/{level}", entry.name),
+                machine,
+            );
+        }
+    }
+
+    let Some(dir) = std::env::var_os("PHOSPHOR_BENCH_ROMS") else {
+        return;
+    };
+    let dir = std::path::PathBuf::from(dir);
+    for entry in registry::all() {
+        let machine = entry.rom_names.iter().find_map(|rom_name| {
+            let rom_set = RomSet::from_directory(&dir.join(rom_name)).ok()?;
+            (entry.create)(&rom_set).ok()
+        });
+        match machine {
+            Some(mut machine) => {
+                machine.set_accuracy(entry.accuracy);
+                bench_machine(&bench, &format!("rom/{}", entry.name), machine);
+            }
+            None => eprintln!("rom/{}: no ROM set under {}", entry.name, dir.display()),
+        }
+    }
+}
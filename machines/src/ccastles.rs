@@ -5,13 +5,13 @@ use phosphor_core::core::machine::{
 };
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{self, SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, TimingConfig};
+use phosphor_core::core::{BeamPosition, Bus, BusMaster, TimingConfig};
 use phosphor_core::cpu::m6502::M6502;
 use phosphor_core::cpu::state::M6502State;
 use phosphor_core::cpu::{Cpu, CpuStateTrait};
 use phosphor_core::device::output_latch::OutputLatch;
 use phosphor_core::device::pokey::Pokey;
-use phosphor_core::gfx::decode::{GfxCache, GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::{GfxCache, GfxLayout};
 use phosphor_macros::{BusDebug, MemoryRegion};
 
 use crate::registry::MachineEntry;
@@ -346,6 +346,8 @@ pub struct CrystalCastlesSystem {
 
     // System timing
     clock: u64,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
     watchdog_frame_count: u8,
 
     // Rendering
@@ -448,6 +450,7 @@ impl CrystalCastlesSystem {
 
             irq_state: false,
             clock: 0,
+            beam: BeamPosition::new(),
             watchdog_frame_count: 0,
 
             vblank_end: 24,
@@ -461,8 +464,7 @@ impl CrystalCastlesSystem {
 
     /// Current scanline (V counter), 0-255.
     pub fn current_scanline(&self) -> u16 {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        (frame_cycle / TIMING.cycles_per_scanline) as u16
+        self.beam.scanline() as u16
     }
 
     pub fn load_rom_set(&mut self, rom_set: &RomSet) -> Result<(), RomLoadError> {
@@ -476,7 +478,9 @@ impl CrystalCastlesSystem {
 
         let gfx = CCASTLES_GFX_ROM.load(rom_set)?;
         self.gfx_rom.copy_from_slice(&gfx);
-        self.sprite_cache = decode_gfx(&self.gfx_rom, 0, 256, &CCASTLES_SPRITE_LAYOUT);
+        self.sprite_cache = rom_set
+            .gfx()
+            .decode(&self.gfx_rom, 0, 256, &CCASTLES_SPRITE_LAYOUT);
 
         let sync = CCASTLES_SYNC_PROM.load(rom_set)?;
         self.sync_prom.copy_from_slice(&sync);
@@ -502,7 +506,8 @@ impl CrystalCastlesSystem {
     /// Rebuild sprite cache from gfx_rom (for tests that modify ROM data directly).
     #[cfg(test)]
     fn decode_sprite_cache(&mut self) {
-        self.sprite_cache = decode_gfx(&self.gfx_rom, 0, 256, &CCASTLES_SPRITE_LAYOUT);
+        self.sprite_cache =
+            phosphor_core::gfx::decode::decode_gfx(&self.gfx_rom, 0, 256, &CCASTLES_SPRITE_LAYOUT);
     }
 
     // -----------------------------------------------------------------------
@@ -802,9 +807,8 @@ impl CrystalCastlesSystem {
         }
 
         // Per-scanline processing: IRQ generation, VBLANK, and rendering
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = (frame_cycle / TIMING.cycles_per_scanline) as u8;
+        if self.beam.at_line_start() {
+            let scanline = self.beam.scanline() as u8;
 
             // IRQ generation from sync PROM rising edges on bit 3
             let prev = if scanline == 0 { 255 } else { scanline - 1 };
@@ -842,6 +846,7 @@ impl CrystalCastlesSystem {
         });
 
         self.clock += 1;
+        self.beam.step(&TIMING);
     }
 }
 
@@ -1090,6 +1095,7 @@ impl Saveable for CrystalCastlesSystem {
         self.mouse_accum_y = r.read_i32_le()?;
         self.irq_state = r.read_bool()?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
         self.watchdog_frame_count = r.read_u8()?;
         self.dip_switches = r.read_u8()?;
         // Recompute derived state
@@ -1160,6 +1166,10 @@ impl Machine for CrystalCastlesSystem {
         TIMING.frame_rate_hz()
     }
 
+    fn cpu_clock_hz(&self) -> Option<u64> {
+        Some(TIMING.cpu_clock_hz)
+    }
+
     fn machine_id(&self) -> &str {
         "ccastles"
     }
@@ -1168,6 +1178,11 @@ impl Machine for CrystalCastlesSystem {
         Some(save_state::save_machine(self, self.machine_id()))
     }
 
+    fn save_state_into(&self, buf: &mut Vec<u8>) -> bool {
+        save_state::save_machine_into(self, self.machine_id(), buf);
+        true
+    }
+
     fn load_state(&mut self, data: &[u8]) -> Result<(), SaveError> {
         let id = self.machine_id().to_string();
         save_state::load_machine(self, &id, data)
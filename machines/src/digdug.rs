@@ -1,13 +1,15 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
 use phosphor_core::core::debug::{BusDebug, DebugCpu, Debuggable};
-use phosphor_core::core::machine::{AudioSource, InputReceiver, Machine, MachineDebug, Renderable};
+use phosphor_core::core::machine::{
+    Accuracy, AudioSource, InputReceiver, Machine, MachineDebug, Renderable,
+};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_core::device::Er2055;
 use phosphor_core::gfx;
 use phosphor_core::gfx::GfxCache;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::GfxLayout;
 use phosphor_macros::Saveable;
 
 use crate::namco_galaga::{self, GALAGA_SPRITE_LAYOUT, NamcoGalagaBoard};
@@ -583,13 +585,19 @@ impl DigDugSystem {
 
         // GFX ROMs
         let gfx1 = config.gfx1_rom.load(rom_set)?;
-        self.char_cache = decode_gfx(&gfx1, 0, gfx1.len() / 8, &DIGDUG_CHAR_LAYOUT);
+        self.char_cache = rom_set
+            .gfx()
+            .decode(&gfx1, 0, gfx1.len() / 8, &DIGDUG_CHAR_LAYOUT);
 
         let gfx2 = config.gfx2_rom.load(rom_set)?;
-        self.sprite_cache = decode_gfx(&gfx2, 0, gfx2.len() / 64, &GALAGA_SPRITE_LAYOUT);
+        self.sprite_cache = rom_set
+            .gfx()
+            .decode(&gfx2, 0, gfx2.len() / 64, &GALAGA_SPRITE_LAYOUT);
 
         let gfx3 = config.gfx3_rom.load(rom_set)?;
-        self.bg_tile_cache = decode_gfx(&gfx3, 0, gfx3.len() / 16, &PACMAN_TILE_LAYOUT);
+        self.bg_tile_cache = rom_set
+            .gfx()
+            .decode(&gfx3, 0, gfx3.len() / 16, &PACMAN_TILE_LAYOUT);
 
         self.playfield_rom = config.gfx4_rom.load(rom_set)?;
 
@@ -916,6 +924,10 @@ impl Bus for DigDugSystem {
     }
 
     fn write(&mut self, _master: BusMaster, addr: u16, data: u8) {
+        // All RAM is shared by the three CPUs: let the others catch up.
+        if let 0x8000..=0x9BFF = addr {
+            self.board.request_yield();
+        }
         match addr {
             0x0000..=0x3FFF => {} // ROM
             0x6800..=0x681F => self.board.wsg.write(addr - 0x6800, data),
@@ -1085,13 +1097,16 @@ impl Machine for DigDugSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..namco_galaga::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board
+                .run_cycles(bus, namco_galaga::TIMING.cycles_per_frame());
         });
         self.render_video();
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset_board();
         self.video_ram.fill(0);
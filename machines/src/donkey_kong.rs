@@ -1,6 +1,6 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
-use phosphor_core::core::machine::{InputButton, InputReceiver, Machine};
+use phosphor_core::core::machine::{Accuracy, InputButton, InputReceiver, Machine};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_macros::Saveable;
@@ -268,9 +268,17 @@ impl DkongSystem {
             .copy_from_slice(&prom_data[0x200..0x300]);
 
         self.board.build_palette();
-        self.board.decode_gfx_roms();
+        self.board.decode_gfx_roms(rom_set.gfx());
         Ok(())
     }
+
+    /// Catch the sound side up before the main CPU touches it (see
+    /// [`Tkg04Board::sync_sound`]).
+    fn sync_sound(&mut self) {
+        bus_split!(self, bus => {
+            self.board.sync_sound(bus);
+        });
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -302,6 +310,7 @@ impl Bus for DkongSystem {
                         0x7C80 => self.board.in1,
                         0x7D00 => {
                             // IN2: active-high inputs + sound status at bit 6
+                            self.sync_sound();
                             let sound_status = if self.board.sound_cpu.p2 & 0x10 != 0 {
                                 0x00
                             } else {
@@ -339,16 +348,21 @@ impl Bus for DkongSystem {
                     }
                     MainRegion::IO_PORTS => match addr {
                         // Sound latch (ls175.3d)
-                        0x7C00 => self.board.sound_latch = data,
+                        0x7C00 => {
+                            self.sync_sound();
+                            self.board.sound_latch = data;
+                        }
 
                         // 74LS259 sound control latch: addr bits 0-2 select bit
                         0x7D00..=0x7D07 => {
+                            self.sync_sound();
                             let bit = (addr & 0x07) as u8;
                             self.board.write_sound_control_bit(bit, data & 1 != 0);
                         }
 
                         // Sound CPU IRQ trigger
                         0x7D80 => {
+                            self.sync_sound();
                             self.board.sound_irq_pending = data != 0;
                         }
 
@@ -518,12 +532,14 @@ impl Machine for DkongSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..tkg04::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board.run_cycles(bus, tkg04::TIMING.cycles_per_frame());
         });
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset();
         self.board.dsw0 = 0x80; // upright cabinet, 3 lives, 7000 bonus, 1 coin/1 play
@@ -547,7 +563,7 @@ fn create_machine(
 }
 
 inventory::submit! {
-    MachineEntry::new("dkong", &["dkong"], create_machine)
+    MachineEntry::new("dkong", &["dkong"], create_machine).with_accuracy(Accuracy::Scanline)
 }
 
 // ---------------------------------------------------------------------------
@@ -557,8 +573,9 @@ inventory::submit! {
 #[cfg(test)]
 mod tests {
     use super::*;
-    use phosphor_core::core::machine::Machine;
+    use phosphor_core::core::machine::{AudioSource, Machine, Renderable};
     use phosphor_core::cpu::CpuStateTrait;
+    use phosphor_core::gfx::decode::GfxDecodes;
 
     #[test]
     fn save_load_round_trip() {
@@ -633,6 +650,17 @@ mod tests {
         assert!(sys2.board.vblank_nmi_pending);
     }
 
+    #[test]
+    fn sprite_bank_bit_wraps_on_128_sprite_set() {
+        let mut sys = DkongSystem::new();
+        sys.board.decode_gfx_roms(&GfxDecodes::default());
+        // Sprite 0 on scanline 100 with the bank bit (attr 0x40) set: DK has
+        // no second bank of sprites, so this must draw sprite 0x7F
+        let sprites = sys.board.main_map.region_data_mut(MainRegion::SpriteRam);
+        sprites[..4].copy_from_slice(&[0x93, 0x7F, 0x40, 0x80]);
+        sys.board.render_scanline(100);
+    }
+
     #[test]
     fn save_does_not_include_rom() {
         let mut sys = DkongSystem::new();
@@ -651,4 +679,140 @@ mod tests {
         assert_eq!(sys2.board.tile_rom[0], 0x00);
         assert_eq!(sys2.board.sprite_rom[0], 0x00);
     }
+
+    /// Run a synthetic main/sound program pair: the Z80 streams video RAM
+    /// writes, sound commands, control latch bits and sound IRQs and folds
+    /// the sound CPU's status bit back into what it draws; the I8035 feeds
+    /// commands to the DAC and drives its status bit from what it reads.
+    /// Returns per-frame hashes of the rendered image, the audio stream,
+    /// and the final save state.
+    fn run_scanline_test_program(
+        accuracy: Accuracy,
+        frames: usize,
+    ) -> (Vec<u64>, Vec<i16>, Vec<u8>) {
+        use std::hash::{DefaultHasher, Hash, Hasher};
+
+        #[rustfmt::skip]
+        let main_program: &[u8] = &[
+            0x31, 0x00, 0x70, // LD SP,$7000
+            0x3E, 0x01,       // LD A,1
+            0x32, 0x84, 0x7D, // LD ($7D84),A   ; NMI mask
+            0x21, 0x00, 0x74, // LD HL,$7400
+            0x11, 0x00, 0x00, // LD DE,0
+            // loop:
+            0x1C,             // INC E
+            0x7B,             // LD A,E
+            0x77,             // LD (HL),A      ; video RAM
+            0x23,             // INC HL
+            0x7C,             // LD A,H
+            0xE6, 0x03,       // AND 3
+            0xF6, 0x74,       // OR $74
+            0x67,             // LD H,A         ; wrap HL within $7400-$77FF
+            0x7B,             // LD A,E
+            0x82,             // ADD A,D
+            0x32, 0x00, 0x7C, // LD ($7C00),A   ; sound latch
+            0x32, 0x00, 0x7D, // LD ($7D00),A   ; control bit 0 (discrete)
+            0x0F,             // RRCA
+            0x32, 0x01, 0x7D, // LD ($7D01),A   ; control bit 1 (discrete)
+            0x0F,             // RRCA
+            0x32, 0x03, 0x7D, // LD ($7D03),A   ; control bit 3 (sound P2)
+            0x0F,             // RRCA
+            0x32, 0x05, 0x7D, // LD ($7D05),A   ; control bit 5 (sound T0)
+            0x43,             // LD B,E
+            0x10, 0xFE,       // DJNZ $         ; move the read around the line
+            0x3A, 0x00, 0x7D, // LD A,($7D00)   ; IN2 with sound status
+            0x83,             // ADD A,E
+            0x5F,             // LD E,A
+            0xE6, 0x01,       // AND 1
+            0x32, 0x80, 0x7D, // LD ($7D80),A   ; sound IRQ
+            0x18, 0xD3,       // JR loop
+        ];
+        #[rustfmt::skip]
+        let nmi: &[u8] = &[
+            0xF5,             // PUSH AF
+            0x14,             // INC D          ; frame counter
+            0xF1,             // POP AF
+            0xED, 0x45,       // RETN
+        ];
+        #[rustfmt::skip]
+        let sound_program: &[u8] = &[
+            0x04, 0x10,       // JMP $010
+            0x00,
+            0x1A,             // INC R2         ; IRQ handler
+            0x93,             // RETR
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05,             // EN I
+            // loop:
+            0x80,             // MOVX A,@R0     ; sound latch
+            0x6A,             // ADD A,R2
+            0x39,             // OUTL P1,A      ; DAC
+            0x19,             // INC R1
+            0x0A,             // IN A,P2        ; control latch bit 3
+            0x53, 0x20,       // ANL A,#$20
+            0x69,             // ADD A,R1
+            0x47,             // SWAP A         ; R1 bit 0 -> bit 4
+            0x43, 0x40,       // ORL A,#$40     ; stay in command mode
+            0x3A,             // OUTL P2,A      ; bit 4 = status to main
+            0x04, 0x11,       // JMP loop
+        ];
+        let mut main_rom = vec![0u8; 0x6000];
+        main_rom[..main_program.len()].copy_from_slice(main_program);
+        main_rom[0x66..0x66 + nmi.len()].copy_from_slice(nmi);
+
+        let mut sys = DkongSystem::new();
+        sys.board.main_map.load_region(MainRegion::Rom, &main_rom);
+        let mut sound_rom = vec![0u8; 0x1000];
+        sound_rom[..sound_program.len()].copy_from_slice(sound_program);
+        sys.board
+            .sound_map
+            .load_region(SoundRegion::Rom, &sound_rom);
+        for (i, b) in sys.board.tile_rom.iter_mut().enumerate() {
+            *b = (i * 37 + (i >> 5)) as u8;
+        }
+        for (i, b) in sys.board.sprite_rom.iter_mut().enumerate() {
+            *b = (i * 13) as u8;
+        }
+        for (i, b) in sys.board.palette_prom.iter_mut().enumerate() {
+            *b = (i * 11) as u8;
+        }
+        sys.board.build_palette();
+        sys.board.decode_gfx_roms(&GfxDecodes::default());
+        sys.set_accuracy(accuracy);
+        sys.reset();
+
+        let (w, h) = sys.display_size();
+        let mut image = vec![0u8; (w * h * 3) as usize];
+        let mut chunk = [0i16; 2048];
+        let mut hashes = Vec::with_capacity(frames);
+        let mut audio = Vec::new();
+        for _ in 0..frames {
+            sys.run_frame();
+            sys.render_frame(&mut image);
+            let mut hasher = DefaultHasher::new();
+            image.hash(&mut hasher);
+            hashes.push(hasher.finish());
+            let n = sys.fill_audio(&mut chunk);
+            audio.extend_from_slice(&chunk[..n]);
+        }
+        (hashes, audio, sys.save_state().unwrap())
+    }
+
+    #[test]
+    fn scanline_accuracy_matches_cycle_stepping() {
+        const FRAMES: usize = 2000;
+        let (cycle_frames, cycle_audio, cycle_state) =
+            run_scanline_test_program(Accuracy::Cycle, FRAMES);
+        let (line_frames, line_audio, line_state) =
+            run_scanline_test_program(Accuracy::Scanline, FRAMES);
+
+        // The programs must actually exercise video and sound
+        assert!(cycle_frames.windows(2).any(|w| w[0] != w[1]));
+        assert!(cycle_audio.iter().any(|&s| s != cycle_audio[0]));
+
+        for (frame, (a, b)) in cycle_frames.iter().zip(&line_frames).enumerate() {
+            assert_eq!(a, b, "frame {frame} differs");
+        }
+        assert_eq!(cycle_audio, line_audio);
+        assert_eq!(cycle_state, line_state);
+    }
 }
@@ -1,6 +1,6 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
-use phosphor_core::core::machine::{InputButton, InputReceiver, Machine};
+use phosphor_core::core::machine::{Accuracy, InputButton, InputReceiver, Machine};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_macros::Saveable;
@@ -255,9 +255,17 @@ impl DkongJrSystem {
             .copy_from_slice(&prom_data[0x200..0x300]);
 
         self.board.build_palette();
-        self.board.decode_gfx_roms();
+        self.board.decode_gfx_roms(rom_set.gfx());
         Ok(())
     }
+
+    /// Catch the sound side up before the main CPU touches it (see
+    /// [`Tkg04Board::sync_sound`]).
+    fn sync_sound(&mut self) {
+        bus_split!(self, bus => {
+            self.board.sync_sound(bus);
+        });
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -321,10 +329,14 @@ impl Bus for DkongJrSystem {
                     }
                     MainRegion::IO_PORTS => match addr {
                         // Sound latch (ls174.3d)
-                        0x7C00 => self.board.sound_latch = data,
+                        0x7C00 => {
+                            self.sync_sound();
+                            self.board.sound_latch = data;
+                        }
 
                         // ls259.4h latch (0x7C80-0x7C87): sound/gfx control
                         0x7C80..=0x7C87 => {
+                            self.sync_sound();
                             let bit = (addr & 0x07) as u8;
                             self.board.sound_control_latch_4h.write(bit, data & 1 != 0);
                             // Bit 0 of ls259.4h is also the gfx bank select
@@ -335,6 +347,7 @@ impl Bus for DkongJrSystem {
 
                         // 74LS259 sound control latch (dev_6h): addr bits 0-2 select bit
                         0x7D00..=0x7D07 => {
+                            self.sync_sound();
                             let bit = (addr & 0x07) as u8;
                             self.board.write_sound_control_bit(bit, data & 1 != 0);
                         }
@@ -342,6 +355,7 @@ impl Bus for DkongJrSystem {
                         // ls259.5h latch (0x7D80-0x7D87)
                         // 0x7D80 also triggers sound CPU IRQ
                         0x7D80 => {
+                            self.sync_sound();
                             self.board.sound_irq_pending = data != 0;
                         }
 
@@ -508,12 +522,14 @@ impl Machine for DkongJrSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..tkg04::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board.run_cycles(bus, tkg04::TIMING.cycles_per_frame());
         });
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset();
         self.board.dsw0 = 0x80; // upright cabinet, 3 lives, 10000 bonus, 1 coin/1 play
@@ -537,5 +553,5 @@ fn create_machine(
 }
 
 inventory::submit! {
-    MachineEntry::new("dkongjr", &["dkongjr"], create_machine)
+    MachineEntry::new("dkongjr", &["dkongjr"], create_machine).with_accuracy(Accuracy::Scanline)
 }
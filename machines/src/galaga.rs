@@ -1,12 +1,14 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
 use phosphor_core::core::debug::{BusDebug, DebugCpu, Debuggable};
-use phosphor_core::core::machine::{AudioSource, InputReceiver, Machine, MachineDebug, Renderable};
+use phosphor_core::core::machine::{
+    Accuracy, AudioSource, InputReceiver, Machine, MachineDebug, Renderable,
+};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_core::gfx;
 use phosphor_core::gfx::GfxCache;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::GfxLayout;
 use phosphor_macros::Saveable;
 
 use crate::namco_galaga::{self, GALAGA_SPRITE_LAYOUT, NamcoGalagaBoard};
@@ -416,6 +418,10 @@ impl GalagaSystem {
         }
     }
 
+    pub fn load_rom_set(&mut self, rom_set: &RomSet) -> Result<(), RomLoadError> {
+        self.load_roms(rom_set, &GALAGA_CONFIG)
+    }
+
     fn load_roms(
         &mut self,
         rom_set: &RomSet,
@@ -428,10 +434,14 @@ impl GalagaSystem {
 
         // GFX ROMs
         let gfx1 = config.gfx1_rom.load(rom_set)?;
-        self.char_cache = decode_gfx(&gfx1, 0, gfx1.len() / 16, &GALAGA_CHAR_LAYOUT);
+        self.char_cache = rom_set
+            .gfx()
+            .decode(&gfx1, 0, gfx1.len() / 16, &GALAGA_CHAR_LAYOUT);
 
         let gfx2 = config.gfx2_rom.load(rom_set)?;
-        self.sprite_cache = decode_gfx(&gfx2, 0, gfx2.len() / 64, &GALAGA_SPRITE_LAYOUT);
+        self.sprite_cache = rom_set
+            .gfx()
+            .decode(&gfx2, 0, gfx2.len() / 64, &GALAGA_SPRITE_LAYOUT);
 
         // PROMs: 0x00-0x1F palette, 0x20-0x11F char LUT, 0x120-0x21F sprite LUT
         let proms = config.proms.load(rom_set)?;
@@ -810,6 +820,10 @@ impl Bus for GalagaSystem {
     }
 
     fn write(&mut self, _master: BusMaster, addr: u16, data: u8) {
+        // All RAM is shared by the three CPUs: let the others catch up.
+        if let 0x8000..=0x9BFF = addr {
+            self.board.request_yield();
+        }
         match addr {
             0x0000..=0x3FFF => {} // ROM (nopw)
             0x6800..=0x681F => {
@@ -977,14 +991,17 @@ impl Machine for GalagaSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..namco_galaga::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board
+                .run_cycles(bus, namco_galaga::TIMING.cycles_per_frame());
         });
         self.update_starfield_at_vblank();
         self.render_video();
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset_board();
         self.video_ram.fill(0);
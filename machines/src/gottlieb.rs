@@ -26,7 +26,7 @@ use phosphor_core::cpu::i8088::I8088;
 use phosphor_core::cpu::m6502::M6502;
 use phosphor_core::device::{Device, Mc1408Dac, Riot6532, VotraxSc01};
 use phosphor_core::gfx;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx, decode_gfx_element};
+use phosphor_core::gfx::decode::{GfxDecodes, GfxLayout, decode_gfx_element};
 
 use phosphor_macros::{BusDebug, MemoryRegion, Saveable};
 
@@ -133,6 +133,10 @@ pub(crate) struct GottliebSoundBoard {
     votrax_ar_prev: bool,
     /// NMI pending from Votrax A/R rising edge.
     votrax_nmi: bool,
+    /// Sound CPU IRQ line from the RIOT, refreshed by `sync_irq_line` when
+    /// the RIOT reports a change. Not saved: the RIOT reports on load.
+    #[save_skip(default)]
+    irq_line: InterruptState,
 }
 
 impl GottliebSoundBoard {
@@ -147,6 +151,7 @@ impl GottliebSoundBoard {
             clock: 0,
             votrax_ar_prev: true,
             votrax_nmi: false,
+            irq_line: InterruptState::default(),
         }
     }
 
@@ -186,6 +191,7 @@ impl GottliebSoundBoard {
         self.votrax_ar_prev = ar;
 
         // Execute one M6502 cycle
+        self.sync_irq_line();
         bus_split!(self, bus => {
             self.cpu.execute_cycle(bus, BusMaster::Cpu(1));
         });
@@ -200,6 +206,15 @@ impl GottliebSoundBoard {
         self.clock += 1;
     }
 
+    /// Refresh the cached IRQ line if the RIOT output changed since the
+    /// last cycle: a register access, a PA7 edge from a sound command, or
+    /// a timer underflow.
+    fn sync_irq_line(&mut self) {
+        if self.riot.take_irq_changed() {
+            self.irq_line.irq = self.riot.irq_active();
+        }
+    }
+
     /// Advance the Votrax SC-01 by one Votrax clock tick (720 kHz).
     fn tick_votrax(&mut self) {
         self.votrax.tick();
@@ -303,9 +318,8 @@ impl Bus for GottliebSoundBoard {
         let nmi = self.votrax_nmi;
         self.votrax_nmi = false;
         InterruptState {
-            irq: self.riot.irq_active(),
             nmi,
-            ..Default::default()
+            ..self.irq_line
         }
     }
 }
@@ -500,16 +514,16 @@ impl GottliebBoard {
     }
 
     /// Pre-decode tile and sprite ROMs into GFX caches.
-    pub fn decode_gfx(&mut self, tile_rom: &[u8], sprite_rom: &[u8]) {
+    pub fn decode_gfx(&mut self, decodes: &GfxDecodes, tile_rom: &[u8], sprite_rom: &[u8]) {
         let tile_count = tile_rom.len() / 32;
-        self.tile_rom_cache = decode_gfx(tile_rom, 0, tile_count, &GOTTLIEB_TILE_LAYOUT);
+        self.tile_rom_cache = decodes.decode(tile_rom, 0, tile_count, &GOTTLIEB_TILE_LAYOUT);
 
         // Sprites: 4bpp planar, 16x16, 4 equal ROM regions
         let sprite_count = sprite_rom.len() / 128;
         let quarter = sprite_rom.len() / 4;
         let planes: [usize; 4] = std::array::from_fn(|p| p * quarter * 8);
         let y_offsets: [usize; 16] = std::array::from_fn(|py| py * 16);
-        self.sprite_cache = decode_gfx(
+        self.sprite_cache = decodes.decode(
             sprite_rom,
             0,
             sprite_count,
@@ -867,6 +881,37 @@ mod tests {
         assert_eq!(pb & 0x80, 0, "PB7 should be low when A/R is busy");
     }
 
+    #[test]
+    fn irq_line_follows_riot() {
+        let mut snd = GottliebSoundBoard::new();
+        let irq = |snd: &mut GottliebSoundBoard| Bus::check_interrupts(snd, BusMaster::Cpu(1)).irq;
+
+        // PA7 positive edge detection with IRQ enabled (edge control, A1=A0=1)
+        Bus::write(&mut snd, BusMaster::Cpu(1), 0x0207, 0);
+        snd.write_sound_command(0x0F); // PA7 low
+        snd.tick();
+        assert!(!irq(&mut snd));
+
+        // A command with PA7 high raises IRQ for the next cycle
+        snd.write_sound_command(0x00);
+        snd.tick();
+        assert!(irq(&mut snd));
+
+        // The cached line is rebuilt after a state load
+        let mut w = StateWriter::new();
+        snd.save_state(&mut w);
+        let data = w.into_vec();
+        let mut loaded = GottliebSoundBoard::new();
+        loaded.load_state(&mut StateReader::new(&data)).unwrap();
+        loaded.tick();
+        assert!(irq(&mut loaded));
+
+        // Reading the IRQ flags clears the edge flag and drops IRQ
+        Bus::read(&mut snd, BusMaster::Cpu(1), 0x0205);
+        snd.tick();
+        assert!(!irq(&mut snd));
+    }
+
     #[test]
     fn votrax_clock_divider_ratio() {
         // Verify 18/125 gives ~720 kHz from 5 MHz
@@ -5,11 +5,11 @@ use phosphor_core::core::machine::{
 };
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{self, SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, ClockDivider, TimingConfig};
+use phosphor_core::core::{BeamPosition, Bus, BusMaster, ClockDivider, TimingConfig};
 use phosphor_core::cpu::m6809::M6809;
 use phosphor_core::cpu::state::M6809State;
 use phosphor_core::cpu::{Cpu, CpuStateTrait};
-use phosphor_core::gfx::decode::{GfxCache, GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::{GfxCache, GfxLayout};
 use phosphor_macros::{BusDebug, MemoryRegion};
 
 use crate::registry::MachineEntry;
@@ -304,6 +304,8 @@ pub struct GridleeSystem {
 
     // Timing
     clock: u64,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
     cpu_cycles: u64,
     watchdog_frame_count: u8,
 
@@ -342,6 +344,7 @@ impl GridleeSystem {
             irq_pending: false,
             firq_pending: false,
             clock: 0,
+            beam: BeamPosition::new(),
             cpu_cycles: 0,
             watchdog_frame_count: 0,
             scanline_buffer: vec![
@@ -364,12 +367,10 @@ impl GridleeSystem {
 
     /// Current scanline (0-263).
     fn current_scanline(&self) -> u64 {
-        (self.clock % TIMING.cycles_per_frame()) / TIMING.cycles_per_scanline
+        self.beam.scanline()
     }
 
     pub fn tick(&mut self) {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-
         // Trackball movement simulation: increment raw position while keys held.
         // 8 counts/frame. 21120 cycles/frame ÷ 8 ≈ 2640 cycles/count.
         if self.clock.is_multiple_of(2640) {
@@ -389,8 +390,8 @@ impl GridleeSystem {
         }
 
         // Per-scanline processing at scanline boundaries
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = frame_cycle / TIMING.cycles_per_scanline;
+        if self.beam.at_line_start() {
+            let scanline = self.beam.scanline();
 
             // Latch palette bank for this scanline
             self.palette_bank_per_scanline[scanline as usize] = self.palette_bank;
@@ -414,8 +415,7 @@ impl GridleeSystem {
 
         // Clear IRQ/FIRQ at HBLANK start (pixel 256 = CPU cycle 64 within scanline).
         // This gives the CPU 64 cycles to respond.
-        let cycle_in_scanline = frame_cycle % TIMING.cycles_per_scanline;
-        if cycle_in_scanline == HBSTART_CYCLE {
+        if self.beam.cycle_in_line() == HBSTART_CYCLE {
             self.irq_pending = false;
             self.firq_pending = false;
         }
@@ -444,6 +444,7 @@ impl GridleeSystem {
         self.cpu_cycles += 1;
 
         self.clock += 1;
+        self.beam.step(&TIMING);
     }
 
     /// Read trackball axis (0=Y, 1=X). Implements the analog_port_r logic:
@@ -703,7 +704,9 @@ impl GridleeSystem {
 
         let gfx_data = GRIDLEE_GFX_ROM.load(rom_set)?;
         self.gfx_rom.copy_from_slice(&gfx_data);
-        self.sprite_cache = decode_gfx(&self.gfx_rom, 0, 256, &GRIDLEE_SPRITE_LAYOUT);
+        self.sprite_cache = rom_set
+            .gfx()
+            .decode(&self.gfx_rom, 0, 256, &GRIDLEE_SPRITE_LAYOUT);
 
         let prom_data = GRIDLEE_COLOR_PROMS.load(rom_set)?;
         self.build_palette(&prom_data);
@@ -720,7 +723,8 @@ impl GridleeSystem {
     /// Rebuild sprite cache from gfx_rom (for tests that modify ROM data directly).
     #[cfg(test)]
     fn decode_sprite_cache(&mut self) {
-        self.sprite_cache = decode_gfx(&self.gfx_rom, 0, 256, &GRIDLEE_SPRITE_LAYOUT);
+        self.sprite_cache =
+            phosphor_core::gfx::decode::decode_gfx(&self.gfx_rom, 0, 256, &GRIDLEE_SPRITE_LAYOUT);
     }
 }
 
@@ -953,6 +957,7 @@ impl Saveable for GridleeSystem {
         self.irq_pending = r.read_bool()?;
         self.firq_pending = r.read_bool()?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
         self.cpu_cycles = r.read_u64_le()?;
         self.watchdog_frame_count = r.read_u8()?;
         Ok(())
@@ -975,6 +980,7 @@ impl Machine for GridleeSystem {
         self.firq_pending = false;
         self.watchdog_frame_count = 0;
         self.clock = 0;
+        self.beam = BeamPosition::new();
         self.cpu_cycles = 0;
         self.tone_step = 0;
         self.tone_fraction = 0;
@@ -1002,6 +1008,10 @@ impl Machine for GridleeSystem {
         TIMING.frame_rate_hz()
     }
 
+    fn cpu_clock_hz(&self) -> Option<u64> {
+        Some(TIMING.cpu_clock_hz)
+    }
+
     fn machine_id(&self) -> &str {
         "gridlee"
     }
@@ -1010,6 +1020,11 @@ impl Machine for GridleeSystem {
         Some(save_state::save_machine(self, self.machine_id()))
     }
 
+    fn save_state_into(&self, buf: &mut Vec<u8>) -> bool {
+        save_state::save_machine_into(self, self.machine_id(), buf);
+        true
+    }
+
     fn load_state(&mut self, data: &[u8]) -> Result<(), SaveError> {
         let id = self.machine_id().to_string();
         save_state::load_machine(self, &id, data)
@@ -1044,6 +1059,12 @@ mod tests {
         sys
     }
 
+    /// Move the master clock (and the beam that follows it) to `clock`.
+    fn set_clock(sys: &mut GridleeSystem, clock: u64) {
+        sys.clock = clock;
+        sys.beam = BeamPosition::at_clock(&TIMING, clock);
+    }
+
     // -----------------------------------------------------------------------
     // Palette
     // -----------------------------------------------------------------------
@@ -1150,7 +1171,7 @@ mod tests {
     fn vblank_active_during_blanking() {
         let mut sys = make_system();
         // Scanline 0 (< VBEND=16): in VBLANK
-        sys.clock = 0;
+        set_clock(&mut sys, 0);
         let status = Bus::read(&mut sys, BusMaster::Cpu(0), 0x9700);
         assert_ne!(status & 0x80, 0, "VBLANK should be active at scanline 0");
     }
@@ -1159,7 +1180,7 @@ mod tests {
     fn vblank_inactive_during_active_display() {
         let mut sys = make_system();
         // Scanline 128 (within VBEND..VBSTART): active display
-        sys.clock = 128 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 128 * TIMING.cycles_per_scanline);
         let status = Bus::read(&mut sys, BusMaster::Cpu(0), 0x9700);
         assert_eq!(
             status & 0x80,
@@ -1172,7 +1193,7 @@ mod tests {
     fn vblank_active_after_vbstart() {
         let mut sys = make_system();
         // Scanline 256 (>= VBSTART): in VBLANK
-        sys.clock = 256 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 256 * TIMING.cycles_per_scanline);
         let status = Bus::read(&mut sys, BusMaster::Cpu(0), 0x9700);
         assert_ne!(status & 0x80, 0, "VBLANK should be active at scanline 256");
     }
@@ -1185,7 +1206,7 @@ mod tests {
     fn irq_not_asserted_at_scanline_0() {
         let mut sys = make_system();
         // Steady-state pattern is {64, 128, 192, 256}.
-        sys.clock = TIMING.cycles_per_frame(); // Start of next frame = scanline 0
+        set_clock(&mut sys, TIMING.cycles_per_frame()); // Start of next frame = scanline 0
         sys.tick();
         assert!(!sys.irq_pending, "IRQ should NOT fire at scanline 0");
     }
@@ -1193,7 +1214,7 @@ mod tests {
     #[test]
     fn irq_asserted_at_scanline_64() {
         let mut sys = make_system();
-        sys.clock = 64 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 64 * TIMING.cycles_per_scanline);
         sys.tick();
         assert!(sys.irq_pending, "IRQ should be pending at scanline 64");
     }
@@ -1202,7 +1223,7 @@ mod tests {
     fn irq_asserted_at_scanline_256() {
         let mut sys = make_system();
         // Scanline 256 is the VBLANK IRQ
-        sys.clock = 256 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 256 * TIMING.cycles_per_scanline);
         sys.tick();
         assert!(sys.irq_pending, "IRQ should fire at scanline 256");
     }
@@ -1210,7 +1231,7 @@ mod tests {
     #[test]
     fn firq_asserted_at_scanline_92() {
         let mut sys = make_system();
-        sys.clock = 92 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 92 * TIMING.cycles_per_scanline);
         sys.tick();
         assert!(sys.firq_pending, "FIRQ should be pending at scanline 92");
     }
@@ -1219,11 +1240,11 @@ mod tests {
     fn irq_cleared_at_hblank() {
         let mut sys = make_system();
         // Assert IRQ at scanline 64
-        sys.clock = 64 * TIMING.cycles_per_scanline;
+        set_clock(&mut sys, 64 * TIMING.cycles_per_scanline);
         sys.tick();
         assert!(sys.irq_pending);
         // Cleared at HBSTART (CPU cycle 64 within scanline)
-        sys.clock = 64 * TIMING.cycles_per_scanline + HBSTART_CYCLE;
+        set_clock(&mut sys, 64 * TIMING.cycles_per_scanline + HBSTART_CYCLE);
         sys.tick();
         assert!(!sys.irq_pending, "IRQ should be cleared at HBLANK");
     }
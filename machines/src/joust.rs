@@ -276,6 +276,10 @@ impl Bus for JoustSystem {
     fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
         self.board.bus_check_interrupts(target)
     }
+
+    fn is_pure_read(&self, master: BusMaster, addr: u16) -> bool {
+        self.board.bus_is_pure_read(master, addr)
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -331,12 +335,19 @@ impl Machine for JoustSystem {
         self.board
             .rom_pia
             .set_port_a_input(self.board.rom_pia_input);
+        self.board.begin_frame();
         bus_split!(self, bus => {
-            for _ in 0..williams::TIMING.cycles_per_frame() {
+            let mut remaining = williams::TIMING.cycles_per_frame();
+            while remaining > 0 {
                 self.update_widget_mux();
-                self.board.tick(bus);
+                remaining -= self.board.step(bus, remaining);
             }
         });
+        self.board.end_frame();
+    }
+
+    fn set_threaded(&mut self, enabled: bool) {
+        self.board.set_sound_thread(enabled);
     }
 
     fn reset(&mut self) {
@@ -346,7 +357,6 @@ impl Machine for JoustSystem {
         self.start_bits = 0;
         bus_split!(self, bus => {
             self.board.cpu.reset(bus, BusMaster::Cpu(0));
-            self.board.sound_cpu.reset(bus, BusMaster::Cpu(1));
         });
     }
 }
@@ -389,7 +399,11 @@ mod tests {
         sys.board.rom_bank = 3;
         sys.board.clock = 50_000;
         sys.board.watchdog_counter = 42;
-        sys.board.sound_map.region_data_mut(SoundRegion::Ram)[0x20] = 0xEF;
+        sys.board
+            .sound_mut()
+            .bus
+            .map
+            .region_data_mut(SoundRegion::Ram)[0x20] = 0xEF;
 
         // Set Joust-specific input state
         sys.p1_controls = 0x05;
@@ -401,7 +415,7 @@ mod tests {
 
         // Capture CPU snapshots for comparison
         let cpu_snap = sys.board.cpu.snapshot();
-        let sound_snap = sys.board.sound_cpu.snapshot();
+        let sound_snap = sys.board.get_sound_cpu_state();
 
         // Mutate everything
         let mut sys2 = JoustSystem::new();
@@ -416,7 +430,7 @@ mod tests {
 
         // Verify CPU state
         assert_eq!(sys2.board.cpu.snapshot(), cpu_snap);
-        assert_eq!(sys2.board.sound_cpu.snapshot(), sound_snap);
+        assert_eq!(sys2.board.get_sound_cpu_state(), sound_snap);
 
         // Verify board state
         assert_eq!(sys2.board.read_video_ram(0x100), 0xAA);
@@ -428,7 +442,7 @@ mod tests {
         assert_eq!(sys2.board.clock, 50_000);
         assert_eq!(sys2.board.watchdog_counter, 42);
         assert_eq!(
-            sys2.board.sound_map.region_data(SoundRegion::Ram)[0x20],
+            sys2.board.sound().bus.map.region_data(SoundRegion::Ram)[0x20],
             0xEF
         );
 
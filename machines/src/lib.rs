@@ -270,7 +270,8 @@ pub(crate) use impl_board_debug;
 
 /// Generates boilerplate `Machine` trait methods inside an `impl Machine` block.
 ///
-/// Expands to: `frame_rate_hz()`, `machine_id()`, `save_state()`, `load_state()`.
+/// Expands to: `frame_rate_hz()`, `machine_id()`, `save_state()`,
+/// `save_state_into()`, `load_state()`.
 ///
 /// # Usage
 /// ```ignore
@@ -285,6 +286,9 @@ macro_rules! machine_save_state {
         fn frame_rate_hz(&self) -> f64 {
             $timing.frame_rate_hz()
         }
+        fn cpu_clock_hz(&self) -> Option<u64> {
+            Some($timing.cpu_clock_hz)
+        }
         fn machine_id(&self) -> &str {
             $id
         }
@@ -294,6 +298,10 @@ macro_rules! machine_save_state {
                 self.machine_id(),
             ))
         }
+        fn save_state_into(&self, buf: &mut Vec<u8>) -> bool {
+            phosphor_core::core::save_state::save_machine_into(self, self.machine_id(), buf);
+            true
+        }
         fn load_state(
             &mut self,
             data: &[u8],
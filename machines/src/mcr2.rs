@@ -1,11 +1,11 @@
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{ClockDivider, TimingConfig};
+use phosphor_core::core::{BeamPosition, ClockDivider, InterruptState, TimingConfig};
 use phosphor_core::cpu::z80::Z80;
 use phosphor_core::device::Z80Ctc;
 use phosphor_core::dirty_bitset::DirtyBitset;
 use phosphor_core::gfx;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::{GfxDecodes, GfxLayout};
 use phosphor_macros::{BusDebug, MemoryRegion};
 
 use phosphor_core::device::SsioBoard;
@@ -115,9 +115,16 @@ pub struct Mcr2Board {
     // CTC interrupt handling
     pub(crate) ctc_ack_needed: bool,
     pub(crate) ctc_vector_latch: u8,
+    // Main CPU interrupt line (IRQ + vector) from the CTC, refreshed by
+    // `sync_irq_line` when the CTC reports a change, so the game wrapper's
+    // per-fetch `check_interrupts` reads it without querying the CTC.
+    // Not saved: recomputed on load.
+    pub(crate) irq_line: InterruptState,
 
     // Timing
     pub(crate) clock: u64,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
     pub(crate) ssio_clock: ClockDivider,
     pub(crate) watchdog_counter: u16,
 }
@@ -140,7 +147,9 @@ impl Mcr2Board {
             tiles_redrawn: 0,
             ctc_ack_needed: false,
             ctc_vector_latch: 0,
+            irq_line: InterruptState::default(),
             clock: 0,
+            beam: BeamPosition::new(),
             ssio_clock: ClockDivider::new(SSIO_CLOCK_NUM, SSIO_CLOCK_DEN),
             watchdog_counter: 0,
         }
@@ -195,12 +204,12 @@ impl Mcr2Board {
 
     /// Pre-decode tile and sprite ROMs into GFX caches.
     /// `bg_rom` is the background tile ROM, `fg_rom` is the sprite ROM.
-    pub fn decode_gfx(&mut self, bg_rom: &[u8], fg_rom: &[u8]) {
+    pub fn decode_gfx(&mut self, decodes: &GfxDecodes, bg_rom: &[u8], fg_rom: &[u8]) {
         // Tiles: 4bpp, 8x8, ROM split in two halves
         let tile_count = bg_rom.len() / 32;
         let half_bits = (bg_rom.len() / 2) * 8;
         let tile_planes: [usize; 4] = [1, 0, half_bits + 1, half_bits];
-        self.tile_cache = decode_gfx(
+        self.tile_cache = decodes.decode(
             bg_rom,
             0,
             tile_count,
@@ -218,7 +227,7 @@ impl Mcr2Board {
         let x_offsets: [usize; 32] =
             std::array::from_fn(|px| ((px / 2) % 4) * q8 + (px / 8) * 8 + (px % 2) * 4);
         let y_offsets: [usize; 32] = std::array::from_fn(|py| py * 32);
-        self.sprite_cache = decode_gfx(
+        self.sprite_cache = decodes.decode(
             fg_rom,
             0,
             sprite_count,
@@ -285,11 +294,9 @@ impl Mcr2Board {
     /// The `bus` parameter is the game wrapper (which implements `Bus`) passed
     /// in from the wrapper's `run_frame()` / `debug_tick()`.
     pub fn tick(&mut self, bus: &mut dyn phosphor_core::core::Bus<Address = u16, Data = u8>) {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-
         // CTC triggers at scanline boundaries
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = frame_cycle / TIMING.cycles_per_scanline;
+        if self.beam.at_line_start() {
+            let scanline = self.beam.scanline();
 
             // CTC channel 2: triggered at scanlines 0 and 240 (VBLANK)
             if scanline == 0 || scanline == VISIBLE_LINES {
@@ -307,7 +314,10 @@ impl Mcr2Board {
         // Tick CTC (timer-mode channels count CPU clocks)
         self.ctc.tick();
 
-        // Execute main CPU cycle
+        // Execute main CPU cycle. The CTC may have changed since the last
+        // one (trigger, timer, register access, acknowledge), and the CPU
+        // polls interrupts at the start of this cycle.
+        self.sync_irq_line();
         self.cpu
             .execute_cycle(bus, phosphor_core::core::BusMaster::Cpu(0));
 
@@ -323,9 +333,21 @@ impl Mcr2Board {
         }
 
         self.clock += 1;
+        self.beam.step(&TIMING);
         self.watchdog_counter = self.watchdog_counter.wrapping_add(1);
     }
 
+    /// Refresh the cached interrupt line if the CTC reports a change.
+    pub(crate) fn sync_irq_line(&mut self) {
+        if self.ctc.take_irq_changed() {
+            self.irq_line = InterruptState {
+                irq: self.ctc.interrupt_pending(),
+                irq_vector: self.ctc.interrupt_vector(),
+                ..Default::default()
+            };
+        }
+    }
+
     // -----------------------------------------------------------------------
     // Frame rendering
     // -----------------------------------------------------------------------
@@ -488,10 +510,12 @@ impl Mcr2Board {
         self.tile_dirty = DirtyBitset::new_all_dirty();
         self.sprite_tile_dirty = DirtyBitset::new_all_dirty();
         self.clock = 0;
+        self.beam = BeamPosition::new();
         self.ssio_clock.reset();
         self.watchdog_counter = 0;
         self.ctc_ack_needed = false;
         self.ctc_vector_latch = 0;
+        self.sync_irq_line();
         // NVRAM is NOT cleared (battery-backed)
     }
 
@@ -531,6 +555,7 @@ impl Saveable for Mcr2Board {
         r.read_bytes_into(self.map.region_data_mut(Region::VideoRam))?;
         r.read_bytes_into(&mut self.palette_ram)?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
         self.ssio_clock.load_state(r)?;
         self.watchdog_counter = r.read_u16_le()?;
         // Rebuild derived state from loaded data
@@ -539,6 +564,7 @@ impl Saveable for Mcr2Board {
         self.sprite_tile_dirty = DirtyBitset::new_all_dirty();
         self.ctc_ack_needed = false;
         self.ctc_vector_latch = 0;
+        self.sync_irq_line();
         Ok(())
     }
 }
@@ -5,7 +5,7 @@ use phosphor_core::core::machine::{
 };
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{self, SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, TimingConfig};
+use phosphor_core::core::{BeamPosition, Bus, BusMaster, TimingConfig};
 use phosphor_core::cpu::m6502::M6502;
 use phosphor_core::cpu::state::M6502State;
 use phosphor_core::cpu::{Cpu, CpuStateTrait};
@@ -239,6 +239,8 @@ pub struct MissileCommandSystem {
 
     // System
     clock: u64,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
     cpu_cycles: u64,          // incremented only when CPU actually executes
     watchdog_frame_count: u8, // frames since last write to 0x4C00; resets machine at 8
 
@@ -271,6 +273,7 @@ impl MissileCommandSystem {
             madsel_lastcycles: 0,
             stall_cycles: 0,
             clock: 0,
+            beam: BeamPosition::new(),
             cpu_cycles: 0,
             watchdog_frame_count: 0,
             scanline_buffer: vec![0u8; 256 * 231 * 3],
@@ -296,8 +299,7 @@ impl MissileCommandSystem {
 
     /// Current scanline (V counter), 0-255.
     pub fn current_scanline(&self) -> u16 {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        (frame_cycle / TIMING.cycles_per_scanline) as u16
+        self.beam.scanline() as u16
     }
 
     pub fn tick(&mut self) {
@@ -338,9 +340,8 @@ impl MissileCommandSystem {
         // Per-scanline rendering: at each scanline boundary, render the current
         // scanline from VRAM + palette before the CPU processes it, matching
         // hardware CRT read timing (the beam scans using VRAM at line start).
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = (frame_cycle / TIMING.cycles_per_scanline) as u16;
+        if self.beam.at_line_start() {
+            let scanline = self.beam.scanline() as u16;
             if scanline >= 25 {
                 self.render_scanline_to_buffer(scanline as usize);
             }
@@ -387,6 +388,7 @@ impl MissileCommandSystem {
         }
 
         self.clock += 1;
+        self.beam.step(&TIMING);
     }
 
     pub fn load_rom_set(
@@ -857,6 +859,7 @@ impl Saveable for MissileCommandSystem {
         self.madsel_lastcycles = r.read_u64_le()?;
         self.stall_cycles = r.read_u8()?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
         self.cpu_cycles = r.read_u64_le()?;
         self.watchdog_frame_count = r.read_u8()?;
         self.scanline_buffer_valid = false;
@@ -872,19 +875,20 @@ impl Machine for MissileCommandSystem {
         }
         self.scanline_buffer_valid = true;
 
+        // Drain POKEY's resampled f32 buffer and convert to i16 PCM.
+        // POKEY outputs unipolar [0.0, 1.0]; center around zero for signed PCM.
+        // Done every frame, so no samples are left inside POKEY where a
+        // state load would drop them.
+        let samples = self.pokey.drain_audio();
+        self.audio_buffer
+            .extend(samples.iter().map(|&s| ((s * 2.0 - 1.0) * 32767.0) as i16));
+
         // Watchdog: 8-VBLANK timeout. If the game hasn't written
         // to 0x4C00 within 8 frames, reset the machine.
         self.watchdog_frame_count += 1;
         if self.watchdog_frame_count >= 8 {
             self.reset();
-            return;
         }
-
-        // Drain POKEY's resampled f32 buffer and convert to i16 PCM.
-        // POKEY outputs unipolar [0.0, 1.0]; center around zero for signed PCM.
-        let samples = self.pokey.drain_audio();
-        self.audio_buffer
-            .extend(samples.iter().map(|&s| ((s * 2.0 - 1.0) * 32767.0) as i16));
     }
 
     fn reset(&mut self) {
@@ -905,6 +909,10 @@ impl Machine for MissileCommandSystem {
         TIMING.frame_rate_hz()
     }
 
+    fn cpu_clock_hz(&self) -> Option<u64> {
+        Some(TIMING.cpu_clock_hz)
+    }
+
     fn machine_id(&self) -> &str {
         "missile_command"
     }
@@ -913,6 +921,11 @@ impl Machine for MissileCommandSystem {
         Some(save_state::save_machine(self, self.machine_id()))
     }
 
+    fn save_state_into(&self, buf: &mut Vec<u8>) -> bool {
+        save_state::save_machine_into(self, self.machine_id(), buf);
+        true
+    }
+
     fn load_state(&mut self, data: &[u8]) -> Result<(), SaveError> {
         let id = self.machine_id().to_string();
         save_state::load_machine(self, &id, data)
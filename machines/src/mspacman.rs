@@ -1,6 +1,6 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
-use phosphor_core::core::machine::{InputReceiver, Machine};
+use phosphor_core::core::machine::{Accuracy, InputReceiver, Machine};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_macros::Saveable;
@@ -151,7 +151,7 @@ impl MsPacmanSystem {
 
         // Ms. Pac-Man specific graphics (different from Pac-Man)
         let gfx_data = MSPACMAN_GFX_ROM.load(rom_set)?;
-        self.board.load_gfx_rom(&gfx_data);
+        self.board.load_gfx_rom(rom_set.gfx(), &gfx_data);
 
         // Color and sound PROMs are identical to Pac-Man
         let color_data = crate::pacman::PACMAN_COLOR_PROMS.load(rom_set)?;
@@ -367,6 +367,19 @@ impl Bus for MsPacmanSystem {
             irq_vector: self.board.interrupt_vector,
         }
     }
+
+    fn is_pure_read(&self, _master: BusMaster, addr: u16) -> bool {
+        // Reads in a trap range flip the decode latch
+        let aligned = addr & !0x07;
+        if aligned == DECODE_ENABLE_TRAP || DECODE_DISABLE_TRAPS.contains(&aligned) {
+            return false;
+        }
+        match (self.decode_enabled, addr) {
+            (true, 0x0000..=0x3FFF | 0x8000..=0x97FF)
+            | (false, 0x0000..=0x3FFF | 0x8000..=0xBFFF) => !self.board.map.has_any_watchpoints(),
+            _ => self.board.is_pure_read_common(addr & 0x7FFF),
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -390,12 +403,14 @@ impl Machine for MsPacmanSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..namco_pac::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board.run_cycles(bus, namco_pac::TIMING.cycles_per_frame());
         });
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset_board();
         self.decode_enabled = true; // Latch defaults to enabled (Ms. Pac-Man code)
@@ -418,7 +433,7 @@ fn create_machine(
 }
 
 inventory::submit! {
-    MachineEntry::new("mspacman", &["mspacman"], create_machine)
+    MachineEntry::new("mspacman", &["mspacman"], create_machine).with_accuracy(Accuracy::Scanline)
 }
 
 // ---------------------------------------------------------------------------
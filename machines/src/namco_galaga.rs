@@ -1,6 +1,6 @@
-use phosphor_core::core::machine::{InputButton, TimingConfig};
+use phosphor_core::core::machine::{Accuracy, InputButton, TimingConfig};
 use phosphor_core::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, ClockDivider};
+use phosphor_core::core::{BeamPosition, Bus, BusMaster, ClockDivider};
 use phosphor_core::cpu::z80::Z80;
 use phosphor_core::device::namco_wsg::NamcoWsg;
 use phosphor_core::device::namco06::Namco06;
@@ -239,9 +239,22 @@ pub struct NamcoGalagaBoard {
     pub(crate) clock: u64,
     pub(crate) watchdog_counter: u32,
     pub(crate) flip_screen: bool,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
 
     // Deferred sub CPU reset (set by write_misc_latch, acted on in tick)
     pending_sub_cpu_reset: bool,
+
+    // Scheduling: cycles each CPU runs before the others catch up (1 =
+    // lockstep), and the early-yield request raised by cross-CPU writes.
+    quantum: u32,
+    yield_requested: bool,
+
+    // On-demand 51XX (LLE) execution: cycles owed to the MCU and the
+    // chip-select level they run with. Always settled before a save.
+    mcu_on_demand: bool,
+    mcu_pending: u32,
+    mcu_cs: bool,
 }
 
 impl NamcoGalagaBoard {
@@ -292,8 +305,16 @@ impl NamcoGalagaBoard {
             clock: 0,
             watchdog_counter: 0,
             flip_screen: false,
+            beam: BeamPosition::new(),
 
             pending_sub_cpu_reset: false,
+
+            quantum: 1,
+            yield_requested: false,
+
+            mcu_on_demand: true,
+            mcu_pending: 0,
+            mcu_cs: false,
         }
     }
 
@@ -306,9 +327,146 @@ impl NamcoGalagaBoard {
         cpu.hardware_reset();
     }
 
+    /// Advance the board by one CPU cycle with all three Z80s in lockstep.
     pub fn tick(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
+        self.tick_lockstep(bus);
+        self.sync_mcu();
+    }
+
+    fn tick_lockstep(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
+        self.begin_cycle();
+        self.tick_timers();
+        self.wsg.tick();
+
+        // Execute all 3 CPUs BEFORE MCU so Z80 writes reach o_latch
+        // before the MCU reads K (K is a hardware wire, not latched).
+        self.main_cpu.execute_cycle(bus, BusMaster::Cpu(0));
+        if !self.sub_reset {
+            self.sub_cpu.execute_cycle(bus, BusMaster::Cpu(1));
+            self.sound_cpu.execute_cycle(bus, BusMaster::Cpu(2));
+        }
+
+        self.tick_mcu();
+        self.end_cycle();
+    }
+
+    /// Run `cycles` CPU cycles under the configured scheduling quantum.
+    ///
+    /// With a quantum of 1 this is exactly `cycles` calls to [`tick`](Self::tick).
+    /// Otherwise the frame is cut into slices of at most `quantum` cycles
+    /// that never cross a scanline boundary, so every raster interrupt is
+    /// raised at a slice start with all CPUs caught up. In each slice the
+    /// main CPU runs first, in step with the 06XX and 51XX it talks to,
+    /// and ends the slice early after a write the other CPUs can observe
+    /// (shared RAM, interrupt enables, sub/sound reset). The sub CPU then
+    /// runs the same number of cycles, followed by the sound CPU in step
+    /// with the WSG, so sound register writes land on the same WSG cycle
+    /// as in lockstep. Shared RAM is not kept in step: sub and sound CPU
+    /// writes reach the main CPU up to one slice late, and the sub and
+    /// sound CPUs see the main CPU's slice-ending write from the start of
+    /// the slice. Registered machines therefore default to lockstep.
+    pub fn run_cycles(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, cycles: u64) {
+        if self.quantum <= 1 {
+            for _ in 0..cycles {
+                self.tick_lockstep(bus);
+            }
+        } else {
+            let mut remaining = cycles;
+            while remaining > 0 {
+                let limit = remaining
+                    .min(self.quantum as u64)
+                    .min(self.beam.cycles_until_next_scanline(&TIMING));
+                remaining -= self.run_slice(bus, limit);
+            }
+        }
+        // Leave the 51XX current for save states and the debugger.
+        self.sync_mcu();
+    }
 
+    /// Scheduling quantum in CPU cycles (1 = lockstep).
+    pub fn quantum(&self) -> u32 {
+        self.quantum
+    }
+
+    /// Set the scheduling quantum used by [`run_cycles`](Self::run_cycles).
+    ///
+    /// 1 (the default) keeps the three Z80s cycle-interleaved. Larger
+    /// values trade inter-CPU timing precision for fewer context switches,
+    /// like MAME's scheduler quantum; runs stay deterministic for a given
+    /// quantum. Slices always end on scanline boundaries, so save states
+    /// taken between frames are unaffected.
+    pub fn set_quantum(&mut self, cycles: u32) {
+        self.quantum = cycles.max(1);
+    }
+
+    /// `Scanline` runs the CPUs in one-scanline slices (192 cycles, finer
+    /// than the 6 kHz quantum MAME uses for this board), approximating
+    /// shared-RAM timing as described in [`run_cycles`](Self::run_cycles);
+    /// `Cycle` restores lockstep.
+    pub fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.set_quantum(match accuracy {
+            Accuracy::Cycle => 1,
+            Accuracy::Scanline => TIMING.cycles_per_scanline as u32,
+        });
+    }
+
+    /// End the current quantum slice after this cycle. Game wrappers call
+    /// this on writes to RAM the other CPUs can read.
+    #[inline]
+    pub fn request_yield(&mut self) {
+        self.yield_requested = true;
+    }
+
+    /// Run the main CPU for up to `limit` cycles, then bring the sub and
+    /// sound CPUs up to the same point. Returns the cycles run.
+    fn run_slice(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, limit: u64) -> u64 {
+        // Slices start on every scanline boundary and after every latch
+        // write, so raster events and deferred resets land here.
+        self.begin_cycle();
+        let sub_was_running = !self.sub_reset;
+        self.yield_requested = false;
+
+        let mut n = 0;
+        while n < limit {
+            self.tick_timers();
+            self.main_cpu.execute_cycle(bus, BusMaster::Cpu(0));
+            self.tick_mcu();
+            self.end_cycle();
+            n += 1;
+            if self.yield_requested {
+                break;
+            }
+        }
+
+        // Only the main CPU's last cycle can have changed the reset latch
+        // (the write ends the slice), so the cycles before it see the latch
+        // as it was when the slice began.
+        for i in 0..n {
+            let running = if i + 1 < n {
+                sub_was_running
+            } else {
+                !self.sub_reset
+            };
+            if running {
+                self.sub_cpu.execute_cycle(bus, BusMaster::Cpu(1));
+            }
+        }
+        for i in 0..n {
+            let running = if i + 1 < n {
+                sub_was_running
+            } else {
+                !self.sub_reset
+            };
+            self.wsg.tick();
+            if running {
+                self.sound_cpu.execute_cycle(bus, BusMaster::Cpu(2));
+            }
+        }
+        n
+    }
+
+    /// Deferred resets and raster events due at the start of a cycle.
+    fn begin_cycle(&mut self) {
         // Handle deferred sub CPU reset (set by write_misc_latch bit 3).
         // Mirrors Z80::reset() without needing 'static bus lifetime.
         if self.pending_sub_cpu_reset {
@@ -317,44 +475,56 @@ impl NamcoGalagaBoard {
             Self::reset_z80(&mut self.sound_cpu);
         }
 
-        // VBLANK interrupt: fire at the start of VBLANK (scanline 224).
-        // Only assert IRQ if the mask (enable latch) is set, matching MAME's
-        // vblank_irq: `if (state && m_main_irq_mask) set_input_line(ASSERT_LINE)`.
-        // This prevents a race where VBLANK fires while the IRQ handler has
-        // temporarily cleared the mask, which would cause spurious re-entry.
-        let vblank_cycle = VISIBLE_LINES * TIMING.cycles_per_scanline;
-        if frame_cycle == vblank_cycle {
-            if self.main_irq_enabled {
-                self.main_irq_pending = true;
-            }
-            if self.sub_irq_enabled {
-                self.sub_irq_pending = true;
-            }
-            // Drive VBLANK to 51XX TC pin (active on falling edge).
-            // Matches MAME: vblank(state) → set_input_line(TC_LINE, !state)
-            if let Namco51Wrapper::Lle(ref mut lle) = self.namco51 {
-                lle.mcu.set_tc(false); // Assert (active low)
-            }
-        }
-        // Clear TC at end of VBLANK (start of visible area = frame_cycle 0)
-        if frame_cycle == 0
-            && let Namco51Wrapper::Lle(ref mut lle) = self.namco51
-        {
-            lle.mcu.set_tc(true); // Deassert
+        if self.beam.at_line_start() {
+            self.scanline_events(self.beam.scanline());
         }
+    }
 
+    /// Interrupts and 51XX TC edges raised at the start of `scanline`.
+    fn scanline_events(&mut self, scanline: u64) {
         // Sound CPU NMI: fires at scanlines 64 and 192 (every 128 lines),
         // matching MAME's cpu3_interrupt_callback. Gated by misc latch Q2.
         const SOUND_NMI_SCANLINE_A: u64 = 64;
         const SOUND_NMI_SCANLINE_B: u64 = 192;
-        let scanline_a_cycle = SOUND_NMI_SCANLINE_A * TIMING.cycles_per_scanline;
-        let scanline_b_cycle = SOUND_NMI_SCANLINE_B * TIMING.cycles_per_scanline;
-        if (frame_cycle == scanline_a_cycle || frame_cycle == scanline_b_cycle)
-            && self.sound_nmi_enabled
-        {
-            self.sound_nmi_pending = true;
+
+        match scanline {
+            // Clear TC at end of VBLANK (start of visible area)
+            0 => {
+                self.sync_mcu();
+                if let Namco51Wrapper::Lle(ref mut lle) = self.namco51 {
+                    lle.mcu.set_tc(true); // Deassert
+                }
+            }
+            // VBLANK interrupt: fire at the start of VBLANK (scanline 224).
+            // Only assert IRQ if the mask (enable latch) is set, matching MAME's
+            // vblank_irq: `if (state && m_main_irq_mask) set_input_line(ASSERT_LINE)`.
+            // This prevents a race where VBLANK fires while the IRQ handler has
+            // temporarily cleared the mask, which would cause spurious re-entry.
+            VISIBLE_LINES => {
+                if self.main_irq_enabled {
+                    self.main_irq_pending = true;
+                }
+                if self.sub_irq_enabled {
+                    self.sub_irq_pending = true;
+                }
+                // Drive VBLANK to 51XX TC pin (active on falling edge).
+                // Matches MAME: vblank(state) → set_input_line(TC_LINE, !state)
+                self.sync_mcu();
+                if let Namco51Wrapper::Lle(ref mut lle) = self.namco51 {
+                    lle.mcu.set_tc(false); // Assert (active low)
+                }
+            }
+            SOUND_NMI_SCANLINE_A | SOUND_NMI_SCANLINE_B => {
+                if self.sound_nmi_enabled {
+                    self.sound_nmi_pending = true;
+                }
+            }
+            _ => {}
         }
+    }
 
+    /// Per-cycle 06XX timer work.
+    fn tick_timers(&mut self) {
         // 06XX timer tick — NMI output is a level signal to the main CPU.
         //
         // Always propagate the NMI level regardless of Z80 HALT state.
@@ -365,38 +535,68 @@ impl NamcoGalagaBoard {
         // suspended in Dig Dug / Galaga.
         self.namco06.tick();
         self.main_nmi_pending = self.namco06.nmi_output();
+    }
 
-        // WSG tick (runs at CPU clock rate)
-        self.wsg.tick();
-
-        // Execute all 3 CPUs BEFORE MCU so Z80 writes reach o_latch
-        // before the MCU reads K (K is a hardware wire, not latched).
-        self.main_cpu.execute_cycle(bus, BusMaster::Cpu(0));
-        if !self.sub_reset {
-            self.sub_cpu.execute_cycle(bus, BusMaster::Cpu(1));
-            self.sound_cpu.execute_cycle(bus, BusMaster::Cpu(2));
+    /// Account one CPU cycle of 51XX (LLE) time.
+    ///
+    /// The MCU is not stepped here: owed cycles accumulate in `mcu_pending`
+    /// and [`sync_mcu`](Self::sync_mcu) runs them in a batch when something
+    /// it can see or drive is about to change — a 06XX chip-select edge or
+    /// control write, a Z80 access to its data port, a cabinet input, a TC
+    /// edge, or a reset. Between those points the MCU's inputs are constant,
+    /// so the batch is cycle-exact with stepping it every cycle.
+    fn tick_mcu(&mut self) {
+        if !matches!(self.namco51, Namco51Wrapper::Lle(_)) {
+            return;
+        }
+        // Chip select is sampled after the Z80s ran this cycle, matching
+        // MAME's nmi_generate which pulses chip_select for selected chips on
+        // each timer toggle: `m_chipsel[N](0, BIT(ctrl, N) && timer_state)`.
+        let cs = self.namco06.chip_select_active(0);
+        if cs != self.mcu_cs {
+            self.sync_mcu();
+            self.mcu_cs = cs;
         }
+        self.mcu_pending += 1;
+        if !self.mcu_on_demand {
+            self.sync_mcu();
+        }
+    }
 
-        // Drive chip_select IRQ to LLE 51XX and tick MCU.
-        // Executed AFTER Z80 so K reflects latest data writes.
-        // Matches MAME's nmi_generate which pulses chip_select for selected
-        // chips on each timer toggle: `m_chipsel[N](0, BIT(ctrl, N) && timer_state)`.
-        if let Namco51Wrapper::Lle(ref mut lle) = self.namco51 {
-            let cs = self.namco06.chip_select_active(0);
-            lle.mcu.set_irq(cs);
-            // K port: in dynamic_k mode, INK computes K at execution time as
-            // (rw_input << 3) | (o_latch & 0x07), matching MAME's K_r() callback.
-            // We only need to keep rw_input current; o_latch updates instantly
-            // when the Z80 writes via write_custom_io → namco51.write().
-            lle.mcu.rw_input = if self.namco06.is_read_mode() { 1 } else { 0 };
+    /// Run the 51XX MCU through all cycles owed to it.
+    pub fn sync_mcu(&mut self) {
+        let pending = std::mem::take(&mut self.mcu_pending);
+        let Namco51Wrapper::Lle(ref mut lle) = self.namco51 else {
+            return;
+        };
+        // K port: in dynamic_k mode, INK computes K at execution time as
+        // (rw_input << 3) | (o_latch & 0x07), matching MAME's K_r() callback.
+        // We only need to keep rw_input current; o_latch updates instantly
+        // when the Z80 writes via write_custom_io → namco51.write().
+        let rw_input = if self.namco06.is_read_mode() { 1 } else { 0 };
+        for _ in 0..pending {
+            // Re-driven every cycle like the wire it models: a 51XX reset
+            // drops the MCU's pin state, and the next cycle sees the edge.
+            lle.mcu.set_irq(self.mcu_cs);
+            lle.mcu.rw_input = rw_input;
             if self.namco51_divider.tick() {
                 lle.update_inputs(self.in0, self.in1);
                 lle.tick();
             }
         }
+    }
 
+    /// Select on-demand (default) or per-cycle 51XX stepping. Both give
+    /// identical results; per-cycle stepping is kept for verification.
+    pub fn set_mcu_on_demand(&mut self, on_demand: bool) {
+        self.sync_mcu();
+        self.mcu_on_demand = on_demand;
+    }
+
+    fn end_cycle(&mut self) {
         self.clock += 1;
         self.watchdog_counter += 1;
+        self.beam.step(&TIMING);
     }
 
     // -----------------------------------------------------------------------
@@ -431,7 +631,10 @@ impl NamcoGalagaBoard {
             0xFF
         };
         match chip {
-            0 => self.namco51.read(self.in0, self.in1),
+            0 => {
+                self.sync_mcu();
+                self.namco51.read(self.in0, self.in1)
+            }
             1 => self.namco53.read(self.dswa, self.dswb),
             _ => 0xFF,
         }
@@ -446,6 +649,7 @@ impl NamcoGalagaBoard {
             return;
         }
         if self.namco06.chip_select(0) {
+            self.sync_mcu();
             self.namco51.write(data);
         }
         // 53XX has no write interface
@@ -457,6 +661,7 @@ impl NamcoGalagaBoard {
     /// across transactions. The 53XX cycles through 2 reads (DSWA, DSWB).
     /// Do NOT reset read indices here.
     pub fn write_custom_io_ctrl(&mut self, data: u8) {
+        self.sync_mcu();
         self.namco06.ctrl_write(data, self.clock);
     }
 
@@ -465,18 +670,21 @@ impl NamcoGalagaBoard {
     pub fn write_misc_latch(&mut self, bit: u8, value: bool) {
         match bit {
             0 => {
+                self.yield_requested = true;
                 self.main_irq_enabled = value;
                 if !value {
                     self.main_irq_pending = false;
                 }
             }
             1 => {
+                self.yield_requested = true;
                 self.sub_irq_enabled = value;
                 if !value {
                     self.sub_irq_pending = false;
                 }
             }
             2 => {
+                self.yield_requested = true;
                 // Sound NMI enable is INVERTED: writing 0 enables NMI
                 self.sound_nmi_enabled = !value;
             }
@@ -484,6 +692,7 @@ impl NamcoGalagaBoard {
                 // Sub/sound CPU reset: 0 = held in reset, 1 = running
                 let was_reset = self.sub_reset;
                 self.sub_reset = !value;
+                self.yield_requested = true;
 
                 // When releasing from reset, defer CPU reset to tick()
                 // where bus access is available.
@@ -495,6 +704,7 @@ impl NamcoGalagaBoard {
                 // matching MAME's Dig Dug machine config which wires Q3
                 // to reset both 51XX and 53XX.
                 if !value {
+                    self.sync_mcu();
                     self.namco51.reset();
                     self.namco53.reset();
                 }
@@ -634,6 +844,7 @@ impl NamcoGalagaBoard {
 
     /// Dispatch an input event to the appropriate port bit (active-low).
     pub fn handle_input(&mut self, button: u8, pressed: bool) {
+        self.sync_mcu();
         match button {
             INPUT_P1_UP => crate::set_bit_active_low(&mut self.in0, 0, pressed),
             INPUT_P1_RIGHT => crate::set_bit_active_low(&mut self.in0, 1, pressed),
@@ -694,8 +905,12 @@ impl NamcoGalagaBoard {
         self.clock = 0;
         self.watchdog_counter = 0;
         self.flip_screen = false;
+        self.beam = BeamPosition::new();
 
         self.pending_sub_cpu_reset = false;
+        self.yield_requested = false;
+        self.mcu_pending = 0;
+        self.mcu_cs = false;
     }
 
     // -----------------------------------------------------------------------
@@ -828,6 +1043,9 @@ impl Saveable for NamcoGalagaBoard {
         // Timing
         self.clock = r.read_u64_le()?;
         self.watchdog_counter = r.read_u32_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
+        self.mcu_pending = 0;
+        self.mcu_cs = false;
 
         Ok(())
     }
@@ -838,3 +1056,326 @@ impl Default for NamcoGalagaBoard {
         Self::new()
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use phosphor_core::bus_split;
+    use phosphor_core::core::bus::InterruptState;
+    use phosphor_core::core::save_state::StateWriter;
+    use phosphor_core::cpu::Cpu;
+
+    /// Minimal Galaga-style bus: per-CPU ROM, the misc latch, shared RAM.
+    struct TestSystem {
+        board: NamcoGalagaBoard,
+        ram: Vec<u8>,
+    }
+
+    impl Bus for TestSystem {
+        type Address = u16;
+        type Data = u8;
+
+        fn read(&mut self, master: BusMaster, addr: u16) -> u8 {
+            match addr {
+                0x0000..=0x3FFF => self.board.read_rom(master, addr),
+                0x7000..=0x70FF => self.board.read_custom_io(),
+                0x7100 => self.board.namco06.ctrl_read(),
+                0x8000..=0xFFFF => self.ram[(addr - 0x8000) as usize],
+                _ => 0xFF,
+            }
+        }
+
+        fn write(&mut self, _master: BusMaster, addr: u16, data: u8) {
+            match addr {
+                0x6800..=0x681F => self.board.wsg.write(addr - 0x6800, data),
+                0x6820..=0x6827 => self.board.write_misc_latch((addr & 7) as u8, data & 1 != 0),
+                0x7000..=0x70FF => self.board.write_custom_io(data),
+                0x7100 => self.board.write_custom_io_ctrl(data),
+                0x8000..=0xFFFF => {
+                    self.board.request_yield();
+                    self.ram[(addr - 0x8000) as usize] = data;
+                }
+                _ => {}
+            }
+        }
+
+        fn is_halted_for(&self, master: BusMaster) -> bool {
+            self.board.is_halted_for(master)
+        }
+
+        fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
+            self.board.check_interrupts(target)
+        }
+    }
+
+    /// Main CPU releases the sub/sound reset and spins; the sub and sound
+    /// CPUs each count in their own RAM byte.
+    fn make_system(quantum: u32) -> TestSystem {
+        let mut board = NamcoGalagaBoard::new();
+        // LD A,1 ; LD (6823h),A ; JR $
+        board.load_main_rom(&[0x3E, 0x01, 0x32, 0x23, 0x68, 0x18, 0xFE]);
+        // LD HL,9000h ; loop: INC (HL) ; JR loop
+        board.load_sub_rom(&[0x21, 0x00, 0x90, 0x34, 0x18, 0xFD]);
+        // LD HL,9001h ; loop: INC (HL) ; JR loop
+        board.load_sound_rom(&[0x21, 0x01, 0x90, 0x34, 0x18, 0xFD]);
+        board.set_quantum(quantum);
+        let mut sys = TestSystem {
+            board,
+            ram: vec![0; 0x8000],
+        };
+        bus_split!(&mut sys, bus => {
+            sys.board.main_cpu.reset(bus, BusMaster::Cpu(0));
+            sys.board.sub_cpu.reset(bus, BusMaster::Cpu(1));
+            sys.board.sound_cpu.reset(bus, BusMaster::Cpu(2));
+        });
+        sys
+    }
+
+    fn run(sys: &mut TestSystem, cycles: u64) -> Vec<u8> {
+        bus_split!(sys, bus => {
+            sys.board.run_cycles(bus, cycles);
+        });
+        let mut w = StateWriter::new();
+        sys.board.save_state(&mut w);
+        let mut state = w.into_vec();
+        state.extend_from_slice(&sys.ram);
+        state
+    }
+
+    #[test]
+    fn quantum_scheduling_matches_lockstep_for_independent_cpus() {
+        let cycles = TIMING.cycles_per_frame() + 1234;
+        let mut lockstep = make_system(1);
+        let expected = run(&mut lockstep, cycles);
+        assert!(lockstep.ram[0x1000] != 0 && lockstep.ram[0x1001] != 0);
+
+        for quantum in [2, 37, 192, 1000] {
+            let mut sliced = make_system(quantum);
+            assert_eq!(run(&mut sliced, cycles), expected, "quantum {quantum}");
+            assert_eq!(sliced.board.clock, cycles);
+        }
+    }
+
+    /// All three CPUs run interrupt-driven programs over RAM of their own:
+    /// the main CPU drives the IRQ and sound NMI enables from its VBLANK
+    /// handler, the sub CPU counts its VBLANK IRQs, and the sound CPU
+    /// streams WSG register writes while counting its NMIs. Nothing crosses
+    /// between CPUs through shared RAM, the one path scanline slicing does
+    /// not keep cycle-exact.
+    fn make_raster_system(accuracy: Accuracy) -> TestSystem {
+        let mut sys = make_system(1);
+        #[rustfmt::skip]
+        let mut main_rom = vec![
+            0xF3,                   // DI
+            0x31, 0x00, 0x88,       // LD SP,8800h
+            0xED, 0x56,             // IM 1
+            0x3E, 0x01,             // LD A,1
+            0x32, 0x20, 0x68,       // LD (6820h),A  ; main IRQ enable
+            0x32, 0x21, 0x68,       // LD (6821h),A  ; sub IRQ enable
+            0xAF,                   // XOR A
+            0x32, 0x22, 0x68,       // LD (6822h),A  ; sound NMI enable (active low)
+            0x3E, 0x01,             // LD A,1
+            0x32, 0x23, 0x68,       // LD (6823h),A  ; release sub/sound
+            0xFB,                   // EI
+            0x21, 0x00, 0x80,       // LD HL,8000h
+            0x34,                   // loop: INC (HL)
+            0x7E,                   // LD A,(HL)
+            0x2C,                   // INC L
+            0x86,                   // ADD A,(HL)
+            0x77,                   // LD (HL),A
+            0x18, 0xF9,             // JR loop
+        ];
+        main_rom.resize(0x38, 0);
+        #[rustfmt::skip]
+        main_rom.extend_from_slice(&[
+            0xF5,                   // PUSH AF
+            0xAF,                   // XOR A
+            0x32, 0x20, 0x68,       // LD (6820h),A  ; acknowledge
+            0x3A, 0x00, 0x87,       // LD A,(8700h)
+            0x3C,                   // INC A
+            0x32, 0x00, 0x87,       // LD (8700h),A  ; frame count
+            0xE6, 0x01,             // AND 1
+            0x32, 0x22, 0x68,       // LD (6822h),A  ; sound NMI on even frames
+            0x3E, 0x01,             // LD A,1
+            0x32, 0x20, 0x68,       // LD (6820h),A
+            0xF1,                   // POP AF
+            0xFB,                   // EI
+            0xC9,                   // RET
+        ]);
+        sys.board.load_main_rom(&main_rom);
+
+        #[rustfmt::skip]
+        let mut sub_rom = vec![
+            0x31, 0x00, 0x98,       // LD SP,9800h
+            0xED, 0x56,             // IM 1
+            0xFB,                   // EI
+            0x21, 0x00, 0x90,       // LD HL,9000h
+            0x3A, 0x00, 0x97,       // loop: LD A,(9700h)
+            0x86,                   // ADD A,(HL)
+            0x77,                   // LD (HL),A
+            0x2C,                   // INC L
+            0x18, 0xF8,             // JR loop
+        ];
+        sub_rom.resize(0x38, 0);
+        #[rustfmt::skip]
+        sub_rom.extend_from_slice(&[
+            0xF5,                   // PUSH AF
+            0xAF,                   // XOR A
+            0x32, 0x21, 0x68,       // LD (6821h),A  ; acknowledge
+            0x3A, 0x00, 0x97,       // LD A,(9700h)
+            0x3C,                   // INC A
+            0x32, 0x00, 0x97,       // LD (9700h),A  ; IRQ count
+            0x3E, 0x01,             // LD A,1
+            0x32, 0x21, 0x68,       // LD (6821h),A
+            0xF1,                   // POP AF
+            0xFB,                   // EI
+            0xC9,                   // RET
+        ]);
+        sys.board.load_sub_rom(&sub_rom);
+
+        #[rustfmt::skip]
+        let mut sound_rom = vec![
+            0x31, 0x00, 0xA8,       // LD SP,A800h
+            0x21, 0x00, 0x68,       // LD HL,6800h
+            0x0E, 0x00,             // LD C,0
+            0x3A, 0x00, 0xA0,       // loop: LD A,(A000h)
+            0x81,                   // ADD A,C
+            0x77,                   // LD (HL),A     ; WSG register
+            0x0C,                   // INC C
+            0x7D,                   // LD A,L
+            0x3C,                   // INC A
+            0xE6, 0x1F,             // AND 1Fh
+            0x6F,                   // LD L,A
+            0x18, 0xF3,             // JR loop
+        ];
+        sound_rom.resize(0x66, 0);
+        #[rustfmt::skip]
+        sound_rom.extend_from_slice(&[
+            0xF5,                   // PUSH AF
+            0x3A, 0x00, 0xA0,       // LD A,(A000h)
+            0x3C,                   // INC A
+            0x32, 0x00, 0xA0,       // LD (A000h),A  ; NMI count
+            0xF1,                   // POP AF
+            0xED, 0x45,             // RETN
+        ]);
+        sys.board.load_sound_rom(&sound_rom);
+
+        let waveforms: Vec<u8> = (0..=255u8).map(|i| i.wrapping_mul(7) >> 4).collect();
+        sys.board.wsg.load_waveform_rom(&waveforms);
+        sys.board.set_accuracy(accuracy);
+        sys
+    }
+
+    #[test]
+    fn scanline_accuracy_matches_cycle_without_shared_ram_traffic() {
+        use std::hash::{DefaultHasher, Hash, Hasher};
+
+        const FRAMES: usize = 2000;
+        let run_frames = |accuracy| {
+            let mut sys = make_raster_system(accuracy);
+            let mut hashes = Vec::with_capacity(FRAMES);
+            let mut audio = Vec::new();
+            let mut buf = [0i16; 1024];
+            for _ in 0..FRAMES {
+                let mut h = DefaultHasher::new();
+                run(&mut sys, TIMING.cycles_per_frame()).hash(&mut h);
+                hashes.push(h.finish());
+                loop {
+                    let n = sys.board.fill_audio(&mut buf);
+                    audio.extend_from_slice(&buf[..n]);
+                    if n < buf.len() {
+                        break;
+                    }
+                }
+            }
+            (hashes, audio, sys)
+        };
+        let (cycle_hashes, cycle_audio, cycle) = run_frames(Accuracy::Cycle);
+        let (line_hashes, line_audio, _) = run_frames(Accuracy::Scanline);
+
+        // Every CPU, interrupt source and the WSG must have done work
+        assert!(cycle.ram[0x0700] != 0, "main VBLANK IRQs");
+        assert!(cycle.ram[0x1700] != 0, "sub VBLANK IRQs");
+        assert!(cycle.ram[0x2000] != 0, "sound NMIs");
+        assert!(cycle_audio.iter().any(|&s| s != cycle_audio[0]));
+
+        for (frame, (a, b)) in cycle_hashes.iter().zip(&line_hashes).enumerate() {
+            assert_eq!(a, b, "frame {frame} differs");
+        }
+        assert_eq!(cycle_audio, line_audio);
+    }
+
+    #[test]
+    fn quantum_scheduling_is_deterministic() {
+        let mut a = make_system(64);
+        let mut b = make_system(64);
+        for _ in 0..3 {
+            assert_eq!(run(&mut a, 10_000), run(&mut b, 10_000));
+        }
+    }
+
+    /// Main CPU streams writes and reads through the 06XX to an LLE 51XX
+    /// whose firmware samples K and the R ports and counts chip-select
+    /// IRQs; the sub and sound CPUs stay in reset.
+    fn make_mcu_system(on_demand: bool) -> TestSystem {
+        let mut sys = make_system(1);
+        #[rustfmt::skip]
+        let mut main_rom = vec![
+            0x3E, 0x41,             // LD A,41h     ; chip 0, write, timer /4
+            0x32, 0x00, 0x71,       // LD (7100h),A
+            0x04,                   // loop: INC B
+            0x78,                   // LD A,B
+            0x32, 0x00, 0x70,       // LD (7000h),A
+            0x0E, 0x60,             // LD C,60h
+            0x0D,                   // d1: DEC C
+            0x20, 0xFD,             // JR NZ,d1
+            0x3E, 0x51,             // LD A,51h     ; chip 0, read
+            0x32, 0x00, 0x71,       // LD (7100h),A
+            0x3A, 0x00, 0x70,       // LD A,(7000h)
+            0x32, 0x00, 0x80,       // LD (8000h),A
+            0x3E, 0x41,             // LD A,41h
+            0x32, 0x00, 0x71,       // LD (7100h),A
+            0x0E, 0x00,             // LD C,0
+            0x0D,                   // d2: DEC C
+            0x20, 0xFD,             // JR NZ,d2
+            0x18, 0xDF,             // JR loop
+        ];
+        main_rom.resize(0x66, 0);
+        main_rom.extend_from_slice(&[0xED, 0x45]); // 06XX NMI: RETN
+        sys.board.load_main_rom(&main_rom);
+        #[rustfmt::skip]
+        let firmware = [
+            0xC8,                   // 00: JMP 08h
+            0x00,
+            0x09, 0x3C,             // 02: external IRQ: ICM ; RTI
+            0x3C, 0x00,             // 04: timer IRQ: RTI
+            0x3C, 0x00,             // 06: serial IRQ: RTI
+            0x3E, 0x44,             // 08: EN 44h    ; external IRQ + TC counter
+            0x12,                   // 0A: INK
+            0x1D,                   // 0B: ST
+            0x08,                   // 0C: ICY
+            0x13,                   // 0D: IN
+            0x1D,                   // 0E: ST
+            0x08,                   // 0F: ICY
+            0xCA,                   // 10: JMP 0Ah
+            0xCA,                   // 11: JMP 0Ah   ; ICY cleared ST
+        ];
+        sys.board.load_51xx_rom(&firmware);
+        sys.board.set_mcu_on_demand(on_demand);
+        sys
+    }
+
+    #[test]
+    fn on_demand_mcu_matches_per_cycle_stepping() {
+        let mut stepped = make_mcu_system(false);
+        let mut on_demand = make_mcu_system(true);
+        for (i, cycles) in [5_000u64, 777, TIMING.cycles_per_frame(), 12_345]
+            .into_iter()
+            .enumerate()
+        {
+            stepped.board.handle_input(INPUT_COIN1, i % 2 == 0);
+            on_demand.board.handle_input(INPUT_COIN1, i % 2 == 0);
+            assert_eq!(run(&mut on_demand, cycles), run(&mut stepped, cycles));
+        }
+    }
+}
@@ -1,13 +1,13 @@
 use phosphor_core::core::machine::InputButton;
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, TimingConfig};
+use phosphor_core::core::{Accuracy, BeamPosition, Bus, BusMaster, TimingConfig};
 use phosphor_core::cpu::CpuStateTrait;
 use phosphor_core::cpu::state::Z80State;
 use phosphor_core::cpu::z80::Z80;
 use phosphor_core::device::namco_wsg::NamcoWsg;
 use phosphor_core::gfx;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::{GfxDecodes, GfxLayout};
 use phosphor_macros::{BusDebug, MemoryRegion};
 
 // ---------------------------------------------------------------------------
@@ -190,6 +190,13 @@ pub struct NamcoPacBoard {
     // Timing
     pub(crate) clock: u64,
     pub(crate) watchdog_counter: u32,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
+    // Clock the WSG has been ticked up to (derived; equals `clock` between
+    // scanline slices)
+    wsg_clock: u64,
+    // Scheduling granularity for `run_cycles` (runtime setting, not saved)
+    accuracy: Accuracy,
 }
 
 impl Default for NamcoPacBoard {
@@ -222,6 +229,9 @@ impl NamcoPacBoard {
             vblank_irq_pending: false,
             clock: 0,
             watchdog_counter: 0,
+            beam: BeamPosition::new(),
+            wsg_clock: 0,
+            accuracy: Accuracy::Cycle,
         }
     }
 
@@ -258,31 +268,120 @@ impl NamcoPacBoard {
     // -----------------------------------------------------------------------
 
     pub fn tick(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
+        if self.beam.at_line_start() {
+            self.scanline_events();
+        }
+
+        // WSG tick (runs at CPU clock rate)
+        self.wsg.tick();
+        self.wsg_clock = self.clock + 1;
+
+        self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
 
+        self.clock += 1;
+        self.beam.step(&TIMING);
+        self.watchdog_counter += 1;
+    }
+
+    /// Per-scanline work done before the CPU runs the line's first cycle.
+    fn scanline_events(&mut self) {
         // Per-scanline rendering: at each scanline boundary, render the current
         // scanline from VRAM + sprites before the CPU processes it, matching
         // hardware CRT read timing.
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = (frame_cycle / TIMING.cycles_per_scanline) as u16;
-            if scanline < VISIBLE_LINES as u16 {
-                self.render_scanline(scanline as usize);
+        let scanline = self.beam.scanline();
+        if scanline < VISIBLE_LINES {
+            self.render_scanline(scanline as usize);
+        } else if scanline == VISIBLE_LINES {
+            // VBLANK interrupt: fire at the start of VBLANK (scanline 224)
+            self.vblank_irq_pending = true;
+        }
+    }
+
+    /// Run `cycles` CPU cycles at the board's [`Accuracy`].
+    ///
+    /// At `Scanline` accuracy the Z80 runs up to a whole scanline on its own
+    /// and the WSG is caught up when the CPU writes a sound register and at
+    /// the end of the line. Raster work only happens at line starts, so the
+    /// result is identical to calling [`tick`](Self::tick) `cycles` times.
+    pub fn run_cycles(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, cycles: u64) {
+        if self.accuracy == Accuracy::Cycle {
+            let mut remaining = cycles;
+            while remaining > 0 {
+                let horizon = if self.beam.at_line_start() {
+                    0
+                } else {
+                    remaining.min(self.beam.cycles_until_next_scanline(&TIMING))
+                };
+                match self.skip_idle(bus, horizon) {
+                    0 => {
+                        self.tick(bus);
+                        remaining -= 1;
+                    }
+                    n => {
+                        self.beam.advance(&TIMING, n);
+                        self.catch_up_wsg(self.clock);
+                        remaining -= n;
+                    }
+                }
             }
+            return;
         }
 
-        // VBLANK interrupt: fire at the start of VBLANK (scanline 224)
-        let vblank_cycle = VISIBLE_LINES * TIMING.cycles_per_scanline;
-        if frame_cycle == vblank_cycle {
-            self.vblank_irq_pending = true;
+        let mut remaining = cycles;
+        while remaining > 0 {
+            if self.beam.at_line_start() {
+                self.scanline_events();
+            }
+            let n = remaining.min(self.beam.cycles_until_next_scanline(&TIMING));
+            let mut left = n;
+            while left > 0 {
+                left -= match self.skip_idle(bus, left) {
+                    0 => {
+                        self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
+                        self.clock += 1;
+                        self.watchdog_counter += 1;
+                        1
+                    }
+                    skipped => skipped,
+                };
+            }
+            self.beam.advance(&TIMING, n);
+            self.catch_up_wsg(self.clock);
+            remaining -= n;
         }
+    }
 
-        // WSG tick (runs at CPU clock rate)
-        self.wsg.tick();
+    /// Skip up to `max` cycles of an idle loop the Z80 is confirmed to be
+    /// in (see [`phosphor_core::cpu::idle`]), charging them to the clock and
+    /// watchdog; the caller moves the beam and WSG. `max` must not reach
+    /// the next scanline start, where the VBLANK IRQ is raised. Returns 0
+    /// when the next cycle has to be stepped.
+    fn skip_idle(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, max: u64) -> u64 {
+        let skipped = self.cpu.skip_idle(bus, BusMaster::Cpu(0), max);
+        self.clock += skipped;
+        self.watchdog_counter += skipped as u32;
+        skipped
+    }
 
-        self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
+    pub fn accuracy(&self) -> Accuracy {
+        self.accuracy
+    }
 
-        self.clock += 1;
-        self.watchdog_counter += 1;
+    pub fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.accuracy = accuracy;
+    }
+
+    /// Bring the WSG up to the cycle the CPU is executing. The WSG ticks
+    /// before the CPU within a cycle, so that cycle's tick is included.
+    fn sync_wsg(&mut self) {
+        self.catch_up_wsg(self.clock + 1);
+    }
+
+    fn catch_up_wsg(&mut self, until: u64) {
+        if until > self.wsg_clock {
+            self.wsg.tick_n((until - self.wsg_clock) as u32);
+            self.wsg_clock = until;
+        }
     }
 
     // -----------------------------------------------------------------------
@@ -318,6 +417,35 @@ impl NamcoPacBoard {
         data
     }
 
+    /// Shared `Bus::is_pure_read` logic: ROM and RAM are only written by
+    /// the Z80; inputs, DIP switches and the bus float are not.
+    /// Caller is responsible for address masking (e.g. A15 mirror).
+    pub fn is_pure_read_common(&self, addr: u16) -> bool {
+        !self.map.has_any_watchpoints()
+            && matches!(
+                self.map.page(addr).region_id,
+                Region::ROM | Region::VIDEO_RAM | Region::COLOR_RAM | Region::RAM
+            )
+    }
+
+    /// Shared `Bus::block_copy` logic for all Namco Pac hardware.
+    /// Sources may be ROM or any RAM; the map rejects anything touching I/O
+    /// or unmapped pages. Destinations are written ahead of the CPU's own
+    /// timing, so they must stay in work RAM below the sprite attributes
+    /// (0x4C00-0x4FEF): video, color and sprite RAM are read by the
+    /// renderer mid-frame.
+    /// Caller is responsible for address masking (e.g. A15 mirror).
+    pub fn block_copy_common(&mut self, src: u16, dst: u16, len: u32, descending: bool) -> bool {
+        let span = len.saturating_sub(1);
+        let first = if descending {
+            (dst as u32).checked_sub(span)
+        } else {
+            Some(dst as u32)
+        };
+        let private = first.is_some_and(|lo| lo >= 0x4C00 && lo + span <= 0x4FEF);
+        private && self.map.block_copy(src, dst, len, descending)
+    }
+
     /// Shared memory write logic for all Namco Pac hardware.
     /// Caller is responsible for address masking (e.g. A15 mirror).
     pub fn bus_write_common(&mut self, addr: u16, data: u8) {
@@ -341,6 +469,7 @@ impl NamcoPacBoard {
                             }
                         }
                         1 => {
+                            self.sync_wsg();
                             self.sound_enabled = value;
                             self.wsg.set_sound_enabled(value);
                         }
@@ -351,7 +480,10 @@ impl NamcoPacBoard {
                 }
 
                 // Namco WSG sound registers (32 nibble registers)
-                0x5040..=0x505F => self.wsg.write(addr - 0x5040, data),
+                0x5040..=0x505F => {
+                    self.sync_wsg();
+                    self.wsg.write(addr - 0x5040, data);
+                }
 
                 // Sprite coordinates
                 0x5060..=0x506F => self.sprite_coords[(addr - 0x5060) as usize] = data,
@@ -401,9 +533,9 @@ impl NamcoPacBoard {
         self.map.load_region(Region::Rom, data);
     }
 
-    pub fn load_gfx_rom(&mut self, gfx_data: &[u8]) {
-        self.tile_cache = decode_gfx(gfx_data, 0x0000, 256, &PACMAN_TILE_LAYOUT);
-        self.sprite_cache = decode_gfx(gfx_data, 0x1000, 64, &PACMAN_SPRITE_LAYOUT);
+    pub fn load_gfx_rom(&mut self, decodes: &GfxDecodes, gfx_data: &[u8]) {
+        self.tile_cache = decodes.decode(gfx_data, 0x0000, 256, &PACMAN_TILE_LAYOUT);
+        self.sprite_cache = decodes.decode(gfx_data, 0x1000, 64, &PACMAN_SPRITE_LAYOUT);
     }
 
     pub fn load_color_proms(&mut self, color_data: &[u8]) {
@@ -601,6 +733,8 @@ impl NamcoPacBoard {
         self.interrupt_vector = 0;
         self.vblank_irq_pending = false;
         self.clock = 0;
+        self.beam = BeamPosition::new();
+        self.wsg_clock = 0;
         self.watchdog_counter = 0;
         self.in0 = 0xFF;
         self.in1 = 0xFF;
@@ -658,6 +792,8 @@ impl Saveable for NamcoPacBoard {
         self.interrupt_vector = r.read_u8()?;
         self.vblank_irq_pending = r.read_bool()?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
+        self.wsg_clock = self.clock;
         self.watchdog_counter = r.read_u32_le()?;
         Ok(())
     }
@@ -1,6 +1,6 @@
 use phosphor_core::bus_split;
 use phosphor_core::core::bus::InterruptState;
-use phosphor_core::core::machine::{InputReceiver, Machine};
+use phosphor_core::core::machine::{Accuracy, InputReceiver, Machine};
 use phosphor_core::core::{Bus, BusMaster};
 use phosphor_core::cpu::Cpu;
 use phosphor_macros::Saveable;
@@ -119,7 +119,7 @@ impl PacmanSystem {
         self.board.load_program_rom(&rom_data);
 
         let gfx_data = PACMAN_GFX_ROM.load(rom_set)?;
-        self.board.load_gfx_rom(&gfx_data);
+        self.board.load_gfx_rom(rom_set.gfx(), &gfx_data);
 
         let color_data = PACMAN_COLOR_PROMS.load(rom_set)?;
         self.board.load_color_proms(&color_data);
@@ -164,6 +164,18 @@ impl Bus for PacmanSystem {
         self.board.bus_write_common(addr, data);
     }
 
+    fn block_copy(
+        &mut self,
+        _master: BusMaster,
+        src: u16,
+        dst: u16,
+        len: u32,
+        descending: bool,
+    ) -> bool {
+        self.board
+            .block_copy_common(src & 0x7FFF, dst & 0x7FFF, len, descending)
+    }
+
     fn io_read(&mut self, _master: BusMaster, _addr: u16) -> u8 {
         0xFF // No I/O read ports used on Pac-Man
     }
@@ -187,6 +199,10 @@ impl Bus for PacmanSystem {
             irq_vector: self.board.interrupt_vector,
         }
     }
+
+    fn is_pure_read(&self, _master: BusMaster, addr: u16) -> bool {
+        self.board.is_pure_read_common(addr & 0x7FFF)
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -210,12 +226,14 @@ impl Machine for PacmanSystem {
 
     fn run_frame(&mut self) {
         bus_split!(self, bus => {
-            for _ in 0..namco_pac::TIMING.cycles_per_frame() {
-                self.board.tick(bus);
-            }
+            self.board.run_cycles(bus, namco_pac::TIMING.cycles_per_frame());
         });
     }
 
+    fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.board.set_accuracy(accuracy);
+    }
+
     fn reset(&mut self) {
         self.board.reset_board();
         bus_split!(self, bus => {
@@ -237,15 +255,16 @@ fn create_machine(
 }
 
 inventory::submit! {
-    MachineEntry::new("pacman", &["pacman"], create_machine)
+    MachineEntry::new("pacman", &["pacman"], create_machine).with_accuracy(Accuracy::Scanline)
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
     use crate::namco_pac::Region;
-    use phosphor_core::core::machine::Machine;
+    use phosphor_core::core::machine::{AudioSource, Machine, Renderable};
     use phosphor_core::cpu::CpuStateTrait;
+    use phosphor_core::gfx::decode::GfxDecodes;
 
     #[test]
     fn save_load_round_trip() {
@@ -300,6 +319,18 @@ mod tests {
         assert_eq!(sys2.board.watchdog_counter, 99);
     }
 
+    #[test]
+    fn block_copy_only_targets_private_work_ram() {
+        let mut sys = PacmanSystem::new();
+        // Video, color and sprite attribute RAM are read by the renderer
+        assert!(!sys.board.block_copy_common(0x0000, 0x4000, 0x10, false));
+        assert!(!sys.board.block_copy_common(0x0000, 0x4400, 0x10, false));
+        assert!(!sys.board.block_copy_common(0x0000, 0x4FE8, 0x10, false));
+        assert!(!sys.board.block_copy_common(0x0000, 0x4C08, 0x10, true));
+        assert!(sys.board.block_copy_common(0x0000, 0x4C00, 0x3F0, false));
+        assert!(sys.board.block_copy_common(0x4000, 0x4FEF, 0x3F0, true));
+    }
+
     #[test]
     fn save_does_not_include_rom() {
         let mut sys = PacmanSystem::new();
@@ -316,4 +347,198 @@ mod tests {
         assert_eq!(sys2.board.map.region_data(Region::Rom)[0], 0x00);
         assert_eq!(sys2.board.tile_cache.pixel(0, 0, 0), 0);
     }
+
+    /// Run a synthetic program that streams writes into video RAM, the WSG
+    /// registers and the watchdog while a VBLANK handler toggles sound
+    /// enable, returning per-frame hashes of the rendered image, the audio
+    /// stream, and the final save state.
+    fn run_scanline_test_program(
+        accuracy: Accuracy,
+        frames: usize,
+    ) -> (Vec<u64>, Vec<i16>, Vec<u8>) {
+        use std::hash::{DefaultHasher, Hash, Hasher};
+
+        #[rustfmt::skip]
+        let program: &[u8] = &[
+            0xF3,             // DI
+            0x31, 0xC0, 0x4F, // LD SP,$4FC0
+            0xED, 0x56,       // IM 1
+            0x3E, 0x01,       // LD A,1
+            0x32, 0x00, 0x50, // LD ($5000),A   ; IRQ enable
+            0x32, 0x01, 0x50, // LD ($5001),A   ; sound enable
+            0x21, 0x00, 0x40, // LD HL,$4000
+            0x11, 0x00, 0x00, // LD DE,0
+            0xFB,             // EI
+            // loop:
+            0x1C,             // INC E
+            0x7B,             // LD A,E
+            0x77,             // LD (HL),A      ; video/color RAM
+            0x23,             // INC HL
+            0x7C,             // LD A,H
+            0xE6, 0x07,       // AND 7
+            0xF6, 0x40,       // OR $40
+            0x67,             // LD H,A         ; wrap HL within $4000-$47FF
+            0x7B,             // LD A,E
+            0xE6, 0x1F,       // AND $1F
+            0xF6, 0x40,       // OR $40
+            0x4F,             // LD C,A
+            0x06, 0x50,       // LD B,$50
+            0x7B,             // LD A,E
+            0x82,             // ADD A,D
+            0x02,             // LD (BC),A      ; WSG register $5040-$505F
+            0x32, 0xC0, 0x50, // LD ($50C0),A   ; kick watchdog
+            0x18, 0xE6,       // JR loop
+        ];
+        #[rustfmt::skip]
+        let isr: &[u8] = &[
+            0xF5,             // PUSH AF
+            0xAF,             // XOR A
+            0x32, 0x00, 0x50, // LD ($5000),A   ; acknowledge VBLANK
+            0x3C,             // INC A
+            0x32, 0x00, 0x50, // LD ($5000),A
+            0x14,             // INC D          ; frame counter
+            0x7A,             // LD A,D
+            0x32, 0x01, 0x50, // LD ($5001),A   ; toggle sound enable
+            0xF1,             // POP AF
+            0xFB,             // EI
+            0xED, 0x4D,       // RETI
+        ];
+        let mut rom = vec![0u8; 0x4000];
+        rom[..program.len()].copy_from_slice(program);
+        rom[0x38..0x38 + isr.len()].copy_from_slice(isr);
+
+        let mut sys = PacmanSystem::new();
+        sys.board.load_program_rom(&rom);
+        let gfx: Vec<u8> = (0..0x2000u32).map(|i| (i * 37 + (i >> 5)) as u8).collect();
+        sys.board.load_gfx_rom(&GfxDecodes::default(), &gfx);
+        let proms: Vec<u8> = (0..288u32).map(|i| (i * 11) as u8).collect();
+        sys.board.load_color_proms(&proms);
+        let wave: Vec<u8> = (0..256u32).map(|i| (i * 5) as u8).collect();
+        sys.board.load_sound_prom(&wave);
+        sys.set_accuracy(accuracy);
+        sys.reset();
+
+        let (w, h) = sys.display_size();
+        let mut image = vec![0u8; (w * h * 3) as usize];
+        let mut chunk = [0i16; 2048];
+        let mut hashes = Vec::with_capacity(frames);
+        let mut audio = Vec::new();
+        for _ in 0..frames {
+            sys.run_frame();
+            sys.render_frame(&mut image);
+            let mut hasher = DefaultHasher::new();
+            image.hash(&mut hasher);
+            hashes.push(hasher.finish());
+            let n = sys.fill_audio(&mut chunk);
+            audio.extend_from_slice(&chunk[..n]);
+        }
+        (hashes, audio, sys.save_state().unwrap())
+    }
+
+    /// Z80 polls a RAM flag set by the VBLANK handler and between polls
+    /// writes video RAM and a WSG register.
+    fn make_idle_system(accuracy: Accuracy, idle_skip: bool) -> PacmanSystem {
+        #[rustfmt::skip]
+        let program: &[u8] = &[
+            0xF3,             // DI
+            0x31, 0xC0, 0x4F, // LD SP,$4FC0
+            0xED, 0x56,       // IM 1
+            0x3E, 0x01,       // LD A,1
+            0x32, 0x00, 0x50, // LD ($5000),A   ; IRQ enable
+            0x32, 0x01, 0x50, // LD ($5001),A   ; sound enable
+            0x21, 0x00, 0x40, // LD HL,$4000
+            0xFB,             // EI
+            // wait:
+            0x3A, 0x00, 0x4D, // LD A,($4D00)
+            0xB7,             // OR A
+            0x28, 0xFA,       // JR Z,wait
+            0xAF,             // XOR A
+            0x32, 0x00, 0x4D, // LD ($4D00),A
+            0x1C,             // INC E
+            0x73,             // LD (HL),E
+            0x23,             // INC HL
+            0x7B,             // LD A,E
+            0x32, 0x45, 0x50, // LD ($5045),A   ; WSG volume
+            0x32, 0xC0, 0x50, // LD ($50C0),A   ; kick watchdog
+            0x18, 0xEA,       // JR wait
+        ];
+        #[rustfmt::skip]
+        let isr: &[u8] = &[
+            0xF5,             // PUSH AF
+            0xAF,             // XOR A
+            0x32, 0x00, 0x50, // LD ($5000),A   ; acknowledge VBLANK
+            0x3C,             // INC A
+            0x32, 0x00, 0x50, // LD ($5000),A
+            0x32, 0x00, 0x4D, // LD ($4D00),A   ; wake the main loop
+            0xF1,             // POP AF
+            0xFB,             // EI
+            0xED, 0x4D,       // RETI
+        ];
+        let mut rom = vec![0u8; 0x4000];
+        rom[..program.len()].copy_from_slice(program);
+        rom[0x38..0x38 + isr.len()].copy_from_slice(isr);
+
+        let mut sys = PacmanSystem::new();
+        sys.board.load_program_rom(&rom);
+        let wave: Vec<u8> = (0..256u32).map(|i| (i * 5) as u8).collect();
+        sys.board.load_sound_prom(&wave);
+        sys.set_accuracy(accuracy);
+        sys.board.cpu.idle.enabled = idle_skip;
+        sys.reset();
+        sys
+    }
+
+    #[test]
+    fn idle_skip_matches_stepping() {
+        for accuracy in [Accuracy::Cycle, Accuracy::Scanline] {
+            let mut stepped = make_idle_system(accuracy, false);
+            let mut skipping = make_idle_system(accuracy, true);
+            let mut chunk = [0i16; 2048];
+            for frame in 0..120 {
+                stepped.run_frame();
+                skipping.run_frame();
+                assert!(
+                    stepped.save_state() == skipping.save_state(),
+                    "{accuracy:?} frame {frame} differs"
+                );
+                let n = stepped.fill_audio(&mut chunk);
+                let expected = chunk[..n].to_vec();
+                let n = skipping.fill_audio(&mut chunk);
+                assert_eq!(&chunk[..n], expected.as_slice());
+            }
+            assert_eq!(skipping.board.map.region_data(Region::VideoRam)[100], 100);
+
+            // The main loop is a confirmed idle loop
+            let mut skipped = 0;
+            phosphor_core::bus_split!(&mut skipping, bus => {
+                for _ in 0..1000 {
+                    skipped = skipping.board.cpu.skip_idle(bus, BusMaster::Cpu(0), 100);
+                    if skipped > 0 {
+                        break;
+                    }
+                    skipping.board.tick(bus);
+                }
+            });
+            assert!(skipped > 0, "{accuracy:?}");
+        }
+    }
+
+    #[test]
+    fn scanline_accuracy_matches_cycle_stepping() {
+        const FRAMES: usize = 2000;
+        let (cycle_frames, cycle_audio, cycle_state) =
+            run_scanline_test_program(Accuracy::Cycle, FRAMES);
+        let (line_frames, line_audio, line_state) =
+            run_scanline_test_program(Accuracy::Scanline, FRAMES);
+
+        // The program must actually exercise video and sound
+        assert!(cycle_frames.windows(2).any(|w| w[0] != w[1]));
+        assert!(cycle_audio.iter().any(|&s| s != cycle_audio[0]));
+
+        for (frame, (a, b)) in cycle_frames.iter().zip(&line_frames).enumerate() {
+            assert_eq!(a, b, "frame {frame} differs");
+        }
+        assert_eq!(cycle_audio, line_audio);
+        assert_eq!(cycle_state, line_state);
+    }
 }
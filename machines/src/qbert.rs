@@ -216,7 +216,8 @@ impl QbertSystem {
         // GFX ROMs
         let tile_data = QBERT_TILE_ROM.load(rom_set)?;
         let sprite_data = QBERT_SPRITE_ROM.load(rom_set)?;
-        self.board.decode_gfx(&tile_data, &sprite_data);
+        self.board
+            .decode_gfx(rom_set.gfx(), &tile_data, &sprite_data);
 
         // Q*Bert uses ROM tiles for all codes (init_romtiles)
         self.board.gfxcharlo = true;
@@ -328,6 +329,51 @@ impl Bus for QbertSystem {
         false
     }
 
+    fn code_generation(&self, _master: BusMaster, addr: u32) -> Option<u32> {
+        // Program ROM (0x6000-0xFFFF) is the only region the map reports
+        // as immutable; RAM, mirrors, and I/O return None.
+        self.board.map.code_generation((addr & 0xFFFF) as u16)
+    }
+
+    fn block_copy(
+        &mut self,
+        _master: BusMaster,
+        src: u32,
+        dst: u32,
+        len: u32,
+        descending: bool,
+    ) -> bool {
+        // Only NVRAM/RAM (0x0000-0x2FFF) and program ROM (source only) are
+        // served straight from backing; sprite/video RAM mirror, char RAM
+        // decodes tiles, and palette/I/O have side effects.
+        fn window(addr: u16, write: bool) -> Option<bool> {
+            match addr {
+                0x0000..=0x2FFF => Some(true),
+                0x6000..=0xFFFF if !write => Some(false),
+                _ => None,
+            }
+        }
+        if len == 0 || len > 0x1_0000 {
+            return false;
+        }
+        let (src16, dst16) = ((src & 0xFFFF) as u16, (dst & 0xFFFF) as u16);
+        let span = (len - 1) as u16;
+        let end = |addr: u16| {
+            if descending {
+                addr.wrapping_sub(span)
+            } else {
+                addr.wrapping_add(span)
+            }
+        };
+        let plain = |addr: u16, write: bool| {
+            let w = window(addr, write);
+            w.is_some() && w == window(end(addr), write)
+        };
+        plain(src16, false)
+            && plain(dst16, true)
+            && self.board.map.block_copy(src16, dst16, len, descending)
+    }
+
     fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
         match target {
             BusMaster::Cpu(0) => {
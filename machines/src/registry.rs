@@ -1,11 +1,12 @@
 //! Machine registry for automatic front-end discovery.
 //!
 //! Each front-end-capable machine self-registers via [`inventory::submit!`]
-//! with a [`MachineEntry`] containing its CLI name, MAME ROM set name, and a
-//! factory function. The front-end discovers available machines at runtime
+//! with a [`MachineEntry`] containing its CLI name, MAME ROM set name, a
+//! factory function, and the coarsest [`Accuracy`] that matches cycle
+//! stepping exactly. The front-end discovers available machines at runtime
 //! without any central list.
 
-use phosphor_core::core::machine::Machine;
+use phosphor_core::core::machine::{Accuracy, Machine};
 
 use crate::rom_loader::{RomLoadError, RomSet};
 
@@ -17,6 +18,12 @@ pub struct MachineEntry {
     pub rom_names: &'static [&'static str],
     /// Factory: construct a Machine from a loaded ROM set.
     pub create: fn(&RomSet) -> Result<Box<dyn Machine>, RomLoadError>,
+    /// Coarsest scheduling granularity whose frames, audio and save states
+    /// match cycle stepping exactly. The front-end applies it with
+    /// [`Machine::set_accuracy`]. Levels that only approximate cycle
+    /// stepping (the Namco Galaga board's CPU slicing) stay opt-in and are
+    /// never registered here.
+    pub accuracy: Accuracy,
 }
 
 impl MachineEntry {
@@ -29,8 +36,15 @@ impl MachineEntry {
             name,
             rom_names,
             create,
+            accuracy: Accuracy::Cycle,
         }
     }
+
+    /// Declare that this machine can run at `accuracy` (default: cycle).
+    pub const fn with_accuracy(mut self, accuracy: Accuracy) -> Self {
+        self.accuracy = accuracy;
+        self
+    }
 }
 
 inventory::collect!(MachineEntry);
@@ -8,6 +8,8 @@
 use std::collections::HashMap;
 use std::path::Path;
 
+use phosphor_core::gfx::decode::GfxDecodes;
+
 // ---------------------------------------------------------------------------
 // CRC-32 (private)
 // ---------------------------------------------------------------------------
@@ -109,6 +111,8 @@ impl From<std::io::Error> for RomLoadError {
 /// A collection of ROM files loaded from disk or provided programmatically.
 pub struct RomSet {
     files: HashMap<String, Vec<u8>>,
+    verify_checksums: bool,
+    gfx: GfxDecodes,
 }
 
 impl RomSet {
@@ -131,7 +135,11 @@ impl RomSet {
                 files.insert(name, data);
             }
         }
-        Ok(Self { files })
+        Ok(Self {
+            files,
+            verify_checksums: true,
+            gfx: GfxDecodes::default(),
+        })
     }
 
     /// Create a RomSet from programmatic byte slices (for testing).
@@ -142,16 +150,39 @@ impl RomSet {
         for (name, data) in entries {
             files.insert(name.to_string(), data.to_vec());
         }
-        Self { files }
+        Self {
+            files,
+            verify_checksums: true,
+            gfx: GfxDecodes::default(),
+        }
     }
 
     /// Create a RomSet from owned entries (e.g. extracted from a ZIP file).
     pub fn from_entries(entries: Vec<(String, Vec<u8>)>) -> Self {
         Self {
             files: entries.into_iter().collect(),
+            verify_checksums: true,
+            gfx: GfxDecodes::default(),
         }
     }
 
+    /// Accept files whose CRC32 matches none of the expected checksums,
+    /// as [`RomRegion::load_skip_checksums`] does, for every region loaded
+    /// from this set. Sizes are still checked.
+    ///
+    /// Useful for hacked ROMs and synthetic sets built by tests and
+    /// benchmarks.
+    pub fn skip_checksums(mut self) -> Self {
+        self.verify_checksums = false;
+        self
+    }
+
+    /// Graphics decoded from this set. Machines decode through it, so
+    /// every instance created from one set shares the same pixels.
+    pub fn gfx(&self) -> &GfxDecodes {
+        &self.gfx
+    }
+
     /// Get a ROM file's data by name.
     pub fn get(&self, name: &str) -> Option<&[u8]> {
         self.files.get(name).map(|v| v.as_slice())
@@ -191,6 +222,18 @@ impl RomSet {
     pub fn file_names(&self) -> Vec<&str> {
         self.files.keys().map(|s| s.as_str()).collect()
     }
+
+    /// All files concatenated in name order, for use as the compression
+    /// dictionary of packed save files (`save_state::pack_state`). The
+    /// order is fixed so the same set always yields the same dictionary.
+    pub fn dictionary(&self) -> Vec<u8> {
+        let mut names: Vec<&String> = self.files.keys().collect();
+        names.sort();
+        names
+            .into_iter()
+            .flat_map(|name| self.files[name].iter().copied())
+            .collect()
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -227,9 +270,10 @@ pub struct RomRegion {
 
 impl RomRegion {
     /// Load all ROM files into a contiguous byte array, validating sizes
-    /// and CRC32 checksums.
+    /// and CRC32 checksums (unless the set was built with
+    /// [`RomSet::skip_checksums`]).
     pub fn load(&self, rom_set: &RomSet) -> Result<Vec<u8>, RomLoadError> {
-        self.load_inner(rom_set, true)
+        self.load_inner(rom_set, rom_set.verify_checksums)
     }
 
     /// Load all ROM files into a contiguous byte array, validating sizes
@@ -375,6 +419,13 @@ mod tests {
         assert_eq!(names, vec!["alpha.rom", "beta.rom"]);
     }
 
+    #[test]
+    fn dictionary_concatenates_in_name_order() {
+        let rom_set =
+            RomSet::from_slices(&[("b.rom", &[3, 4]), ("a.rom", &[1, 2]), ("c.rom", &[5])]);
+        assert_eq!(rom_set.dictionary(), vec![1, 2, 3, 4, 5]);
+    }
+
     // -- RomRegion::load -----------------------------------------------------
 
     #[test]
@@ -447,6 +498,23 @@ mod tests {
         assert_eq!(result.unwrap(), vec![0x01, 0x02, 0x03, 0x04]);
     }
 
+    #[test]
+    fn rom_set_skip_checksums_applies_to_load() {
+        static ENTRIES: [RomEntry; 1] = [RomEntry {
+            name: "test.rom",
+            size: 4,
+            offset: 0,
+            crc32: &[0xDEAD_BEEF], // wrong checksum
+        }];
+        let region = RomRegion {
+            size: 4,
+            entries: &ENTRIES,
+        };
+        let rom_set =
+            RomSet::from_slices(&[("test.rom", &[0x01, 0x02, 0x03, 0x04])]).skip_checksums();
+        assert_eq!(region.load(&rom_set).unwrap(), vec![0x01, 0x02, 0x03, 0x04]);
+    }
+
     #[test]
     fn load_size_mismatch_even_with_skip_checksums() {
         static ENTRIES: [RomEntry; 1] = [RomEntry {
@@ -229,7 +229,7 @@ impl SatansHollowSystem {
         // GFX ROMs
         let bg_data = SHOLLOW_BG_ROM.load(rom_set)?;
         let fg_data = SHOLLOW_FG_ROM.load(rom_set)?;
-        self.board.decode_gfx(&bg_data, &fg_data);
+        self.board.decode_gfx(rom_set.gfx(), &bg_data, &fg_data);
 
         // Set IP3 to active-high idle (0x00 instead of default 0xFF)
         self.board.ssio.set_input_port(3, 0x00);
@@ -324,15 +324,11 @@ impl Bus for SatansHollowSystem {
     fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
         match target {
             BusMaster::Cpu(0) => {
-                if self.board.ctc.interrupt_pending() {
-                    let vector = self.board.ctc.interrupt_vector();
-                    self.board.ctc_vector_latch = vector;
+                let line = self.board.irq_line;
+                if line.irq {
+                    self.board.ctc_vector_latch = line.irq_vector;
                     self.board.ctc_ack_needed = true;
-                    InterruptState {
-                        irq: true,
-                        irq_vector: vector,
-                        ..Default::default()
-                    }
+                    line
                 } else {
                     // Return latched vector for INTA cycle (Z80 reads irq_vector
                     // during interrupt acknowledge regardless of irq flag)
@@ -615,6 +611,36 @@ mod tests {
         assert_eq!(sys.board.ctc.read(0), 0); // counter value (vector base isn't readable this way)
     }
 
+    #[test]
+    fn irq_line_follows_ctc() {
+        let mut sys = SatansHollowSystem::new();
+
+        // Vector base 0xE0; channel 1 counter mode, IRQ enabled, TC = 1
+        Bus::io_write(&mut sys, BusMaster::Cpu(0), 0xF0, 0xE0);
+        Bus::io_write(&mut sys, BusMaster::Cpu(0), 0xF1, 0xC5);
+        Bus::io_write(&mut sys, BusMaster::Cpu(0), 0xF1, 1);
+        sys.board.sync_irq_line();
+        assert!(!Bus::check_interrupts(&mut sys, BusMaster::Cpu(0)).irq);
+
+        // One falling edge fires channel 1
+        sys.board.ctc.trigger(1, true);
+        sys.board.ctc.trigger(1, false);
+        sys.board.sync_irq_line();
+        let ints = Bus::check_interrupts(&mut sys, BusMaster::Cpu(0));
+        assert!(ints.irq);
+        assert_eq!(ints.irq_vector, 0xE2);
+        assert!(sys.board.ctc_ack_needed);
+
+        // Acknowledge drops the line; the latched vector is still presented
+        sys.board.ctc.acknowledge_interrupt();
+        sys.board.ctc_ack_needed = false;
+        sys.board.sync_irq_line();
+        let ints = Bus::check_interrupts(&mut sys, BusMaster::Cpu(0));
+        assert!(!ints.irq);
+        assert_eq!(ints.irq_vector, 0xE2);
+        assert!(!sys.board.ctc_ack_needed);
+    }
+
     #[test]
     fn memory_map_rom_read() {
         let mut sys = SatansHollowSystem::new();
@@ -2,7 +2,7 @@ use phosphor_core::audio::AudioResampler;
 use phosphor_core::core::bus::InterruptState;
 use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
 use phosphor_core::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, ClockDivider, TimingConfig};
+use phosphor_core::core::{Accuracy, BeamPosition, Bus, BusMaster, ClockDivider, TimingConfig};
 use phosphor_core::cpu::i8035::I8035;
 use phosphor_core::cpu::z80::Z80;
 use phosphor_core::device::dac::Mc1408Dac;
@@ -10,7 +10,7 @@ use phosphor_core::device::dkong_discrete::DkongDiscrete;
 use phosphor_core::device::i8257::I8257;
 use phosphor_core::device::output_latch::OutputLatch;
 use phosphor_core::gfx;
-use phosphor_core::gfx::decode::{GfxLayout, decode_gfx};
+use phosphor_core::gfx::decode::{GfxDecodes, GfxLayout};
 use phosphor_macros::{BusDebug, MemoryRegion};
 
 // ---------------------------------------------------------------------------
@@ -231,6 +231,14 @@ pub struct Tkg04Board {
     // Discrete sound effects (walk, jump, stomp)
     #[debug_device("Discrete")]
     pub(crate) discrete: DkongDiscrete,
+
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
+    // Clock the sound side has run up to (derived; equals `clock` between
+    // scanline slices)
+    sound_synced: u64,
+    // Scheduling granularity for `run_cycles` (runtime setting, not saved)
+    accuracy: Accuracy,
 }
 
 impl Tkg04Board {
@@ -274,6 +282,9 @@ impl Tkg04Board {
             sound_clock: ClockDivider::new(SOUND_TICK_NUM, SOUND_TICK_DEN),
             vblank_nmi_pending: false,
             discrete: DkongDiscrete::new(),
+            beam: BeamPosition::new(),
+            sound_synced: 0,
+            accuracy: Accuracy::Cycle,
         }
     }
 
@@ -304,12 +315,12 @@ impl Tkg04Board {
 
     /// Pre-decode tile and sprite ROMs into GFX caches.
     /// Call after loading tile_rom and sprite_rom.
-    pub fn decode_gfx_roms(&mut self) {
+    pub fn decode_gfx_roms(&mut self, decodes: &GfxDecodes) {
         // Tiles: separated-plane 2bpp, 8x8
         let tile_count = self.tile_plane1_offset / 8; // DK: 256, DK Jr: 512
         let plane1_bits = self.tile_plane1_offset * 8;
         let tile_planes: [usize; 2] = [0, plane1_bits];
-        self.tile_cache = decode_gfx(
+        self.tile_cache = decodes.decode(
             &self.tile_rom,
             0,
             tile_count,
@@ -329,7 +340,7 @@ impl Tkg04Board {
         let x_offsets: [usize; 16] =
             std::array::from_fn(|px| if px < 8 { px } else { q8 + (px - 8) });
         let y_offsets: [usize; 16] = std::array::from_fn(|py| py * 8);
-        self.sprite_cache = decode_gfx(
+        self.sprite_cache = decodes.decode(
             &self.sprite_rom,
             0,
             sprite_count,
@@ -465,7 +476,9 @@ impl Tkg04Board {
             if (test & 0xF0) == 0xF0 {
                 let row_in_sprite = test & 0x0F;
 
-                let spr_code = (code_byte & 0x7F) as u16 | (((attr_byte & 0x40) as u16) << 1);
+                // Sets with only 128 sprites ignore the bank bit
+                let spr_code = ((code_byte & 0x7F) as usize | (((attr_byte & 0x40) as usize) << 1))
+                    % sprite_cache.count().max(1);
                 let flip_y = (code_byte & 0x80) != 0;
                 let flip_x = (attr_byte & 0x80) != 0;
                 let color_attr = (attr_byte & 0x0F) + 0x10 * palette_bank;
@@ -485,7 +498,7 @@ impl Tkg04Board {
                 };
                 gfx::sprite::draw_sprite_row(
                     sprite_cache,
-                    spr_code,
+                    spr_code as u16,
                     src_py as usize,
                     sprite_x,
                     flip_x,
@@ -509,29 +522,39 @@ impl Tkg04Board {
     /// The `bus` parameter is the game wrapper (which implements `Bus`) passed
     /// in from the wrapper's `run_frame()` / `debug_tick()`.
     pub fn tick(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-
-        // Per-scanline rendering at scanline boundary
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = (frame_cycle / TIMING.cycles_per_scanline) as u16;
-            if scanline < VISIBLE_LINES as u16 {
-                self.render_scanline(scanline as usize);
-            }
+        if self.beam.at_line_start() {
+            self.scanline_events();
         }
 
-        // VBLANK NMI: assert at scanline 240
-        let vblank_cycle = VISIBLE_LINES * TIMING.cycles_per_scanline;
-        if frame_cycle == vblank_cycle {
+        // Execute main CPU cycle
+        self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
+
+        self.step_sound(bus);
+
+        self.clock += 1;
+        self.beam.step(&TIMING);
+        self.sound_synced = self.clock;
+    }
+
+    /// Per-scanline work done before the CPUs run the line's first cycle.
+    fn scanline_events(&mut self) {
+        let scanline = self.beam.scanline();
+        if scanline < VISIBLE_LINES {
+            // Per-scanline rendering at scanline boundary
+            self.render_scanline(scanline as usize);
+        } else if scanline == VISIBLE_LINES {
+            // VBLANK NMI: assert at scanline 240
             self.vblank_nmi_pending = true;
         }
         // Clear NMI at frame boundary (end of VBLANK)
-        if frame_cycle == 0 && self.clock > 0 {
+        if scanline == 0 && self.clock > 0 {
             self.vblank_nmi_pending = false;
         }
+    }
 
-        // Execute main CPU cycle
-        self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
-
+    /// One master-clock cycle of the sound side: the I8035 (when its divider
+    /// fires) and audio accumulation.
+    fn step_sound(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
         // Tick sound CPU (Bresenham 25/192 ratio: 400 kHz from 3.072 MHz)
         if self.sound_clock.tick() {
             self.sound_cpu.execute_cycle(bus, BusMaster::Cpu(1));
@@ -543,8 +566,59 @@ impl Tkg04Board {
             let mixed = (dac_avg as i32 + discrete_sample).clamp(-32767, 32767) as i16;
             self.resampler.push_sample(mixed);
         }
+    }
 
-        self.clock += 1;
+    /// Run the sound side up to (not including) the cycle the main CPU is
+    /// executing.
+    ///
+    /// The game wrapper calls this before the main CPU touches anything the
+    /// sound side sees (sound latch, control latches, sound IRQ) or reads
+    /// sound CPU state, so the access lands on the same sound cycle as in
+    /// cycle stepping. A no-op under [`tick`](Self::tick).
+    pub fn sync_sound(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>) {
+        while self.sound_synced < self.clock {
+            self.step_sound(bus);
+            self.sound_synced += 1;
+        }
+    }
+
+    /// Run `cycles` master-clock cycles at the board's [`Accuracy`].
+    ///
+    /// At `Scanline` accuracy the Z80 runs up to a whole scanline on its own
+    /// and the sound side catches up through [`sync_sound`](Self::sync_sound)
+    /// when the Z80 talks to it and at the end of the line. The sound CPU
+    /// never affects the Z80 except through the synced status read, so the
+    /// result is identical to calling [`tick`](Self::tick) `cycles` times.
+    pub fn run_cycles(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, cycles: u64) {
+        if self.accuracy == Accuracy::Cycle {
+            for _ in 0..cycles {
+                self.tick(bus);
+            }
+            return;
+        }
+
+        let mut remaining = cycles;
+        while remaining > 0 {
+            if self.beam.at_line_start() {
+                self.scanline_events();
+            }
+            let n = remaining.min(self.beam.cycles_until_next_scanline(&TIMING));
+            for _ in 0..n {
+                self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
+                self.clock += 1;
+            }
+            self.beam.advance(&TIMING, n);
+            self.sync_sound(bus);
+            remaining -= n;
+        }
+    }
+
+    pub fn accuracy(&self) -> Accuracy {
+        self.accuracy
+    }
+
+    pub fn set_accuracy(&mut self, accuracy: Accuracy) {
+        self.accuracy = accuracy;
     }
 
     // -----------------------------------------------------------------------
@@ -590,6 +664,8 @@ impl Tkg04Board {
         self.dma.reset();
 
         self.clock = 0;
+        self.beam = BeamPosition::new();
+        self.sound_synced = 0;
         self.sound_clock.reset();
         self.resampler.reset();
         self.dac.reset();
@@ -702,6 +778,8 @@ impl Saveable for Tkg04Board {
         self.sound_irq_pending = r.read_bool()?;
         self.resampler.load_state(r)?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
+        self.sound_synced = self.clock;
         self.sound_clock.load_state(r)?;
         self.vblank_nmi_pending = r.read_bool()?;
         Ok(())
@@ -1,16 +1,21 @@
+use std::sync::mpsc;
+use std::thread;
+
 use phosphor_core::audio::AudioResampler;
 use phosphor_core::core::bus::InterruptState;
-use phosphor_core::core::memory_map::{AccessKind, MemoryMap};
+use phosphor_core::core::debug::{BusDebug, DebugCpu, Debuggable};
+use phosphor_core::core::memory_map::{AccessKind, MemoryMap, WatchpointHit, WatchpointKind};
 use phosphor_core::core::save_state::{SaveError, Saveable, StateReader, StateWriter};
-use phosphor_core::core::{Bus, BusMaster, TimingConfig};
-use phosphor_core::cpu::CpuStateTrait;
+use phosphor_core::core::{BeamPosition, Bus, BusMaster, TimingConfig};
 use phosphor_core::cpu::m6800::M6800;
 use phosphor_core::cpu::m6809::M6809;
 use phosphor_core::cpu::state::{M6800State, M6809State};
+use phosphor_core::cpu::{Cpu, CpuStateTrait};
+use phosphor_core::device::Device;
 use phosphor_core::device::dac::Mc1408Dac;
 use phosphor_core::device::pia6820::Pia6820;
 use phosphor_core::device::williams_blitter::WilliamsBlitter;
-use phosphor_macros::{BusDebug, MemoryRegion};
+use phosphor_macros::MemoryRegion;
 
 use crate::rom_loader::{RomEntry, RomLoadError, RomRegion, RomSet};
 
@@ -100,48 +105,41 @@ pub static WILLIAMS_SOUND_ROM: RomRegion = RomRegion {
 ///
 /// Game-specific machines (Joust, Robotron, etc.) compose this struct and
 /// provide their own ROM definitions and input wiring.
-#[derive(BusDebug)]
 pub struct WilliamsBoard {
-    // CPUs (debug reads/writes auto-routed through matching #[debug_map])
-    #[debug_cpu("M6809 Main")]
     pub(crate) cpu: M6809,
-    #[debug_cpu("M6800 Sound")]
-    pub(crate) sound_cpu: M6800,
 
     // Peripheral devices
-    #[debug_device("Widget PIA")]
     pub(crate) widget_pia: Pia6820, // 0xC804-0xC807: player inputs
-    #[debug_device("ROM PIA")]
-    pub(crate) rom_pia: Pia6820, // 0xC80C-0xC80F: ROM bank, video timing
-    #[debug_device("Blitter")]
+    pub(crate) rom_pia: Pia6820,    // 0xC80C-0xC80F: ROM bank, video timing
     pub(crate) blitter: WilliamsBlitter, // 0xCA00-0xCA07: DMA blitter
 
     // I/O registers
     pub(crate) rom_bank: u8, // 0xC900: ROM bank select
 
-    // Sound board
-    #[debug_device("Sound PIA")]
-    pub(crate) sound_pia: Pia6820, // 0x0400-0x0403: Sound PIA
-
-    // Audio output
-    #[debug_device("DAC")]
-    pub(crate) dac: Mc1408Dac,
-    pub(crate) resampler: AudioResampler<i16>,
+    // Sound board. Owned here except during a frame run with a sound
+    // worker, when the worker holds it (None) until `end_frame`.
+    sound: Option<Box<SoundBoard>>,
+    sound_worker: Option<SoundWorker>,
 
-    // Memory maps (page-table dispatch + watchpoints + backing memory)
-    // All RAM/ROM storage lives in the MemoryMap backing store.
-    #[debug_map(cpu = 0)]
+    // Main CPU memory map (page-table dispatch + watchpoints + backing
+    // memory). All RAM/ROM storage lives in the MemoryMap backing store.
     pub(crate) main_map: MemoryMap,
-    #[debug_map(cpu = 1)]
-    pub(crate) sound_map: MemoryMap,
 
     // System state
     pub watchdog_counter: u32,
     pub(crate) clock: u64,
+    // Raster position of `clock` (derived; rebuilt from `clock` on load)
+    beam: BeamPosition,
 
     // ROM PIA Port A input (game sets coin/service bits)
     pub(crate) rom_pia_input: u8,
 
+    // Interrupt line seen by the main CPU. Derived from the ROM PIA
+    // outputs; `sync_irq_lines` refreshes it when the PIA reports a level
+    // change, so the per-fetch `bus_check_interrupts` is a plain load.
+    // Not saved: recomputed on load.
+    irq_line: InterruptState,
+
     // Scanline-rendered framebuffer (292 × 240 × RGB24)
     pub(crate) scanline_buffer: Vec<u8>,
 }
@@ -150,19 +148,18 @@ impl WilliamsBoard {
     pub fn new() -> Self {
         Self {
             cpu: M6809::new(),
-            sound_cpu: M6800::new(),
             widget_pia: Pia6820::new(),
             rom_pia: Pia6820::new(),
             blitter: WilliamsBlitter::new(),
             rom_bank: 0,
-            sound_pia: Pia6820::new(),
-            dac: Mc1408Dac::new(),
-            resampler: AudioResampler::new(1_000_000, 44_100),
+            sound: Some(Box::new(SoundBoard::new())),
+            sound_worker: None,
             main_map: Self::build_main_map(),
-            sound_map: Self::build_sound_map(),
             watchdog_counter: 0,
             clock: 0,
+            beam: BeamPosition::new(),
             rom_pia_input: 0,
+            irq_line: InterruptState::default(),
             scanline_buffer: vec![
                 0u8;
                 TIMING.display_width as usize * TIMING.display_height as usize * 3
@@ -191,19 +188,6 @@ impl WilliamsBoard {
         map
     }
 
-    fn build_sound_map() -> MemoryMap {
-        use SoundRegion::*;
-        let mut map = MemoryMap::new();
-        map.region(Ram, "Sound RAM", 0x0000, 0x100, AccessKind::ReadWrite)
-            .region(IoPia, "Sound PIA", 0x0400, 0x100, AccessKind::Io)
-            .region(Rom, "Sound ROM", 0xF000, 0x1000, AccessKind::ReadOnly)
-            .mirror(0xB000, 0xF000, 0x1000)
-            .mirror(0xC000, 0xF000, 0x1000)
-            .mirror(0xD000, 0xF000, 0x1000)
-            .mirror(0xE000, 0xF000, 0x1000);
-        map
-    }
-
     // --- Accessors ---
 
     pub fn get_cpu_state(&self) -> M6809State {
@@ -211,7 +195,7 @@ impl WilliamsBoard {
     }
 
     pub fn get_sound_cpu_state(&self) -> M6800State {
-        self.sound_cpu.snapshot()
+        self.sound().cpu.snapshot()
     }
 
     pub fn read_video_ram(&self, addr: usize) -> u8 {
@@ -271,7 +255,9 @@ impl WilliamsBoard {
     /// Load sound ROM from a byte slice at the given offset.
     /// Offset is relative to the start of the sound ROM region (0 = address 0xF000).
     pub fn load_sound_rom(&mut self, offset: usize, data: &[u8]) {
-        self.sound_map
+        self.sound_mut()
+            .bus
+            .map
             .load_region_at(SoundRegion::Rom, offset, data);
     }
 
@@ -291,17 +277,19 @@ impl WilliamsBoard {
         self.main_map.load_region(MainRegion::ProgramRom, &rom_data);
 
         let sound_data = sound_rom_region.load(rom_set)?;
-        self.sound_map.load_region(SoundRegion::Rom, &sound_data);
+        self.sound_mut()
+            .bus
+            .map
+            .load_region(SoundRegion::Rom, &sound_data);
 
         Ok(())
     }
 
     // --- Internal timing/rendering ---
 
-    /// Current scanline number derived from the master clock.
+    /// Current scanline number (low 8 bits, as seen by the video counter).
     fn current_scanline(&self) -> u8 {
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        (frame_cycle / TIMING.cycles_per_scanline) as u8
+        self.beam.scanline() as u8
     }
 
     /// Render a single scanline from VRAM + palette into the internal scanline buffer.
@@ -361,9 +349,8 @@ impl WilliamsBoard {
         // Video timing signals on ROM PIA.
         // VA11 (scanline bit 5) → ROM PIA CB1, count240 → ROM PIA CA1.
         // These drive the main CPU's IRQ via ROM PIA interrupt outputs.
-        let frame_cycle = self.clock % TIMING.cycles_per_frame();
-        if frame_cycle.is_multiple_of(TIMING.cycles_per_scanline) {
-            let scanline = (frame_cycle / TIMING.cycles_per_scanline) as u16;
+        if self.beam.at_line_start() {
+            let scanline = self.beam.scanline() as u16;
 
             // Render this scanline from current VRAM + palette before the CPU
             // processes it, matching hardware CRT read timing.
@@ -377,16 +364,24 @@ impl WilliamsBoard {
             }
             // count240: asserted from scanline 240 through VBLANK
             self.rom_pia.set_ca1(scanline >= 240);
+            self.sync_irq_lines();
+
+            // Let the sound worker run up to this line.
+            if self.sound.is_none() {
+                self.sound_worker().send(SoundMsg::RunTo(self.clock));
+            }
         }
 
         // Propagate sound commands from main board ROM PIA to sound board PIA.
-        // High two bits are externally pulled high on real hardware.
-        // CB1 is held low for 0xFF (silence sentinel), asserted high otherwise to
-        // generate an IRQ on the sound CPU.
         if self.rom_pia.take_port_b_written() {
-            let command = self.rom_pia.read_output_b() | 0xC0;
-            self.sound_pia.set_port_b_input(command);
-            self.sound_pia.set_cb1(command != 0xFF);
+            let data = self.rom_pia.read_output_b();
+            match &mut self.sound {
+                Some(sound) => sound.bus.command(data),
+                None => {
+                    let clock = self.clock;
+                    self.sound_worker().send(SoundMsg::Command { clock, data });
+                }
+            }
         }
 
         if self.blitter.is_active() {
@@ -394,40 +389,65 @@ impl WilliamsBoard {
         } else {
             self.cpu.execute_cycle(bus, BusMaster::Cpu(0));
         }
-        // Sound CPU runs every cycle (separate bus, not halted by blitter)
-        self.sound_cpu.execute_cycle(bus, BusMaster::Cpu(1));
-
-        // DAC is continuously connected to sound PIA Port A output pins
-        let dac_byte = self.sound_pia.read_output_a();
-        self.dac.write(dac_byte);
 
-        // Bresenham downsample: 1 MHz CPU clock -> 44.1 kHz output
-        self.resampler.tick(self.dac.sample_i16());
+        // Sound CPU runs every cycle (separate bus, not halted by blitter).
+        // DAC audio is rendered lazily by `SoundBus::sync_audio`.
+        if let Some(sound) = &mut self.sound {
+            sound.step();
+        }
 
         self.clock += 1;
+        self.beam.step(&TIMING);
         self.watchdog_counter += 1;
     }
 
+    /// Advance one cycle, or several at once while the main CPU sits in an
+    /// idle loop (see [`phosphor_core::cpu::idle`]). Skipping stops short
+    /// of the next scanline start, where the ROM PIA can raise an IRQ, and
+    /// of `budget`. Returns the cycles consumed.
+    pub fn step(&mut self, bus: &mut dyn Bus<Address = u16, Data = u8>, budget: u64) -> u64 {
+        let skipped = if self.beam.at_line_start() || self.blitter.is_active() {
+            0
+        } else {
+            let horizon = budget.min(self.beam.cycles_until_next_scanline(&TIMING));
+            self.cpu.skip_idle(bus, BusMaster::Cpu(0), horizon)
+        };
+        if skipped == 0 {
+            self.tick(bus);
+            return 1;
+        }
+        if let Some(sound) = &mut self.sound {
+            for _ in 0..skipped {
+                sound.step();
+            }
+        }
+        self.clock += skipped;
+        self.beam.advance(&TIMING, skipped);
+        self.watchdog_counter += skipped as u32;
+        skipped
+    }
+
     // --- Reset ---
 
     pub fn reset(&mut self) {
         // Reset peripherals first so bus is in a known state
         self.widget_pia.reset();
         self.rom_pia.reset();
-        self.sound_pia.reset();
         self.blitter.reset();
         self.rom_bank = 0;
         // Ensure pages 0x00-0x8F point to VIDEO_RAM (undo any bank switch)
         self.main_map
             .remap_pages(0x00, 0x90, MainRegion::VideoRam, 0);
-        self.dac.reset();
-        self.resampler.reset();
         self.watchdog_counter = 0;
         self.clock = 0;
+        self.beam = BeamPosition::new();
         self.rom_pia_input = 0;
+        self.sync_irq_lines();
+        self.sound_mut().reset();
         self.scanline_buffer.fill(0);
         // CMOS RAM and video RAM NOT cleared (battery-backed / not cleared by hardware)
-        // CPU resets are done by the game wrapper via bus_split! since Bus is on the wrapper.
+        // The main CPU reset is done by the game wrapper via bus_split! since
+        // its Bus is on the wrapper; the sound CPU has its own bus.
     }
 
     // --- Debug helpers ---
@@ -439,7 +459,7 @@ impl WilliamsBoard {
         if self.cpu.at_instruction_boundary() {
             result |= 1;
         }
-        if self.sound_cpu.at_instruction_boundary() {
+        if self.sound().cpu.at_instruction_boundary() {
             result |= 2;
         }
         result
@@ -452,29 +472,97 @@ impl WilliamsBoard {
     }
 
     pub fn fill_audio(&mut self, buffer: &mut [i16]) -> usize {
-        self.resampler.fill_audio(buffer)
+        let bus = &mut self.sound_mut().bus;
+        bus.sync_audio();
+        bus.resampler.fill_audio(buffer)
+    }
+
+    // --- Sound board ---
+
+    /// The sound board. Only the worker can reach it between
+    /// [`begin_frame`](Self::begin_frame) and [`end_frame`](Self::end_frame),
+    /// so calling this then panics.
+    pub(crate) fn sound(&self) -> &SoundBoard {
+        self.sound.as_deref().expect("sound board is on the worker")
+    }
+
+    pub(crate) fn sound_mut(&mut self) -> &mut SoundBoard {
+        self.sound
+            .as_deref_mut()
+            .expect("sound board is on the worker")
+    }
+
+    fn sound_worker(&self) -> &SoundWorker {
+        self.sound_worker.as_ref().expect("no sound worker")
+    }
+
+    /// Run the sound board on a worker thread during frames bracketed by
+    /// [`begin_frame`](Self::begin_frame) / [`end_frame`](Self::end_frame).
+    ///
+    /// The M6800 only hears from the main board through the command latch,
+    /// so it can run alongside the main CPU. Commands are timestamped and
+    /// applied at the same sound-board cycle as in lockstep, so emulation
+    /// and audio are identical either way; single-stepped `tick` calls
+    /// outside a frame (the debugger) always run the sound CPU inline.
+    pub fn set_sound_thread(&mut self, enabled: bool) {
+        self.end_frame();
+        if enabled != self.sound_worker.is_some() {
+            self.sound_worker = enabled.then(SoundWorker::spawn);
+        }
+    }
+
+    /// Start a frame. With a sound worker, moves the sound board to it
+    /// until [`end_frame`](Self::end_frame); otherwise does nothing. In
+    /// between, `tick` forwards sound commands to the worker instead of
+    /// latching them, and anything else that needs the sound board panics.
+    pub fn begin_frame(&mut self) {
+        let Some(worker) = &self.sound_worker else {
+            return;
+        };
+        if let Some(sound) = self.sound.take() {
+            worker.send(SoundMsg::Begin(sound));
+        }
+    }
+
+    /// Finish a frame: wait for the sound worker to catch up to the main
+    /// board and take the sound board back.
+    pub fn end_frame(&mut self) {
+        if self.sound.is_some() {
+            return;
+        }
+        let worker = self.sound_worker();
+        worker.send(SoundMsg::End(self.clock));
+        self.sound = Some(worker.done.recv().expect("Williams sound thread exited"));
     }
 }
 
 impl Saveable for WilliamsBoard {
     fn save_state(&self, w: &mut StateWriter) {
         // CPUs
+        let sound = self.sound();
         self.cpu.save_state(w);
-        self.sound_cpu.save_state(w);
+        sound.cpu.save_state(w);
         // RAM
         w.write_bytes(self.main_map.region_data(MainRegion::VideoRam));
         w.write_bytes(&self.main_map.region_data(MainRegion::Palette)[..16]);
         w.write_bytes(self.main_map.region_data(MainRegion::Cmos));
-        w.write_bytes(self.sound_map.region_data(SoundRegion::Ram));
+        w.write_bytes(sound.bus.map.region_data(SoundRegion::Ram));
         // Peripherals
         self.widget_pia.save_state(w);
         self.rom_pia.save_state(w);
-        self.sound_pia.save_state(w);
+        sound.bus.pia.save_state(w);
         self.blitter.save_state(w);
-        self.dac.save_state(w);
+        sound.bus.dac.save_state(w);
         // I/O & timing
         w.write_u8(self.rom_bank);
-        self.resampler.save_state(w);
+        sound
+            .bus
+            .resampler
+            .advanced(
+                sound.bus.dac.sample_i16(),
+                sound.bus.clock - sound.bus.audio_clock,
+            )
+            .save_state(w);
         w.write_u32_le(self.watchdog_counter);
         w.write_u64_le(self.clock);
         w.write_u8(self.rom_pia_input);
@@ -482,27 +570,58 @@ impl Saveable for WilliamsBoard {
 
     fn load_state(&mut self, r: &mut StateReader) -> Result<(), SaveError> {
         // CPUs
+        let sound = self
+            .sound
+            .as_deref_mut()
+            .expect("sound board is on the worker");
         self.cpu.load_state(r)?;
-        self.sound_cpu.load_state(r)?;
+        sound.cpu.load_state(r)?;
         // RAM
         r.read_bytes_into(self.main_map.region_data_mut(MainRegion::VideoRam))?;
         r.read_bytes_into(&mut self.main_map.region_data_mut(MainRegion::Palette)[..16])?;
         r.read_bytes_into(self.main_map.region_data_mut(MainRegion::Cmos))?;
-        r.read_bytes_into(self.sound_map.region_data_mut(SoundRegion::Ram))?;
+        r.read_bytes_into(sound.bus.map.region_data_mut(SoundRegion::Ram))?;
         // Peripherals
         self.widget_pia.load_state(r)?;
         self.rom_pia.load_state(r)?;
-        self.sound_pia.load_state(r)?;
+        sound.bus.pia.load_state(r)?;
         self.blitter.load_state(r)?;
-        self.dac.load_state(r)?;
+        sound.bus.dac.load_state(r)?;
         // I/O & timing
         self.rom_bank = r.read_u8()?;
-        self.resampler.load_state(r)?;
+        sound.bus.resampler.load_state(r)?;
         self.watchdog_counter = r.read_u32_le()?;
         self.clock = r.read_u64_le()?;
+        self.beam = BeamPosition::at_clock(&TIMING, self.clock);
+        sound.bus.audio_clock = self.clock;
+        sound.bus.clock = self.clock;
         self.rom_pia_input = r.read_u8()?;
+        sound.bus.sync_irq();
+        self.sync_irq_lines();
         Ok(())
     }
+
+    fn state_size(&self) -> usize {
+        let sound = self.sound();
+        let ram = self.main_map.region_data(MainRegion::VideoRam).len()
+            + 16
+            + self.main_map.region_data(MainRegion::Cmos).len()
+            + sound.bus.map.region_data(SoundRegion::Ram).len();
+        self.cpu.state_size()
+            + sound.cpu.state_size()
+            + ram
+            + 4 * 4
+            + self.widget_pia.state_size()
+            + self.rom_pia.state_size()
+            + sound.bus.pia.state_size()
+            + self.blitter.state_size()
+            + sound.bus.dac.state_size()
+            + 1
+            + sound.bus.resampler.state_size()
+            + 4
+            + 8
+            + 1
+    }
 }
 
 impl Default for WilliamsBoard {
@@ -519,20 +638,7 @@ impl Default for WilliamsBoard {
 impl WilliamsBoard {
     pub(crate) fn bus_read(&mut self, master: BusMaster, addr: u16) -> u8 {
         if master == BusMaster::Cpu(1) {
-            // Sound board
-            let data = match self.sound_map.page(addr).region_id {
-                SoundRegion::IO_PIA => {
-                    if (0x0400..=0x0403).contains(&addr) {
-                        self.sound_pia.read(addr - 0x0400)
-                    } else {
-                        0xFF
-                    }
-                }
-                SoundRegion::RAM | SoundRegion::ROM => self.sound_map.read_backing(addr),
-                _ => 0xFF,
-            };
-            self.sound_map.check_read_watch(addr, data);
-            return data;
+            return self.sound_mut().bus.read(master, addr);
         }
 
         // DmaVram reads bypass ROM banking — the blitter reads dest
@@ -553,7 +659,11 @@ impl WilliamsBoard {
             }
             MainRegion::IO_PIA => match addr {
                 0xC804..=0xC807 => self.widget_pia.read(addr - 0xC804),
-                0xC80C..=0xC80F => self.rom_pia.read(addr - 0xC80C),
+                0xC80C..=0xC80F => {
+                    let data = self.rom_pia.read(addr - 0xC80C);
+                    self.sync_irq_lines();
+                    data
+                }
                 _ => 0xFF,
             },
             MainRegion::IO_BANK => self.rom_bank,
@@ -571,17 +681,7 @@ impl WilliamsBoard {
 
     pub(crate) fn bus_write(&mut self, master: BusMaster, addr: u16, data: u8) {
         if master == BusMaster::Cpu(1) {
-            // Sound board
-            match self.sound_map.page(addr).region_id {
-                SoundRegion::RAM => self.sound_map.write_backing(addr, data),
-                SoundRegion::IO_PIA => {
-                    if (0x0400..=0x0403).contains(&addr) {
-                        self.sound_pia.write(addr - 0x0400, data);
-                    }
-                }
-                _ => {} // ROM or unmapped: ignored
-            }
-            self.sound_map.check_write_watch(addr, data);
+            self.sound_mut().bus.write(master, addr, data);
             return;
         }
 
@@ -599,7 +699,10 @@ impl WilliamsBoard {
             }
             MainRegion::IO_PIA => match addr {
                 0xC804..=0xC807 => self.widget_pia.write(addr - 0xC804, data),
-                0xC80C..=0xC80F => self.rom_pia.write(addr - 0xC80C, data),
+                0xC80C..=0xC80F => {
+                    self.rom_pia.write(addr - 0xC80C, data);
+                    self.sync_irq_lines();
+                }
                 _ => {}
             },
             MainRegion::IO_BANK => {
@@ -630,6 +733,23 @@ impl WilliamsBoard {
         self.main_map.check_write_watch(addr, data);
     }
 
+    /// Main CPU reads that only its own writes (or a blit it waits for) can
+    /// change. PIAs and the video counter are not; the sound CPU is never
+    /// skipped.
+    pub(crate) fn bus_is_pure_read(&self, master: BusMaster, addr: u16) -> bool {
+        master == BusMaster::Cpu(0)
+            && !self.main_map.has_any_watchpoints()
+            && matches!(
+                self.main_map.page(addr).region_id,
+                MainRegion::VIDEO_RAM
+                    | MainRegion::BANKED_ROM
+                    | MainRegion::CMOS
+                    | MainRegion::PROGRAM_ROM
+                    | MainRegion::PALETTE
+                    | MainRegion::IO_BANK
+            )
+    }
+
     pub(crate) fn bus_is_halted_for(&self, master: BusMaster) -> bool {
         match master {
             BusMaster::Cpu(0) => self.blitter.is_active(),
@@ -637,28 +757,383 @@ impl WilliamsBoard {
         }
     }
 
+    /// Refresh the main CPU's cached interrupt line if the ROM PIA
+    /// reports a change (the sound CPU's line is kept by
+    /// `SoundBus::sync_irq`). Called after every ROM PIA access and
+    /// control line update.
+    ///
+    /// Only ROM PIA interrupts are wired to the main CPU IRQ line via
+    /// INPUT_MERGER_ANY_HIGH. Widget PIA IRQs are not connected. FIRQ is
+    /// not used on Williams gen-1 hardware.
+    fn sync_irq_lines(&mut self) {
+        if self.rom_pia.take_irq_changed() {
+            self.irq_line.irq = self.rom_pia.irq_a() || self.rom_pia.irq_b();
+        }
+    }
+
     pub(crate) fn bus_check_interrupts(&mut self, target: BusMaster) -> InterruptState {
         match target {
-            // Only ROM PIA interrupts are wired to the main CPU IRQ line
-            // via INPUT_MERGER_ANY_HIGH. Widget PIA IRQs are not connected.
-            // FIRQ is not used on Williams gen-1 hardware.
-            BusMaster::Cpu(0) => InterruptState {
-                nmi: false,
-                irq: self.rom_pia.irq_a() || self.rom_pia.irq_b(),
-                firq: false,
-                ..Default::default()
-            },
-            BusMaster::Cpu(1) => InterruptState {
-                nmi: false,
-                irq: self.sound_pia.irq_a() || self.sound_pia.irq_b(),
-                firq: false,
-                ..Default::default()
-            },
+            BusMaster::Cpu(0) => self.irq_line,
+            BusMaster::Cpu(1) => self.sound().bus.irq,
             _ => InterruptState::default(),
         }
     }
 }
 
+// Devices are listed main board first, then sound board; CPU indices match
+// `BusMaster::Cpu`.
+impl BusDebug for WilliamsBoard {
+    fn devices(&self) -> Vec<(&str, &dyn Debuggable)> {
+        let sound = self.sound();
+        vec![
+            ("M6809 Main", &self.cpu as &dyn Debuggable),
+            ("M6800 Sound", &sound.cpu as &dyn Debuggable),
+            ("Widget PIA", &self.widget_pia as &dyn Debuggable),
+            ("ROM PIA", &self.rom_pia as &dyn Debuggable),
+            ("Blitter", &self.blitter as &dyn Debuggable),
+            ("Sound PIA", &sound.bus.pia as &dyn Debuggable),
+            ("DAC", &sound.bus.dac as &dyn Debuggable),
+        ]
+    }
+
+    fn cpus(&self) -> Vec<(&str, &dyn DebugCpu)> {
+        vec![
+            ("M6809 Main", &self.cpu as &dyn DebugCpu),
+            ("M6800 Sound", &self.sound().cpu as &dyn DebugCpu),
+        ]
+    }
+
+    fn read(&self, cpu_index: usize, addr: u16) -> Option<u8> {
+        self.memory_map(cpu_index)?.debug_read(addr)
+    }
+
+    fn write(&mut self, cpu_index: usize, addr: u16, data: u8) {
+        match cpu_index {
+            0 => self.main_map.debug_write(addr, data),
+            1 => self.sound_mut().bus.map.debug_write(addr, data),
+            _ => {}
+        }
+    }
+
+    fn write_device_register(&mut self, device_index: usize, offset: u16, data: u8) {
+        match device_index {
+            2 => Device::write(&mut self.widget_pia, offset, data),
+            3 => {
+                Device::write(&mut self.rom_pia, offset, data);
+                self.sync_irq_lines();
+            }
+            4 => Device::write(&mut self.blitter, offset, data),
+            5 => {
+                let bus = &mut self.sound_mut().bus;
+                Device::write(&mut bus.pia, offset, data);
+                bus.sync_irq();
+            }
+            6 => Device::write(&mut self.sound_mut().bus.dac, offset, data),
+            _ => {}
+        }
+    }
+
+    fn reset_device(&mut self, device_index: usize) {
+        match device_index {
+            2 => Device::reset(&mut self.widget_pia),
+            3 => {
+                Device::reset(&mut self.rom_pia);
+                self.sync_irq_lines();
+            }
+            4 => Device::reset(&mut self.blitter),
+            5 => {
+                let bus = &mut self.sound_mut().bus;
+                Device::reset(&mut bus.pia);
+                bus.sync_irq();
+            }
+            6 => Device::reset(&mut self.sound_mut().bus.dac),
+            _ => {}
+        }
+    }
+
+    fn set_idle_skip(&mut self, enabled: bool) {
+        DebugCpu::set_idle_skip(&mut self.cpu, enabled);
+        DebugCpu::set_idle_skip(&mut self.sound_mut().cpu, enabled);
+    }
+
+    fn take_watchpoint_hit(&mut self) -> Option<WatchpointHit> {
+        self.main_map
+            .take_hit()
+            .or_else(|| self.sound_mut().bus.map.take_hit())
+    }
+
+    fn set_watchpoint(&mut self, cpu_index: usize, addr: u16, kind: WatchpointKind) {
+        match cpu_index {
+            0 => self.main_map.set_watchpoint(addr, kind),
+            1 => self.sound_mut().bus.map.set_watchpoint(addr, kind),
+            _ => {}
+        }
+    }
+
+    fn clear_watchpoint(&mut self, cpu_index: usize, addr: u16, kind: WatchpointKind) {
+        match cpu_index {
+            0 => self.main_map.clear_watchpoint(addr, kind),
+            1 => self.sound_mut().bus.map.clear_watchpoint(addr, kind),
+            _ => {}
+        }
+    }
+
+    fn clear_all_watchpoints(&mut self) {
+        self.main_map.clear_all_watchpoints();
+        self.sound_mut().bus.map.clear_all_watchpoints();
+    }
+
+    fn memory_map(&self, cpu_index: usize) -> Option<&MemoryMap> {
+        match cpu_index {
+            0 => Some(&self.main_map),
+            1 => Some(&self.sound().bus.map),
+            _ => None,
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sound board
+// ---------------------------------------------------------------------------
+
+/// The sound board: the M6800 and everything it can reach. The main board
+/// only talks to it through the command latch (ROM PIA port B → sound PIA
+/// port B/CB1) and nothing flows back, so it can run on its own — stepped
+/// from `tick`, or moved to the sound worker thread while the main CPU runs
+/// the rest of the frame.
+pub(crate) struct SoundBoard {
+    pub(crate) cpu: M6800,
+    pub(crate) bus: SoundBus,
+}
+
+/// The sound CPU's bus.
+pub(crate) struct SoundBus {
+    pub(crate) pia: Pia6820, // 0x0400-0x0403: Sound PIA
+    pub(crate) dac: Mc1408Dac,
+    pub(crate) resampler: AudioResampler<i16>,
+    pub(crate) map: MemoryMap,
+    // Clock up to which the DAC output has been fed to the resampler. The
+    // DAC only changes on sound PIA writes, so the interval since the last
+    // change is rendered in one `tick_n` (see `sync_audio`).
+    audio_clock: u64,
+    // Cycles the sound board has run. Equal to the main board's clock
+    // except inside a frame run on the sound worker, where it trails it.
+    clock: u64,
+    // Sound CPU interrupt line, refreshed by `sync_irq` when the sound
+    // PIA reports a change. Not saved.
+    irq: InterruptState,
+}
+
+impl SoundBoard {
+    fn new() -> Self {
+        Self {
+            cpu: M6800::new(),
+            bus: SoundBus {
+                pia: Pia6820::new(),
+                dac: Mc1408Dac::new(),
+                resampler: AudioResampler::new(1_000_000, 44_100),
+                map: Self::build_map(),
+                audio_clock: 0,
+                clock: 0,
+                irq: InterruptState::default(),
+            },
+        }
+    }
+
+    fn build_map() -> MemoryMap {
+        use SoundRegion::*;
+        let mut map = MemoryMap::new();
+        map.region(Ram, "Sound RAM", 0x0000, 0x100, AccessKind::ReadWrite)
+            .region(IoPia, "Sound PIA", 0x0400, 0x100, AccessKind::Io)
+            .region(Rom, "Sound ROM", 0xF000, 0x1000, AccessKind::ReadOnly)
+            .mirror(0xB000, 0xF000, 0x1000)
+            .mirror(0xC000, 0xF000, 0x1000)
+            .mirror(0xD000, 0xF000, 0x1000)
+            .mirror(0xE000, 0xF000, 0x1000);
+        map
+    }
+
+    fn reset(&mut self) {
+        let bus = &mut self.bus;
+        bus.pia.reset();
+        bus.dac.reset();
+        bus.dac.write(bus.pia.read_output_a());
+        bus.resampler.reset();
+        bus.audio_clock = 0;
+        bus.clock = 0;
+        bus.sync_irq();
+        self.cpu.reset(bus, BusMaster::Cpu(1));
+    }
+
+    /// Run the sound CPU for one cycle.
+    fn step(&mut self) {
+        self.cpu.execute_cycle(&mut self.bus, BusMaster::Cpu(1));
+        self.bus.clock += 1;
+    }
+}
+
+impl SoundBus {
+    /// Latch a sound command from the main board.
+    ///
+    /// High two bits are externally pulled high on real hardware.
+    /// CB1 is held low for 0xFF (silence sentinel), asserted high otherwise
+    /// to generate an IRQ on the sound CPU.
+    fn command(&mut self, data: u8) {
+        let command = data | 0xC0;
+        self.pia.set_port_b_input(command);
+        self.pia.set_cb1(command != 0xFF);
+        self.sync_irq();
+    }
+
+    /// Feed the DAC output held since the last sync to the resampler.
+    ///
+    /// The DAC is continuously connected to the sound PIA Port A output
+    /// pins and the resampler downsamples the 1 MHz CPU clock to 44.1 kHz.
+    /// Called before anything that can change Port A and before audio is
+    /// drained, so the output matches ticking the resampler every cycle.
+    fn sync_audio(&mut self) {
+        let pending = self.clock - self.audio_clock;
+        if pending > 0 {
+            self.resampler.tick_n(self.dac.sample_i16(), pending);
+            self.audio_clock = self.clock;
+        }
+    }
+
+    /// Refresh the sound CPU's cached IRQ line if the sound PIA reports
+    /// a change.
+    fn sync_irq(&mut self) {
+        if self.pia.take_irq_changed() {
+            self.irq.irq = self.pia.irq_a() || self.pia.irq_b();
+        }
+    }
+}
+
+impl Bus for SoundBus {
+    type Address = u16;
+    type Data = u8;
+
+    fn read(&mut self, _master: BusMaster, addr: u16) -> u8 {
+        let data = match self.map.page(addr).region_id {
+            SoundRegion::IO_PIA => {
+                if (0x0400..=0x0403).contains(&addr) {
+                    let data = self.pia.read(addr - 0x0400);
+                    self.sync_irq();
+                    data
+                } else {
+                    0xFF
+                }
+            }
+            SoundRegion::RAM | SoundRegion::ROM => self.map.read_backing(addr),
+            _ => 0xFF,
+        };
+        self.map.check_read_watch(addr, data);
+        data
+    }
+
+    fn write(&mut self, _master: BusMaster, addr: u16, data: u8) {
+        match self.map.page(addr).region_id {
+            SoundRegion::RAM => self.map.write_backing(addr, data),
+            SoundRegion::IO_PIA => {
+                if (0x0400..=0x0403).contains(&addr) {
+                    self.sync_audio();
+                    self.pia.write(addr - 0x0400, data);
+                    self.dac.write(self.pia.read_output_a());
+                    self.sync_irq();
+                }
+            }
+            _ => {} // ROM or unmapped: ignored
+        }
+        self.map.check_write_watch(addr, data);
+    }
+
+    fn is_halted_for(&self, _master: BusMaster) -> bool {
+        false
+    }
+
+    fn check_interrupts(&mut self, _target: BusMaster) -> InterruptState {
+        self.irq
+    }
+}
+
+enum SoundMsg {
+    /// Start of a frame: the worker runs this sound board until `End`.
+    Begin(Box<SoundBoard>),
+    /// Apply a command before the sound CPU executes cycle `clock`.
+    Command { clock: u64, data: u8 },
+    /// The main board has reached `clock`; run the sound board up to it.
+    RunTo(u64),
+    /// End of frame: run to `clock` and hand the sound board back.
+    End(u64),
+}
+
+/// Worker thread that runs the sound board during `run_frame`.
+///
+/// Commands carry the main-board clock at which `tick` latched them and are
+/// applied at exactly that sound-board cycle, so the result is identical
+/// to lockstep stepping; the worker just never runs past the last clock
+/// the main board has announced.
+struct SoundWorker {
+    tx: mpsc::Sender<SoundMsg>,
+    done: mpsc::Receiver<Box<SoundBoard>>,
+    thread: Option<thread::JoinHandle<()>>,
+}
+
+impl SoundWorker {
+    fn spawn() -> Self {
+        let (tx, rx) = mpsc::channel();
+        let (done_tx, done) = mpsc::channel();
+        let thread = thread::Builder::new()
+            .name("williams-sound".into())
+            .spawn(move || Self::run(rx, done_tx))
+            .expect("failed to spawn Williams sound thread");
+        Self {
+            tx,
+            done,
+            thread: Some(thread),
+        }
+    }
+
+    fn run(rx: mpsc::Receiver<SoundMsg>, done: mpsc::Sender<Box<SoundBoard>>) {
+        let mut sound: Option<Box<SoundBoard>> = None;
+        for msg in rx {
+            let is_end = matches!(msg, SoundMsg::End(_));
+            let (until, command) = match msg {
+                SoundMsg::Begin(board) => {
+                    sound = Some(board);
+                    continue;
+                }
+                SoundMsg::Command { clock, data } => (clock, Some(data)),
+                SoundMsg::RunTo(clock) | SoundMsg::End(clock) => (clock, None),
+            };
+            let board = sound.as_mut().expect("sound message outside a frame");
+            while board.bus.clock < until {
+                board.step();
+            }
+            if let Some(data) = command {
+                board.bus.command(data);
+            }
+            if is_end && done.send(sound.take().unwrap()).is_err() {
+                return;
+            }
+        }
+    }
+
+    fn send(&self, msg: SoundMsg) {
+        self.tx.send(msg).expect("Williams sound thread exited");
+    }
+}
+
+impl Drop for SoundWorker {
+    fn drop(&mut self) {
+        // Closing the channel ends the worker loop.
+        let (tx, _) = mpsc::channel();
+        drop(std::mem::replace(&mut self.tx, tx));
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Tests
 // ---------------------------------------------------------------------------
@@ -676,15 +1151,16 @@ mod tests {
         board.write_video_ram(0, 0xAA);
         board.write_video_ram(0x5FFF, 0xBB);
         board.main_map.region_data_mut(MainRegion::Palette)[3] = 0x42;
-        board.sound_map.region_data_mut(SoundRegion::Ram)[0x10] = 0xCD;
+        board.sound_mut().bus.map.region_data_mut(SoundRegion::Ram)[0x10] = 0xCD;
         board.rom_bank = 5;
         board.clock = 123_456;
         board.watchdog_counter = 789;
         board.rom_pia_input = 0x10;
         // Run a few ticks to accumulate some resampler state
         for _ in 0..100 {
-            board.dac.write(0xA0);
-            board.resampler.tick(board.dac.sample_i16());
+            let bus = &mut board.sound_mut().bus;
+            bus.dac.write(0xA0);
+            bus.resampler.tick(bus.dac.sample_i16());
         }
 
         // Write CMOS data
@@ -695,6 +1171,7 @@ mod tests {
         let mut w = StateWriter::new();
         board.save_state(&mut w);
         let data = w.into_vec();
+        assert_eq!(data.len(), board.state_size());
 
         // Mutate everything
         let mut board2 = WilliamsBoard::new();
@@ -716,8 +1193,8 @@ mod tests {
             "main CPU state mismatch"
         );
         assert_eq!(
-            board.sound_cpu.snapshot(),
-            board2.sound_cpu.snapshot(),
+            board.get_sound_cpu_state(),
+            board2.get_sound_cpu_state(),
             "sound CPU state mismatch"
         );
 
@@ -725,7 +1202,10 @@ mod tests {
         assert_eq!(board2.read_video_ram(0), 0xAA);
         assert_eq!(board2.read_video_ram(0x5FFF), 0xBB);
         assert_eq!(board2.main_map.region_data(MainRegion::Palette)[3], 0x42);
-        assert_eq!(board2.sound_map.region_data(SoundRegion::Ram)[0x10], 0xCD);
+        assert_eq!(
+            board2.sound().bus.map.region_data(SoundRegion::Ram)[0x10],
+            0xCD
+        );
 
         // Verify CMOS
         assert_eq!(board2.main_map.region_data(MainRegion::Cmos)[0], 0xF1);
@@ -743,7 +1223,7 @@ mod tests {
         let mut board = WilliamsBoard::new();
         board.main_map.region_data_mut(MainRegion::ProgramRom)[0] = 0xDE;
         board.main_map.region_data_mut(MainRegion::BankedRom)[0] = 0xAD;
-        board.sound_map.region_data_mut(SoundRegion::Rom)[0] = 0xBE;
+        board.sound_mut().bus.map.region_data_mut(SoundRegion::Rom)[0] = 0xBE;
 
         let mut w = StateWriter::new();
         board.save_state(&mut w);
@@ -753,7 +1233,7 @@ mod tests {
         let mut board2 = WilliamsBoard::new();
         board2.main_map.region_data_mut(MainRegion::ProgramRom)[0] = 0x11;
         board2.main_map.region_data_mut(MainRegion::BankedRom)[0] = 0x22;
-        board2.sound_map.region_data_mut(SoundRegion::Rom)[0] = 0x33;
+        board2.sound_mut().bus.map.region_data_mut(SoundRegion::Rom)[0] = 0x33;
 
         let mut r = StateReader::new(&data);
         board2.load_state(&mut r).unwrap();
@@ -769,9 +1249,281 @@ mod tests {
             "banked ROM should be untouched"
         );
         assert_eq!(
-            board2.sound_map.region_data(SoundRegion::Rom)[0],
+            board2.sound().bus.map.region_data(SoundRegion::Rom)[0],
             0x33,
             "sound ROM should be untouched"
         );
     }
+
+    #[test]
+    fn irq_lines_follow_pia_changes() {
+        let mut board = WilliamsBoard::new();
+        let main_irq = |b: &mut WilliamsBoard| b.bus_check_interrupts(BusMaster::Cpu(0)).irq;
+
+        // CA1 rising edge with the interrupt still disabled: flag only
+        board.bus_write(BusMaster::Cpu(0), 0xC80D, 0x02);
+        board.rom_pia.set_ca1(true);
+        assert!(!main_irq(&mut board));
+
+        // Enabling CA1 through the bus asserts IRQ
+        board.bus_write(BusMaster::Cpu(0), 0xC80D, 0x07);
+        assert!(main_irq(&mut board));
+        assert!(!board.bus_check_interrupts(BusMaster::Cpu(1)).irq);
+
+        // The cached line is rebuilt after a state load
+        let mut w = StateWriter::new();
+        board.save_state(&mut w);
+        let data = w.into_vec();
+        let mut board2 = WilliamsBoard::new();
+        board2.load_state(&mut StateReader::new(&data)).unwrap();
+        assert!(main_irq(&mut board2));
+
+        // Reading port A clears the flag and drops the line
+        board.bus_read(BusMaster::Cpu(0), 0xC80C);
+        assert!(!main_irq(&mut board));
+    }
+
+    #[test]
+    fn lazy_dac_audio_matches_per_cycle_render() {
+        let mut board = WilliamsBoard::new();
+        let mut reference = AudioResampler::<i16>::new(1_000_000, 44_100);
+        // (clock, PIA offset, data): DDRA all-output, CRA selects the data
+        // register, then a few DAC values
+        let writes = [
+            (0u64, 0, 0xFF),
+            (0, 1, 0x04),
+            (37, 0, 0x20),
+            (38, 0, 0xE0),
+            (5000, 0, 0x90),
+        ];
+
+        for clock in 0..20_000u64 {
+            board.sound_mut().bus.clock = clock;
+            for &(_, offset, data) in writes.iter().filter(|(at, ..)| *at == clock) {
+                board.bus_write(BusMaster::Cpu(1), 0x0400 + offset, data);
+            }
+            let dac = board.sound().bus.pia.read_output_a();
+            reference.tick(((dac as i16) - 128) * 256);
+        }
+        board.sound_mut().bus.clock = 20_000;
+
+        let mut out = vec![0i16; 1024];
+        let n = board.fill_audio(&mut out);
+        assert_eq!(&out[..n], reference.drain_audio().as_slice());
+        assert!(n > 800);
+    }
+
+    /// Minimal game wrapper: routes the Bus straight to the board.
+    struct TestSystem {
+        board: WilliamsBoard,
+    }
+
+    impl Bus for TestSystem {
+        type Address = u16;
+        type Data = u8;
+
+        fn read(&mut self, master: BusMaster, addr: u16) -> u8 {
+            self.board.bus_read(master, addr)
+        }
+
+        fn write(&mut self, master: BusMaster, addr: u16, data: u8) {
+            self.board.bus_write(master, addr, data)
+        }
+
+        fn is_halted_for(&self, master: BusMaster) -> bool {
+            self.board.bus_is_halted_for(master)
+        }
+
+        fn check_interrupts(&mut self, target: BusMaster) -> InterruptState {
+            self.board.bus_check_interrupts(target)
+        }
+
+        fn is_pure_read(&self, master: BusMaster, addr: u16) -> bool {
+            self.board.bus_is_pure_read(master, addr)
+        }
+    }
+
+    /// Main CPU sends a stream of sound commands; the sound CPU plays a
+    /// sawtooth on the DAC and writes each command it receives to the DAC
+    /// from its CB1 IRQ handler.
+    fn make_sound_system(threaded: bool) -> TestSystem {
+        use phosphor_core::bus_split;
+        use phosphor_core::cpu::Cpu;
+
+        let mut board = WilliamsBoard::new();
+        #[rustfmt::skip]
+        let main = [
+            0x86, 0xFF,             // D000: LDA #$FF
+            0xB7, 0xC8, 0x0E,       //       STA $C80E   ; DDRB all out
+            0x86, 0x04,             //       LDA #$04
+            0xB7, 0xC8, 0x0F,       //       STA $C80F   ; CRB: data
+            0x5C,                   // D00A: INCB
+            0xF7, 0xC8, 0x0E,       //       STB $C80E   ; command
+            0x8E, 0x00, 0x80,       //       LDX #$0080
+            0x30, 0x1F,             // D011: LEAX -1,X
+            0x26, 0xFC,             //       BNE D011
+            0x86, 0xFF,             //       LDA #$FF
+            0xB7, 0xC8, 0x0E,       //       STA $C80E   ; release CB1
+            0x8E, 0x00, 0x40,       //       LDX #$0040
+            0x30, 0x1F,             // D01D: LEAX -1,X
+            0x26, 0xFC,             //       BNE D01D
+            0x20, 0xE7,             //       BRA D00A
+        ];
+        board.load_program_rom(0, &main);
+        board.load_program_rom(0x2FFE, &[0xD0, 0x00]);
+        #[rustfmt::skip]
+        let sound = [
+            0x8E, 0x00, 0x7F,       // F000: LDS #$007F
+            0x86, 0xFF,             //       LDAA #$FF
+            0xB7, 0x04, 0x00,       //       STAA $0400  ; DDRA all out
+            0x86, 0x04,             //       LDAA #$04
+            0xB7, 0x04, 0x01,       //       STAA $0401  ; CRA: data
+            0x86, 0x07,             //       LDAA #$07
+            0xB7, 0x04, 0x03,       //       STAA $0403  ; CRB: CB1 rising IRQ
+            0x0E,                   //       CLI
+            0x4C,                   // F013: INCA
+            0xB7, 0x04, 0x00,       //       STAA $0400  ; DAC
+            0x20, 0xFA,             //       BRA F013
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xB6, 0x04, 0x02,       // F020: LDAA $0402  ; command
+            0xB7, 0x00, 0x10,       //       STAA $0010
+            0xB7, 0x04, 0x00,       //       STAA $0400  ; DAC
+            0x3B,                   //       RTI
+        ];
+        board.load_sound_rom(0, &sound);
+        board.load_sound_rom(0xFF8, &[0xF0, 0x20, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x00]);
+        board.set_sound_thread(threaded);
+
+        let mut sys = TestSystem { board };
+        sys.board.reset();
+        bus_split!(&mut sys, bus => {
+            sys.board.cpu.reset(bus, BusMaster::Cpu(0));
+        });
+        sys
+    }
+
+    /// Main CPU polls a RAM flag set by ROM PIA IRQs (count240 and VA11),
+    /// and between polls bumps a counter and writes video RAM.
+    fn make_idle_system() -> TestSystem {
+        use phosphor_core::bus_split;
+        use phosphor_core::cpu::Cpu;
+
+        let mut board = WilliamsBoard::new();
+        #[rustfmt::skip]
+        let main = [
+            0x10, 0xCE, 0xBF, 0x00, // D000: LDS #$BF00
+            0x86, 0x07,             //       LDA #$07
+            0xB7, 0xC8, 0x0D,       //       STA $C80D   ; CA1 rising IRQ
+            0xB7, 0xC8, 0x0F,       //       STA $C80F   ; CB1 rising IRQ
+            0x1C, 0xEF,             //       ANDCC #$EF
+            0xB6, 0xA0, 0x00,       // D00E: LDA $A000
+            0x27, 0xFB,             //       BEQ D00E
+            0x7F, 0xA0, 0x00,       //       CLR $A000
+            0x5C,                   //       INCB
+            0xE7, 0x80,             //       STB ,X+
+            0x20, 0xF3,             //       BRA D00E
+            0x00, 0x00, 0x00, 0x00, 0x00,
+            0xB6, 0xC8, 0x0C,       // D020: LDA $C80C   ; clear CA1 flag
+            0xB6, 0xC8, 0x0E,       //       LDA $C80E   ; clear CB1 flag
+            0x86, 0x01,             //       LDA #$01
+            0xB7, 0xA0, 0x00,       //       STA $A000
+            0x3B,                   //       RTI
+        ];
+        board.load_program_rom(0, &main);
+        board.load_program_rom(0x2FF8, &[0xD0, 0x20, 0, 0, 0, 0, 0xD0, 0x00]);
+        board.set_sound_thread(false);
+
+        let mut sys = TestSystem { board };
+        sys.board.reset();
+        bus_split!(&mut sys, bus => {
+            sys.board.cpu.reset(bus, BusMaster::Cpu(0));
+        });
+        sys
+    }
+
+    #[test]
+    fn idle_skip_matches_stepping() {
+        use phosphor_core::bus_split;
+
+        let mut stepped = make_idle_system();
+        let mut skipping = make_idle_system();
+        let mut skips = 0;
+        for frame in 0..120 {
+            bus_split!(&mut stepped, bus => {
+                for _ in 0..TIMING.cycles_per_frame() {
+                    stepped.board.tick(bus);
+                }
+            });
+            bus_split!(&mut skipping, bus => {
+                let mut remaining = TIMING.cycles_per_frame();
+                while remaining > 0 {
+                    let n = skipping.board.step(bus, remaining);
+                    skips += (n > 1) as u32;
+                    remaining -= n;
+                }
+            });
+            let mut a = StateWriter::new();
+            stepped.board.save_state(&mut a);
+            let mut b = StateWriter::new();
+            skipping.board.save_state(&mut b);
+            assert!(a.into_vec() == b.into_vec(), "frame {frame} differs");
+            assert_eq!(stepped.board.cpu.snapshot(), skipping.board.cpu.snapshot());
+        }
+        // The loop ran and was skipped, and the handler kept leaving it
+        assert!(skips > 1000, "{skips}");
+        assert!(stepped.board.main_map.region_data(MainRegion::VideoRam)[0x10] != 0);
+
+        // Turning detection off steps every cycle
+        let mut off = make_idle_system();
+        DebugCpu::set_idle_skip(&mut off.board.cpu, false);
+        bus_split!(&mut off, bus => {
+            for _ in 0..TIMING.cycles_per_frame() * 4 {
+                assert_eq!(off.board.step(bus, 1000), 1);
+            }
+        });
+    }
+
+    fn run_sound_frame(sys: &mut TestSystem) -> (Vec<u8>, Vec<i16>) {
+        use phosphor_core::bus_split;
+
+        sys.board.begin_frame();
+        bus_split!(sys, bus => {
+            for _ in 0..TIMING.cycles_per_frame() {
+                sys.board.tick(bus);
+            }
+        });
+        sys.board.end_frame();
+
+        let mut w = StateWriter::new();
+        sys.board.save_state(&mut w);
+        let mut audio = vec![0i16; 2048];
+        let n = sys.board.fill_audio(&mut audio);
+        audio.truncate(n);
+        (w.into_vec(), audio)
+    }
+
+    #[test]
+    fn threaded_sound_matches_lockstep() {
+        let mut lockstep = make_sound_system(false);
+        let mut threaded = make_sound_system(true);
+        for frame in 0..8 {
+            let expected = run_sound_frame(&mut lockstep);
+            assert_eq!(run_sound_frame(&mut threaded), expected, "frame {frame}");
+        }
+        // The sound CPU saw commands from the main CPU
+        assert_ne!(
+            lockstep.board.sound().bus.map.region_data(SoundRegion::Ram)[0x10],
+            0
+        );
+
+        // Single-stepped ticks outside a frame run the sound CPU inline
+        for _ in 0..1000 {
+            phosphor_core::bus_split!(&mut lockstep, bus => { lockstep.board.tick(bus); });
+            phosphor_core::bus_split!(&mut threaded, bus => { threaded.board.tick(bus); });
+        }
+        assert_eq!(
+            run_sound_frame(&mut threaded),
+            run_sound_frame(&mut lockstep)
+        );
+    }
 }
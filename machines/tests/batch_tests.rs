@@ -0,0 +1,157 @@
+//! Lockstep batches: observations must match instances run one at a time.
+
+use phosphor_core::core::batch::{MachineBatch, RamView};
+use phosphor_core::core::machine::Machine;
+use phosphor_machines::{JoustSystem, PacmanSystem};
+
+const INSTANCES: usize = 5;
+const STEPS: usize = 40;
+
+/// Different scripted buttons for each instance and step.
+fn buttons(instance: usize, step: usize) -> u64 {
+    let x = (instance as u64 + 1).wrapping_mul(0x9E37_79B9) ^ (step as u64 / 4);
+    x & 0x3F
+}
+
+/// A fresh instance with its index written at `tag` and `instance` frames
+/// run, so every instance starts out different.
+fn warmed(create: fn() -> Box<dyn Machine>, instance: usize, tag: u16) -> Box<dyn Machine> {
+    let mut machine = create();
+    let bus = machine.debug_bus_mut().unwrap();
+    bus.write(0, tag, instance as u8);
+    for _ in 0..instance {
+        machine.run_frame();
+    }
+    machine
+}
+
+/// Run one instance the way the batch does and return its observation.
+fn reference(
+    machine: &mut dyn Machine,
+    instance: usize,
+    frames_per_step: u32,
+    views: &[RamView],
+    render: bool,
+) -> Vec<u8> {
+    let mut held = 0u64;
+    let mut audio = vec![0i16; 4096];
+    for step in 0..STEPS {
+        let b = buttons(instance, step);
+        for id in 0..64 {
+            if (b ^ held) & (1 << id) != 0 {
+                machine.set_input(id, b & (1 << id) != 0);
+            }
+        }
+        held = b;
+        for _ in 0..frames_per_step {
+            machine.run_frame();
+            machine.fill_audio(&mut audio);
+        }
+    }
+    let mut obs = Vec::new();
+    if render {
+        let (w, h) = machine.display_size();
+        let mut frame = vec![0u8; (w * h * 3) as usize];
+        machine.render_frame(&mut frame);
+        obs.extend_from_slice(&frame);
+    }
+    let map = machine.memory_map(0).unwrap();
+    for v in views {
+        obs.extend((0..v.len).map(|i| map.debug_read(v.start + i).unwrap_or(0)));
+    }
+    obs
+}
+
+fn check_batch(create: fn() -> Box<dyn Machine>, views: &[RamView], render: bool) {
+    let mut batch = MachineBatch::new(
+        (0..INSTANCES)
+            .map(|i| warmed(create, i, views[0].start))
+            .collect(),
+    );
+    batch.set_threads(2);
+    batch.set_frames_per_step(2);
+    batch.set_render(render);
+    for &v in views {
+        batch.add_ram_view(v);
+    }
+    let size = batch.observation_size();
+    let mut obs = vec![0u8; INSTANCES * size];
+    for step in 0..STEPS {
+        if step == STEPS / 2 {
+            // Re-splitting the instances must keep their order
+            batch.set_threads(3);
+        }
+        let masks: Vec<u64> = (0..INSTANCES).map(|i| buttons(i, step)).collect();
+        batch.step(&masks, &mut obs);
+    }
+
+    for (i, chunk) in obs.chunks(size).enumerate() {
+        let expected = reference(
+            warmed(create, i, views[0].start).as_mut(),
+            i,
+            2,
+            views,
+            render,
+        );
+        assert!(chunk == expected, "instance {i} observation differs");
+    }
+    // Instances started from different states
+    assert!(obs.chunks(size).any(|c| c != &obs[..size]));
+}
+
+#[test]
+fn joust_batch_matches_sequential_runs() {
+    let views = [
+        RamView {
+            cpu_index: 0,
+            start: 0xA000,
+            len: 0x200,
+        },
+        RamView {
+            cpu_index: 0,
+            start: 0xC800,
+            len: 0x10,
+        },
+    ];
+    check_batch(|| Box::new(JoustSystem::new()), &views, true);
+}
+
+#[test]
+fn pacman_ram_only_batch_matches_sequential_runs() {
+    let views = [RamView {
+        cpu_index: 0,
+        start: 0x4C00,
+        len: 0x400,
+    }];
+    check_batch(|| Box::new(PacmanSystem::new()), &views, false);
+}
+
+#[test]
+fn observe_writes_without_running() {
+    let mut batch = MachineBatch::new(
+        (0..3)
+            .map(|_| -> Box<dyn Machine> { Box::new(JoustSystem::new()) })
+            .collect(),
+    );
+    let mut before = vec![0u8; 3 * batch.observation_size()];
+    let mut after = before.clone();
+    batch.observe(&mut before);
+    batch.observe(&mut after);
+    assert_eq!(before, after);
+    assert_eq!(batch.instance(0).machine_id(), "joust");
+}
+
+#[test]
+fn empty_observations_still_step() {
+    let mut batch = MachineBatch::new(
+        (0..3)
+            .map(|_| -> Box<dyn Machine> { Box::new(PacmanSystem::new()) })
+            .collect(),
+    );
+    batch.set_threads(3);
+    batch.set_render(false);
+    assert_eq!(batch.observation_size(), 0);
+    let before = batch.instance(2).save_state();
+    batch.step(&[0; 3], &mut []);
+    assert_ne!(batch.instance(2).save_state(), before);
+}
@@ -0,0 +1,81 @@
+//! Input movie recording, playback and seeking.
+
+use phosphor_core::core::machine::{AudioSource, Machine};
+use phosphor_core::core::movie::{Movie, MoviePlayer, MovieRecorder};
+
+const FRAMES: u64 = 300;
+
+/// Record `FRAMES` frames of scripted input, returning the movie and the
+/// machine state at the start of every frame (plus the final state).
+fn record(machine: &mut dyn Machine) -> (Movie, Vec<Vec<u8>>) {
+    let ids: Vec<u8> = machine.input_map().iter().map(|b| b.id).collect();
+    let mut audio = vec![0i16; 4096];
+    let mut rec = MovieRecorder::new(machine, 60).unwrap();
+    let mut states = Vec::new();
+    for f in 0..FRAMES {
+        states.push(machine.save_state().unwrap());
+        if f % 7 == 3 {
+            let id = ids[(f as usize / 7) % ids.len()];
+            rec.button(machine, id, f % 14 == 3);
+        }
+        machine.run_frame();
+        machine.fill_audio(&mut audio);
+        rec.end_frame(machine);
+    }
+    states.push(machine.save_state().unwrap());
+    (rec.finish(), states)
+}
+
+#[test]
+fn playback_reproduces_recording() {
+    let mut sys = phosphor_machines::JoustSystem::new();
+    for _ in 0..5 {
+        sys.run_frame();
+    }
+    let (movie, states) = record(&mut sys);
+    assert_eq!(movie.frames(), FRAMES);
+    assert!(!movie.events().is_empty());
+
+    let movie = Movie::from_bytes(&movie.to_bytes()).unwrap();
+    let mut replay = phosphor_machines::JoustSystem::new();
+    let mut player = MoviePlayer::new(movie, &mut replay).unwrap();
+    let mut audio = vec![0i16; 4096];
+    for (f, state) in states[..FRAMES as usize].iter().enumerate() {
+        assert_eq!(&replay.save_state().unwrap(), state, "frame {f}");
+        assert!(player.step(&mut replay));
+        replay.fill_audio(&mut audio);
+    }
+    assert_eq!(replay.save_state().unwrap(), states[FRAMES as usize]);
+    assert!(!player.step(&mut replay));
+}
+
+#[test]
+fn seek_matches_linear_playback() {
+    let mut sys = phosphor_machines::JoustSystem::new();
+    let (movie, states) = record(&mut sys);
+
+    let mut replay = phosphor_machines::JoustSystem::new();
+    let mut player = MoviePlayer::new(movie, &mut replay).unwrap();
+    for target in [137, 20, 250, 251, 60, FRAMES] {
+        player.seek(&mut replay, target).unwrap();
+        assert_eq!(player.frame(), target);
+        assert_eq!(
+            replay.save_state().unwrap(),
+            states[target as usize],
+            "seek to {target}"
+        );
+    }
+}
+
+#[test]
+fn rejects_other_machines_and_bad_files() {
+    let mut sys = phosphor_machines::JoustSystem::new();
+    let movie = MovieRecorder::new(&sys, 60).unwrap().finish();
+    let bytes = movie.to_bytes();
+
+    let mut other = phosphor_machines::RobotronSystem::new();
+    assert!(MoviePlayer::new(Movie::from_bytes(&bytes).unwrap(), &mut other).is_err());
+    assert!(MoviePlayer::new(movie, &mut sys).is_ok());
+    assert!(Movie::from_bytes(&bytes[..bytes.len() - 1]).is_err());
+    assert!(Movie::from_bytes(b"PHOS\x01\x00\x00\x00").is_err());
+}
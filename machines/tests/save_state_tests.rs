@@ -2,9 +2,33 @@
 //!
 //! Verifies that every machine can save and load state consistently:
 //! - save → load → save produces identical bytes (round-trip)
+//! - `state_hash()` agrees for restored state
 //! - corrupted machine IDs are rejected
-
-use phosphor_core::core::machine::Machine;
+//! - run-ahead (save, run hidden frames, load) leaves the real timeline
+//!   bit-identical
+
+use phosphor_core::core::machine::{AudioSource, Machine};
+use phosphor_machines::rom_loader::{RomLoadError, RomSet};
+
+/// Load a machine with zero-filled ROMs. Machines that decode graphics
+/// while running need a ROM set to run at all; the file names and sizes
+/// come from the loader's own errors.
+fn zero_roms<M>(mut machine: M, load: fn(&mut M, &RomSet) -> Result<(), RomLoadError>) -> M {
+    let mut files: Vec<(String, Vec<u8>)> = Vec::new();
+    loop {
+        let rom_set = RomSet::from_entries(files.clone()).skip_checksums();
+        match load(&mut machine, &rom_set) {
+            Ok(()) => return machine,
+            Err(RomLoadError::MissingFile(name)) => files.push((name, Vec::new())),
+            Err(RomLoadError::SizeMismatch { file, expected, .. }) => {
+                let (_, data) = files.iter_mut().find(|(name, _)| *name == file).unwrap();
+                assert!(data.is_empty(), "{file} is loaded at two sizes");
+                *data = vec![0; expected];
+            }
+            Err(e) => panic!("zero-filled ROM set: {e}"),
+        }
+    }
+}
 
 /// Generate standard save-state round-trip tests for a machine.
 ///
@@ -28,6 +52,16 @@ macro_rules! save_state_tests {
                 assert_eq!(saved, saved2, "round-trip should produce identical bytes");
             }
 
+            #[test]
+            fn state_hash_matches_restored_state() {
+                let sys = $create;
+                let hash = sys.state_hash().expect("state_hash returned None");
+
+                let mut sys2 = $create;
+                sys2.load_state(&sys.save_state().unwrap()).unwrap();
+                assert_eq!(sys2.state_hash(), Some(hash));
+            }
+
             #[test]
             fn rejects_corrupted_machine_id() {
                 let mut sys = $create;
@@ -44,6 +78,34 @@ macro_rules! save_state_tests {
                 );
             }
 
+            #[test]
+            fn run_ahead_leaves_timeline_unchanged() {
+                let mut plain = $create;
+                let mut ahead = $create;
+                let mut audio = vec![0i16; 8192];
+                let mut snapshot = Vec::new();
+                for f in 0..40 {
+                    plain.run_frame();
+                    let n = plain.fill_audio(&mut audio);
+                    let plain_audio = audio[..n].to_vec();
+
+                    ahead.run_frame();
+                    let n = ahead.fill_audio(&mut audio);
+                    assert!(audio[..n] == plain_audio[..], "audio, frame {f}");
+                    assert!(ahead.save_state_into(&mut snapshot));
+                    for _ in 0..2 {
+                        ahead.run_frame();
+                        ahead.fill_audio(&mut audio);
+                    }
+                    ahead.load_state(&snapshot).unwrap();
+                    assert_eq!(
+                        ahead.save_state().unwrap(),
+                        plain.save_state().unwrap(),
+                        "state, frame {f}"
+                    );
+                }
+            }
+
             #[test]
             fn rejects_truncated_data() {
                 let mut sys = $create;
@@ -69,22 +131,62 @@ save_state_tests!(pacman, phosphor_machines::PacmanSystem::new());
 save_state_tests!(mspacman, phosphor_machines::MsPacmanSystem::new());
 
 // Nintendo TKG-04 board machines
-save_state_tests!(donkey_kong, phosphor_machines::DkongSystem::new());
-save_state_tests!(donkey_kong_jr, phosphor_machines::DkongJrSystem::new());
+save_state_tests!(
+    donkey_kong,
+    zero_roms(
+        phosphor_machines::DkongSystem::new(),
+        phosphor_machines::DkongSystem::load_rom_set
+    )
+);
+save_state_tests!(
+    donkey_kong_jr,
+    zero_roms(
+        phosphor_machines::DkongJrSystem::new(),
+        phosphor_machines::DkongJrSystem::load_rom_set
+    )
+);
 
 // MCR-II board machines
-save_state_tests!(satans_hollow, phosphor_machines::SatansHollowSystem::new());
+save_state_tests!(
+    satans_hollow,
+    zero_roms(
+        phosphor_machines::SatansHollowSystem::new(),
+        phosphor_machines::SatansHollowSystem::load_rom_set
+    )
+);
 
 // Gottlieb System 80 machines
-save_state_tests!(qbert, phosphor_machines::QbertSystem::new());
+save_state_tests!(
+    qbert,
+    zero_roms(
+        phosphor_machines::QbertSystem::new(),
+        phosphor_machines::QbertSystem::load_rom_set
+    )
+);
 
 // Atari DVG vector machines
 save_state_tests!(asteroids, phosphor_machines::AsteroidsSystem::new());
 save_state_tests!(astdelux, phosphor_machines::AsteroidsDeluxeSystem::new());
 save_state_tests!(llander, phosphor_machines::LunarLanderSystem::new());
 
+// Atari AVG vector machines
+save_state_tests!(tempest, phosphor_machines::TempestSystem::new());
+
 // Namco Galaga board machines
-save_state_tests!(digdug, phosphor_machines::DigDugSystem::new());
+save_state_tests!(
+    galaga,
+    zero_roms(
+        phosphor_machines::galaga::GalagaSystem::new(),
+        phosphor_machines::galaga::GalagaSystem::load_rom_set
+    )
+);
+save_state_tests!(
+    digdug,
+    zero_roms(
+        phosphor_machines::DigDugSystem::new(),
+        phosphor_machines::DigDugSystem::load_rom_set
+    )
+);
 
 // Standalone machines
 save_state_tests!(
@@ -92,4 +194,25 @@ save_state_tests!(
     phosphor_machines::MissileCommandSystem::new()
 );
 save_state_tests!(gridlee, phosphor_machines::GridleeSystem::new());
-save_state_tests!(ccastles, phosphor_machines::CrystalCastlesSystem::new());
+save_state_tests!(
+    ccastles,
+    zero_roms(
+        phosphor_machines::CrystalCastlesSystem::new(),
+        phosphor_machines::CrystalCastlesSystem::load_rom_set
+    )
+);
+
+#[test]
+fn state_hash_follows_execution() {
+    let mut a = phosphor_machines::JoustSystem::new();
+    let mut b = phosphor_machines::JoustSystem::new();
+    let mut seen = Vec::new();
+    for _ in 0..10 {
+        a.run_frame();
+        b.run_frame();
+        let hash = a.state_hash().unwrap();
+        assert_eq!(b.state_hash(), Some(hash), "identical runs should agree");
+        assert!(!seen.contains(&hash), "each frame should hash differently");
+        seen.push(hash);
+    }
+}
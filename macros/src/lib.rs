@@ -165,6 +165,11 @@ pub fn derive_bus_debug(input: TokenStream) -> TokenStream {
                 }
             });
 
+    // Generate set_idle_skip() calls (every #[debug_cpu] field)
+    let idle_skip_calls = cpu_entries.iter().map(|(_, ident, _, _)| {
+        quote! { phosphor_core::core::debug::DebugCpu::set_idle_skip(&mut self.#ident, enabled); }
+    });
+
     // Generate watchpoint methods (only when #[debug_map] fields exist)
     let watchpoint_methods = if !map_entries.is_empty() {
         // take_watchpoint_hit: chain .or_else() across all maps (declaration order)
@@ -270,6 +275,10 @@ pub fn derive_bus_debug(input: TokenStream) -> TokenStream {
                 }
             }
 
+            fn set_idle_skip(&mut self, enabled: bool) {
+                #(#idle_skip_calls)*
+            }
+
             #watchpoint_methods
         }
     };
@@ -435,7 +444,7 @@ fn pascal_to_screaming_snake(s: &str) -> String {
 /// - `#[save_skip]` — field is not saved or loaded; keeps its current value.
 /// - `#[save_skip(default)]` — not saved; set to `Default::default()` on load.
 /// - `#[save_skip(default = <expr>)]` — not saved; set to `<expr>` on load.
-/// - `#[save_elements]` — serialize `[u8; N]` per-element instead of bulk
+/// - `#[save_elements]` — serialize `[u8; N]` without the length prefix of
 ///   `write_bytes`/`read_bytes_into`. Use when compatibility with existing
 ///   save formats that use individual `write_u8` calls is required.
 ///
@@ -445,6 +454,10 @@ fn pascal_to_screaming_snake(s: &str) -> String {
 /// `bool`), byte arrays (`[u8; N]`), byte vectors (`Vec<u8>`), fixed-size
 /// arrays of primitives or `Saveable` types (`[T; N]`), and any other type
 /// that implements `Saveable` (delegated via `save_state`/`load_state`).
+///
+/// Arrays of primitives are written in one `write_slice_le` call rather
+/// than per element, and the generated `state_size()` sums each field's
+/// encoded size so savers can allocate the whole buffer up front.
 #[proc_macro_derive(Saveable, attributes(save_version, save_skip, save_elements))]
 pub fn derive_saveable(input: TokenStream) -> TokenStream {
     let input = parse_macro_input!(input as DeriveInput);
@@ -463,9 +476,11 @@ pub fn derive_saveable(input: TokenStream) -> TokenStream {
 
     let version_write = version.map(|v| quote! { w.write_version(#v); });
     let version_read = version.map(|v| quote! { r.read_version(#v)?; });
+    let version_size = if version.is_some() { 1usize } else { 0 };
 
     let mut save_stmts = Vec::new();
     let mut load_stmts = Vec::new();
+    let mut size_terms = Vec::new();
     let mut load_skip_stmts = Vec::new();
 
     for field in fields {
@@ -479,6 +494,7 @@ pub fn derive_saveable(input: TokenStream) -> TokenStream {
                 let (save, load) = gen_field_io(ident, &field.ty, force_elements);
                 save_stmts.push(save);
                 load_stmts.push(load);
+                size_terms.push(gen_field_size(ident, &field.ty, force_elements));
             }
             SaveSkip::Keep => {
                 // #[save_skip] — excluded, no code generated
@@ -510,6 +526,10 @@ pub fn derive_saveable(input: TokenStream) -> TokenStream {
                 #(#load_skip_stmts)*
                 Ok(())
             }
+
+            fn state_size(&self) -> usize {
+                #version_size #(+ #size_terms)*
+            }
         }
     };
 
@@ -658,7 +678,11 @@ fn gen_field_io(
                     if is_vec_u8(seg) {
                         (
                             quote! { w.write_bytes(&self.#ident); },
-                            quote! { self.#ident = r.read_bytes()?.to_vec(); },
+                            quote! {
+                                let __bytes = r.read_bytes()?;
+                                self.#ident.clear();
+                                self.#ident.extend_from_slice(__bytes);
+                            },
                         )
                     } else {
                         panic!(
@@ -686,9 +710,10 @@ fn gen_field_io(
 
 /// Generate save/load for `[T; N]` arrays.
 ///
-/// When `force_elements` is true, `[u8; N]` is serialized per-element instead
-/// of using the bulk `write_bytes`/`read_bytes_into` path. This preserves
-/// compatibility with hand-written impls that used individual `write_u8` calls.
+/// `[u8; N]` uses the length-prefixed `write_bytes`/`read_bytes_into` path.
+/// Arrays of other primitives (and `[u8; N]` under `force_elements`) use
+/// `write_slice_le`, which matches the encoding of per-element `write_*`
+/// calls so hand-written formats are preserved.
 fn gen_array_io(
     ident: &syn::Ident,
     elem_ty: &Type,
@@ -701,6 +726,12 @@ fn gen_array_io(
             quote! { r.read_bytes_into(&mut self.#ident)?; },
         );
     }
+    if is_primitive(elem_ty) {
+        return (
+            quote! { w.write_slice_le(&self.#ident); },
+            quote! { r.read_slice_le_into(&mut self.#ident)?; },
+        );
+    }
 
     // For other element types, generate a loop
     let (elem_save, elem_load) = gen_array_element_io(ident, elem_ty);
@@ -774,6 +805,50 @@ fn gen_array_element_io(ident: &syn::Ident, elem_ty: &Type) -> (TokenStream2, To
     }
 }
 
+/// Generate the `state_size()` term for a single field, mirroring the
+/// encoding chosen by `gen_field_io`.
+fn gen_field_size(ident: &syn::Ident, ty: &Type, force_elements: bool) -> TokenStream2 {
+    match ty {
+        Type::Array(arr) if is_type_u8(&arr.elem) && !force_elements => {
+            quote! { (4 + self.#ident.len()) }
+        }
+        Type::Array(arr) if is_primitive(&arr.elem) => {
+            // Every primitive encodes at its in-memory size (bool as one byte)
+            quote! { ::core::mem::size_of_val(&self.#ident) }
+        }
+        Type::Array(_) => quote! {
+            self.#ident
+                .iter()
+                .map(phosphor_core::prelude::Saveable::state_size)
+                .sum::<usize>()
+        },
+        Type::Path(path) => {
+            let seg = path.path.segments.last().expect("non-empty path");
+            if is_primitive(ty) {
+                quote! { ::core::mem::size_of_val(&self.#ident) }
+            } else if seg.ident == "Vec" {
+                quote! { (4 + self.#ident.len()) }
+            } else {
+                quote! { phosphor_core::prelude::Saveable::state_size(&self.#ident) }
+            }
+        }
+        _ => quote! { phosphor_core::prelude::Saveable::state_size(&self.#ident) },
+    }
+}
+
+/// Check if a type is a primitive with a fixed little-endian encoding.
+fn is_primitive(ty: &Type) -> bool {
+    if let Type::Path(path) = ty
+        && let Some(seg) = path.path.segments.last()
+    {
+        return matches!(
+            seg.ident.to_string().as_str(),
+            "u8" | "u16" | "u32" | "u64" | "i16" | "i32" | "i64" | "f32" | "f64" | "bool"
+        );
+    }
+    false
+}
+
 /// Check if a type is `u8`.
 fn is_type_u8(ty: &Type) -> bool {
     if let Type::Path(path) = ty